@@ -0,0 +1,99 @@
+#include "AllocStats.h"
+#include <stdlib.h>
+#include <new>
+
+#if BENCH_ALLOC_STATS
+#include <malloc.h>
+
+static uint32_t allocCount = 0;
+static size_t liveBytes = 0;
+static size_t markBytes = 0;
+static size_t peakBytes = 0;
+
+static void* counted(void* p) {
+    if (p == NULL) return NULL;
+    allocCount++;
+    liveBytes += malloc_usable_size(p);
+    if (liveBytes > peakBytes) peakBytes = liveBytes;
+    return p;
+}
+
+static void uncounted(void* p) {
+    if (p != NULL) liveBytes -= malloc_usable_size(p);
+}
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* p, size_t size);
+void __real_free(void* p);
+
+void* __wrap_malloc(size_t size) {
+    return counted(__real_malloc(size));
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    return counted(__real_calloc(count, size));
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+    size_t was = p != NULL ? malloc_usable_size(p) : 0;
+    void* q = __real_realloc(p, size);
+    if (q == NULL) {
+        if (size == 0) liveBytes -= was;  // glibc freed it; otherwise p is untouched
+        return NULL;
+    }
+    liveBytes -= was;
+    return counted(q);
+}
+
+void __wrap_free(void* p) {
+    uncounted(p);
+    __real_free(p);
+}
+}
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+bool AllocStats::enabled() { return true; }
+
+void AllocStats::mark() {
+    allocCount = 0;
+    markBytes = liveBytes;
+    peakBytes = liveBytes;
+}
+
+uint32_t AllocStats::allocs() { return allocCount; }
+size_t AllocStats::peak() { return peakBytes - markBytes; }
+size_t AllocStats::live() { return liveBytes; }
+
+#else
+
+bool AllocStats::enabled() { return false; }
+void AllocStats::mark() {}
+uint32_t AllocStats::allocs() { return 0; }
+size_t AllocStats::peak() { return 0; }
+size_t AllocStats::live() { return 0; }
+
+#endif
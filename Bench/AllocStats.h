@@ -0,0 +1,32 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Counts the bench's heap use: allocations, bytes live, and the peak since
+// the last mark(). malloc, calloc, realloc and free are wrapped at link time
+// (-Wl,--wrap, GNU ld) and operator new/delete go through them, so the
+// sketch's sources are measured unchanged. Sizes are what glibc actually
+// handed out (malloc_usable_size), a little over what was asked for.
+//
+// Without BENCH_ALLOC_STATS nothing is wrapped and enabled() is false.
+class AllocStats {
+  public:
+    static bool enabled();
+
+    /**
+    * Starts a measurement: zeroes the count and sets the peak to what's live.
+    */
+    static void mark();
+
+    // Allocations since mark()
+    static uint32_t allocs();
+
+    // Most bytes live at once since mark(), less what was live at mark()
+    static size_t peak();
+
+    static size_t live();
+};
+
+#endif
@@ -0,0 +1,217 @@
+// Replays recorded 511 responses through the sketch's code paths on the
+// host, stage by stage:
+//   frame      finding the gzip member and walking its header
+//   inflate    tinfl, into one buffer sized from ISIZE (GzipInflater)
+//   parse      ArduinoJson into the arrival model (StopMonitorParser)
+//   aggregate  the board's rows (ArrivalBoard)
+//   render     renderFrame() into MT_EPD's planes, every row tile redrawn
+//   cached     the same frame again, rows pasted from the tile cache
+//   upload     displayAsync()'s SPI byte stream, to a counting SPI
+// Each stage is run once to count its allocations and peak heap, then
+// timed over N runs. The summary gives per-stage throughput over the whole
+// corpus; --each adds a line per payload.
+//
+//   nextbus_bench [--iterations=N] [--each] payload|directory...
+//
+// A payload is a response body as the API sends it (gzip), or the JSON
+// itself, which skips the first two stages. Scripts/benchcorpus.py builds a
+// corpus from stopmonitor.py's archive. The render stages need
+// Adafruit_GFX, and allocation counts need GNU ld (see CMakeLists.txt).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "GzipInflater.h"
+#include "StopMonitorParser.h"
+#include "ArrivalBoard.h"
+#include "AllocStats.h"
+#if BENCH_PANEL
+#include "panel.h"
+#endif
+
+enum Stage { FRAME, INFLATE, PARSE, AGGREGATE, RENDER, CACHED, UPLOAD, STAGES };
+static const char* const stageNames[STAGES] = {
+    "frame", "inflate", "parse", "aggregate", "render", "cached", "upload"};
+
+struct StageTotals {
+    uint32_t calls = 0;
+    double us = 0;        // sum of the per-payload means
+    double maxUs = 0;
+    double bytes = 0;     // what the stage got through, per call
+    uint64_t allocs = 0;  // per call, summed
+    size_t peak = 0;
+};
+
+static StageTotals totals[STAGES];
+
+static bool readFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return false;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) out.insert(out.end(), chunk, chunk + n);
+    fclose(f);
+    return true;
+}
+
+// Runs stage once for its heap use, then iterations times for its time.
+// Returns microseconds per call.
+template <typename Run>
+static double measure(Stage stage, int iterations, double bytes, Run run) {
+    AllocStats::mark();
+    run();
+    uint32_t allocs = AllocStats::allocs();
+    size_t peak = AllocStats::peak();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) run();
+    std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+    double us = took.count() / iterations;
+
+    StageTotals& t = totals[stage];
+    t.calls++;
+    t.us += us;
+    t.maxUs = std::max(t.maxUs, us);
+    t.bytes += bytes;
+    t.allocs += allocs;
+    t.peak = std::max(t.peak, peak);
+    return us;
+}
+
+static bool benchPayload(const char* path, int iterations, bool each) {
+    std::vector<uint8_t> body;
+    if (!readFile(path, body)) {
+        fprintf(stderr, "%s: can't read\n", path);
+        return false;
+    }
+    double us[STAGES] = {};
+
+    GzipInflater inflater;
+    GzipInflater::Member member;
+    std::string json;
+    if (GzipInflater::frame(body.data(), body.size(), member)) {
+        us[FRAME] = measure(FRAME, iterations, body.size(),
+                            [&] { GzipInflater::frame(body.data(), body.size(), member); });
+        if (inflater.unpack(body.data(), body.size()) != GzipInflater::INFLATED) {
+            fprintf(stderr, "%s: doesn't inflate\n", path);
+            return false;
+        }
+        json.assign(inflater.text(), inflater.length());
+        inflater.release();
+        us[INFLATE] = measure(INFLATE, iterations, json.size(),
+                              [&] { inflater.unpack(body.data(), body.size()); });
+        inflater.release();
+    } else {
+        json.assign((const char*)body.data(), body.size());  // already JSON
+    }
+
+    StopMonitorParser parser;
+    static StopCodeData stop;
+    copyText(stop.stopCode, sizeof(stop.stopCode), "bench");
+    StopMonitorParser::Result parsed = StopMonitorParser::PARSED;
+    us[PARSE] = measure(PARSE, iterations, json.size(),
+                        [&] { parsed = parser.parse(json.data(), json.size(), stop); });
+    if (parsed != StopMonitorParser::PARSED) {
+        fprintf(stderr, "%s: doesn't parse (%s), %zu bytes of JSON\n", path,
+                parsed == StopMonitorParser::NO_MEMORY ? "no memory" : parser.error(), json.size());
+        return false;
+    }
+
+    // As the panel would have it a moment after the response
+    uint32_t now = parser.serverTime();
+    ArrivalBoard board;
+    uint8_t rows = 0;
+    us[AGGREGATE] = measure(AGGREGATE, iterations, 0,
+                            [&] { rows = board.layout(&stop, 1, now, BOARD_MAX_ROWS); });
+
+#if BENCH_PANEL
+    BoardRow frame[BOARD_MAX_ROWS];
+    for (uint8_t i = 0; i < rows; i++) frame[i] = board.row(i);
+    us[RENDER] = measure(RENDER, iterations, 0, [&] { panelRender(frame, rows, false); });
+    us[CACHED] = measure(CACHED, iterations, 0, [&] { panelRender(frame, rows, true); });
+    uint64_t sent = 0;
+    us[UPLOAD] = measure(UPLOAD, iterations, 0, [&] { sent = panelUpload(); });
+    totals[UPLOAD].bytes += sent;
+#endif
+
+    if (each) {
+        printf("%-32s %8zu %8zu %4d %4u", path, body.size(), json.size(), stop.arrivalCount, rows);
+        for (int s = 0; s < STAGES; s++) printf(" %9.1f", us[s]);
+        printf("\n");
+    }
+    return true;
+}
+
+// Payload files: the paths given, and the files in each directory given
+static void collect(const char* arg, std::vector<std::string>& paths) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(arg, error)) {
+        paths.push_back(arg);
+        return;
+    }
+    std::vector<std::string> found;
+    for (const auto& entry : std::filesystem::directory_iterator(arg, error)) {
+        if (entry.is_regular_file()) found.push_back(entry.path().string());
+    }
+    std::sort(found.begin(), found.end());
+    paths.insert(paths.end(), found.begin(), found.end());
+}
+
+static void printTotals() {
+    printf("\n%-10s %6s %10s %10s %9s %10s %8s %9s\n", "stage", "calls", "mean us", "max us",
+           "MB/s", "calls/s", "allocs", "peak B");
+    for (int s = 0; s < STAGES; s++) {
+        const StageTotals& t = totals[s];
+        if (t.calls == 0) continue;
+        double mean = t.us / t.calls;
+        printf("%-10s %6u %10.1f %10.1f", stageNames[s], t.calls, mean, t.maxUs);
+        if (t.bytes > 0) printf(" %9.1f", t.bytes / t.us);  // bytes per us is MB/s
+        else printf(" %9s", "-");
+        printf(" %10.0f", mean > 0 ? 1e6 / mean : 0.0);
+        if (AllocStats::enabled()) printf(" %8.1f %9zu\n", (double)t.allocs / t.calls, t.peak);
+        else printf(" %8s %9s\n", "-", "-");
+    }
+#if !BENCH_PANEL
+    printf("(render, cached and upload need Adafruit_GFX; see CMakeLists.txt)\n");
+#endif
+}
+
+int main(int argc, char** argv) {
+    int iterations = 50;
+    bool each = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--iterations=", 13) == 0) iterations = atoi(argv[i] + 13);
+        else if (strcmp(argv[i], "--each") == 0) each = true;
+        else collect(argv[i], paths);
+    }
+    if (paths.empty() || iterations <= 0) {
+        printf("Usage: nextbus_bench [--iterations=N] [--each] payload|directory...\n");
+        printf("  a payload is a StopMonitoring response body, gzip or plain JSON\n");
+        return 1;
+    }
+
+#if BENCH_PANEL
+    panelBegin();
+#endif
+    if (each) {
+        printf("%-32s %8s %8s %4s %4s", "payload", "bytes", "json", "arr", "rows");
+        for (int s = 0; s < STAGES; s++) printf(" %9s", stageNames[s]);
+        printf("   (us)\n");
+    }
+    int failed = 0;
+    for (const std::string& path : paths) {
+        if (!benchPayload(path.c_str(), iterations, each)) failed++;
+    }
+    printTotals();
+#if BENCH_PANEL
+    printf("upload checksum %08x\n", panelSum());
+#endif
+    if (failed) printf("%d of %zu payloads stopped short; see above\n", failed, paths.size());
+    return failed == (int)paths.size() ? 1 : 0;
+}
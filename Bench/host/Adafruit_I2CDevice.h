@@ -0,0 +1,6 @@
+#ifndef ADAFRUIT_I2C_DEVICE_H
+#define ADAFRUIT_I2C_DEVICE_H
+
+// Adafruit_GFX includes it; the bench draws into memory only
+
+#endif
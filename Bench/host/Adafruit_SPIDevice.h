@@ -0,0 +1,6 @@
+#ifndef ADAFRUIT_SPI_DEVICE_H
+#define ADAFRUIT_SPI_DEVICE_H
+
+// Adafruit_GFX includes it; the bench draws into memory only
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Just enough of the Arduino core for the bench to build the sketch's
+// drawing code on the host (MT_EPD, RowTileCache, Log, Adafruit_GFX), and
+// for the tests to build MetricsServer: the pins do nothing, the panel's
+// busy line always reads idle and delay() returns at once, so what's timed
+// is the CPU's share of a frame.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include "Print.h"
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define F(text) (text)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(void* const*)(addr))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline unsigned long micros() {
+    static const auto start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+inline void yield() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline unsigned get_core_num() { return 0; }
+
+// Log.h takes a String argument; nothing else here needs one
+class String {
+  public:
+    String(const char* text = "") : _text(text) {}
+    const char* c_str() const { return _text; }
+
+  private:
+    const char* _text;
+};
+
+#endif
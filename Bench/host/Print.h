@@ -0,0 +1,45 @@
+#ifndef PRINT_H
+#define PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// The Arduino core's Print, for the text the sketch prints through
+// Adafruit_GFX: everything ends up in write(uint8_t).
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* text) { return text ? write((const uint8_t*)text, strlen(text)) : 0; }
+    virtual int availableForWrite() { return 0; }
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long v) { return printFormat("%ld", v); }
+    size_t print(unsigned long v) { return printFormat("%lu", v); }
+    size_t print(int v) { return print((long)v); }
+    size_t print(unsigned v) { return print((unsigned long)v); }
+    size_t print(double v, int digits = 2) { return printFormat("%.*f", digits, v); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T v) { return print(v) + println(); }
+
+  private:
+    template <typename... Args>
+    size_t printFormat(const char* format, Args... args) {
+        char text[32];
+        snprintf(text, sizeof(text), format, args...);
+        return write(text);
+    }
+};
+
+#endif
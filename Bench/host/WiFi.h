@@ -0,0 +1,79 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+#include <string>
+#include "Arduino.h"
+
+// A scripted network for the host tests, one connection at a time. The test
+// queues a request with hostNet.connect(); the next WiFiServer::accept()
+// after begin() hands it out. The server under test reads the request, may
+// write at most hostNet.writeRoom bytes per call, and what it writes
+// collects in hostNet.response until it stops the client.
+struct HostNet {
+    std::string request;
+    size_t readAt = 0;
+    std::string response;
+    bool listening = false;
+    bool pending = false;      // connected, not yet accepted
+    bool open = false;         // accepted, not yet stopped
+    int writeRoom = 300;       // what availableForWrite() says
+    size_t writes = 0;
+    size_t largestWrite = 0;
+
+    void connect(const std::string& text) {
+        request = text;
+        readAt = 0;
+        response.clear();
+        pending = true;
+        writes = 0;
+        largestWrite = 0;
+    }
+};
+
+inline HostNet hostNet;
+
+class WiFiClient {
+  public:
+    explicit operator bool() const { return _accepted && hostNet.open; }
+    uint8_t connected() { return bool(*this); }
+    int available() { return connected() ? (int)(hostNet.request.size() - hostNet.readAt) : 0; }
+    int read() { return available() > 0 ? (uint8_t)hostNet.request[hostNet.readAt++] : -1; }
+    int availableForWrite() { return connected() ? hostNet.writeRoom : 0; }
+
+    size_t write(const uint8_t* buffer, size_t size) {
+        if (!connected()) return 0;
+        hostNet.writes++;
+        hostNet.largestWrite = max(hostNet.largestWrite, size);
+        hostNet.response.append((const char*)buffer, size);
+        return size;
+    }
+
+    void flush() {}
+
+    void stop() {
+        if (_accepted) hostNet.open = false;
+        _accepted = false;
+    }
+
+  private:
+    friend class WiFiServer;
+    bool _accepted = false;
+};
+
+class WiFiServer {
+  public:
+    explicit WiFiServer(uint16_t) {}
+    void begin() { hostNet.listening = true; }
+
+    WiFiClient accept() {
+        WiFiClient client;
+        if (hostNet.listening && hostNet.pending) {
+            hostNet.pending = false;
+            hostNet.open = true;
+            client._accepted = true;
+        }
+        return client;
+    }
+};
+
+#endif
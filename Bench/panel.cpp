@@ -0,0 +1,104 @@
+#include "panel.h"
+#include <Arduino.h>
+#include <SPI.h>
+#include "MT_EPD.h"
+#include "FrameQueue.h"
+#include "RowTileCache.h"
+#include "assets.h"
+#include "Fonts/FreeSansBold24pt7bDigits.h"
+#include "Fonts/FreeSans12pt7bSpans.h"
+#include "digit_atlas.h"
+
+static const int ROW_HEIGHT = 135;
+
+static MT_EPD display(17, 20, 21, 22);
+
+static void paintRowLogo(const FrameRow& row, int16_t y) {
+    display.drawNativeBitmap(0, y, *row.logo, MT_EPD::EPD_BLACK);
+}
+
+static void paintRowLabels(const FrameRow& row, int16_t y) {
+    display.setSpanFont(&FreeSans12pt7bSpans);
+    display.setCursor(135, y + 25);
+    display.setTextColor(MT_EPD::EPD_BLACK);
+    display.print("To ");
+    display.println(row.destination);
+
+    display.setCursor(135, y + 60);
+    display.print("From ");
+    display.println(row.stopPoint);
+}
+
+static RowTileCache rowTiles(display, paintRowLogo, paintRowLabels);
+
+// Every logo is the same size and drawn the same way, so which one a line
+// gets doesn't change the cost; the sketch's lineRef table stays in the .ino
+static const NativeBitmap* logoFor(const char* lineRef) {
+    uint32_t hash = 5381;
+    for (const char* c = lineRef; *c; c++) hash = hash * 33 + (uint8_t)*c;
+    const size_t count = sizeof(transit_logo_allArray) / sizeof(transit_logo_allArray[0]);
+    return transit_logo_allArray[hash % count];
+}
+
+void panelBegin() {
+    display.begin();
+    display.setRotation(1);
+    display.clearDisplay();
+}
+
+void panelRender(const BoardRow* rows, uint8_t count, bool cached) {
+    static FrameSnapshot frame;
+    frame.rowCount = count < FRAME_MAX_ROWS ? count : FRAME_MAX_ROWS;
+    for (uint8_t i = 0; i < frame.rowCount; i++) {
+        (BoardRow&)frame.rows[i] = rows[i];
+        frame.rows[i].logo = logoFor(rows[i].lineRef);
+    }
+    if (!cached) rowTiles.clear();
+
+    // renderFrame(), with the tile cache on
+    display.clearDisplay();
+    for (int i = 0; i < frame.rowCount; i++) {
+        const FrameRow& row = frame.rows[i];
+        int displayY = i * ROW_HEIGHT;
+        rowTiles.draw(row, displayY);
+
+        display.setSpanFont(&FreeSansBold24pt7bDigits);
+        display.setTextColor(MT_EPD::EPD_BLACK);
+        display.setCursor(150, displayY + 115);
+        display.printNative(DigitAtlas, row.times);
+        display.println();
+    }
+    display.setSpanFont(NULL);
+}
+
+void panelSplash() {
+    display.clearDisplay();
+    display.drawBitmap(0, 250, epd_bitmap_Muni_worm_logo, 480, 258, MT_EPD::EPD_RED);
+    display.setTextSize(2);
+    display.setTextColor(MT_EPD::EPD_BLACK);
+    display.setCursor(20, 540);
+    display.println("No logos.pak in LittleFS:");
+    display.setCursor(20, 560);
+    display.println("upload PicoBusses/data");
+    display.setTextSize(1);
+}
+
+void panelBadge(const char* text) {
+    int16_t y = (FRAME_MAX_ROWS - 1) * ROW_HEIGHT;
+    display.fillRect(0, y + 20, display.width(), 3, MT_EPD::EPD_RED);
+    display.setSpanFont(&FreeSans12pt7bSpans);
+    display.setTextColor(MT_EPD::EPD_RED);
+    display.setCursor(135, y + 60);
+    display.print(text);
+    display.setSpanFont(NULL);
+}
+
+uint64_t panelUpload() {
+    uint64_t before = SPI.bytes;
+    display.displayAsync();
+    return SPI.bytes - before;
+}
+
+uint32_t panelSum() {
+    return SPI.sum;
+}
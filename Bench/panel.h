@@ -0,0 +1,45 @@
+#ifndef BENCH_PANEL_H
+#define BENCH_PANEL_H
+
+#include <stdint.h>
+#include "ArrivalBoard.h"
+
+// The sketch's frame drawing and upload, built for the host (panel.cpp):
+// MT_EPD's planes, RowTileCache, the span and atlas fonts and the linked
+// logos, drawn exactly as renderFrame() in PicoBusses.ino draws them.
+
+/**
+* Brings the display up and blanks it, as setup() does.
+*/
+void panelBegin();
+
+/**
+* Draws a frame of board rows into the planes.
+* @param rows Rows, top first
+* @param count How many
+* @param cached false to forget the row tiles first, as if every row had changed
+*/
+void panelRender(const BoardRow* rows, uint8_t count, bool cached);
+
+/**
+* Draws the boot splash as setup() does when there's no saved frame and no
+* logo pak: the worm logo and a note in the built-in font.
+*/
+void panelSplash();
+
+/**
+* Draws a red rule and text along the bottom of the panel, over whatever is
+* there, as drawAgeBadge() badges a restored frame.
+*/
+void panelBadge(const char* text);
+
+/**
+* Sends the planes the way displayAsync() does, to a counting SPI.
+* @return Bytes sent
+*/
+uint64_t panelUpload();
+
+// Checksum of everything sent so far
+uint32_t panelSum();
+
+#endif
@@ -0,0 +1,83 @@
+#include "ArrivalBoard.h"
+#include <stdio.h>
+
+ArrivalBoard::ArrivalBoard() : _lineCount(0) {
+}
+
+static bool sameLine(const BusArrival& arrival, const char* lineRef, const char* destination, const char* stopPoint) {
+    return strcmp(arrival.lineRef, lineRef) == 0 &&
+           strcmp(arrival.destinationDisplay, destination) == 0 &&
+           strcmp(arrival.stopPointName, stopPoint) == 0;
+}
+
+// Marks the lines with an arrival due, adding the new ones while there's room
+void ArrivalBoard::collectActiveLines(const StopCodeData* stops, uint8_t stopCount, uint32_t now) {
+    for (uint8_t i = 0; i < _lineCount; i++) _lines[i].active = false;
+
+    for (uint8_t s = 0; s < stopCount; s++) {
+        for (int a = 0; a < stops[s].arrivalCount; a++) {
+            const BusArrival& arrival = stops[s].arrivals[a];
+            if (arrival.expectedArrivalEpoch <= now) continue;
+
+            bool found = false;
+            for (uint8_t i = 0; i < _lineCount; i++) {
+                if (sameLine(arrival, _lines[i].lineRef, _lines[i].destination, _lines[i].stopPoint)) {
+                    _lines[i].active = true;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found && _lineCount < BOARD_MAX_LINES) {
+                Line& line = _lines[_lineCount++];
+                copyText(line.lineRef, sizeof(line.lineRef), arrival.lineRef);
+                copyText(line.destination, sizeof(line.destination), arrival.destinationDisplay);
+                copyText(line.stopPoint, sizeof(line.stopPoint), arrival.stopPointName);
+                line.active = true;
+            }
+        }
+    }
+}
+
+uint8_t ArrivalBoard::layout(const StopCodeData* stops, uint8_t stopCount, uint32_t now, uint8_t maxRows) {
+    collectActiveLines(stops, stopCount, now);
+    if (maxRows > BOARD_MAX_ROWS) maxRows = BOARD_MAX_ROWS;
+
+    // Rows fill from top to bottom, in line order
+    uint8_t rowCount = 0;
+    for (uint8_t i = 0; i < _lineCount && rowCount < maxRows; i++) {
+        const Line& line = _lines[i];
+        if (!line.active) continue;
+
+        BoardRow& row = _rows[rowCount];
+        row.times[0] = '\0';
+        for (uint8_t s = 0; s < stopCount; s++) {
+            for (int a = 0; a < stops[s].arrivalCount; a++) {
+                const BusArrival& arrival = stops[s].arrivals[a];
+                if (arrival.expectedArrivalEpoch <= now) continue;
+                if (!sameLine(arrival, line.lineRef, line.destination, line.stopPoint)) continue;
+                appendMinutes(row.times, sizeof(row.times), (long)(arrival.expectedArrivalEpoch - now) / 60);
+            }
+        }
+        copyText(row.lineRef, sizeof(row.lineRef), line.lineRef);
+        copyText(row.destination, sizeof(row.destination), line.destination);
+        copyText(row.stopPoint, sizeof(row.stopPoint), line.stopPoint);
+        rowCount++;
+    }
+    return rowCount;
+}
+
+void ArrivalBoard::dropPast(StopCodeData& stop, uint32_t now) {
+    int kept = 0;
+    for (int i = 0; i < stop.arrivalCount; i++) {
+        if (stop.arrivals[i].expectedArrivalEpoch <= now) continue;
+        if (kept != i) stop.arrivals[kept] = stop.arrivals[i];
+        kept++;
+    }
+    stop.arrivalCount = kept;
+}
+
+void ArrivalBoard::appendMinutes(char* times, size_t size, long minutes) {
+    size_t n = strnlen(times, size);
+    if (n + 1 >= size) return;
+    snprintf(times + n, size - n, n > 0 ? ", %ld" : "%ld", minutes);
+}
@@ -0,0 +1,69 @@
+#ifndef ARRIVAL_BOARD_H
+#define ARRIVAL_BOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Arrivals.h"
+
+#define BOARD_MAX_LINES 10  // line + destination + stop combinations remembered
+#define BOARD_MAX_ROWS  6   // Rows that fit on the panel (6 x ROW_HEIGHT)
+
+// One row of the board as text: line, "To ...", "From ...", and the minutes
+// until each arrival, e.g. "3, 14, 27". FrameRow adds the logo.
+struct BoardRow {
+    char lineRef[8];
+    char destination[48];
+    char stopPoint[48];
+    char times[48];
+};
+
+// Merges every stop's arrivals into the rows the panel shows.
+//
+// A row is one line + destination + stop, with every arrival still due for
+// it across all the stops, in stop order and then feed order. Lines keep
+// the slot they were first seen in, so a row doesn't jump around the panel
+// from one fetch to the next; a line with nothing due is skipped, not
+// forgotten. No Arduino calls and no heap: the host build lays out the same
+// rows.
+class ArrivalBoard {
+  public:
+    ArrivalBoard();
+
+    /**
+    * Builds the rows from the stops' arrivals.
+    * @param stops Every stop
+    * @param stopCount Number of stops
+    * @param now UTC epoch; arrivals at or before it are left out
+    * @param maxRows At most this many rows, at most BOARD_MAX_ROWS
+    * @return Number of rows, see row()
+    */
+    uint8_t layout(const StopCodeData* stops, uint8_t stopCount, uint32_t now, uint8_t maxRows);
+
+    const BoardRow& row(uint8_t i) const { return _rows[i]; }
+
+    /**
+    * Drops a stop's arrivals at or before now.
+    */
+    static void dropPast(StopCodeData& stop, uint32_t now);
+
+    /**
+    * Appends ", minutes" (just minutes to an empty list), cut to fit.
+    */
+    static void appendMinutes(char* times, size_t size, long minutes);
+
+  private:
+    struct Line {
+        char lineRef[8];
+        char destination[48];
+        char stopPoint[48];
+        bool active;   // has an arrival due in this layout
+    };
+
+    Line _lines[BOARD_MAX_LINES];
+    uint8_t _lineCount;
+    BoardRow _rows[BOARD_MAX_ROWS];
+
+    void collectActiveLines(const StopCodeData* stops, uint8_t stopCount, uint32_t now);
+};
+
+#endif
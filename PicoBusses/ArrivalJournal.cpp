@@ -0,0 +1,220 @@
+#include "ArrivalJournal.h"
+#include "miniz.h"
+
+static const uint8_t RECORD_TAG = 0xA7;
+
+ArrivalJournal::ArrivalJournal() : _path(NULL), _mounted(false), _size(0), _stops(0) {}
+
+bool ArrivalJournal::begin(const char* path) {
+    _path = path;
+    _mounted = LittleFS.begin();
+    if (!_mounted) {
+        Serial.println("ArrivalJournal: LittleFS mount failed");
+        return false;
+    }
+
+    bool torn = false;
+    if (!scan(torn)) return true;  // no journal yet; the first append starts one
+    Serial.print("ArrivalJournal: ");
+    Serial.print(_stops);
+    Serial.print(" stops, ");
+    Serial.print(_size);
+    Serial.println(torn ? " bytes, torn tail" : " bytes");
+    if (torn || _size > JOURNAL_COMPACT_BYTES) compact();
+    return true;
+}
+
+// Indexes the newest record per stop. _size ends at the last good record;
+// torn is set if there's anything after it.
+bool ArrivalJournal::scan(bool& torn) {
+    _stops = 0;
+    _size = 0;
+    File file = LittleFS.open(_path, "r");
+    if (!file) return false;
+
+    uint32_t fileSize = file.size();
+    RecordHeader header;
+    size_t length;
+    while ((length = readRecord(file, header)) > 0) {
+        const char* stopCode;
+        if (!decode(header, stopCode, NULL)) break;
+        index(stopCode, _size, header.serverTime);
+        _size += length;
+    }
+    file.close();
+    torn = _size < fileSize;
+    return true;
+}
+
+// Rewrites the journal with just the indexed records
+bool ArrivalJournal::compact() {
+    static const char* TEMP_PATH = "/arrivals.tmp";
+    File from = LittleFS.open(_path, "r");
+    File to = LittleFS.open(TEMP_PATH, "w");
+    bool ok = from && to;
+
+    uint32_t size = 0;
+    for (uint8_t i = 0; ok && i < _stops; i++) {
+        RecordHeader header;
+        size_t length = from.seek(_index[i].offset) ? readRecord(from, header) : 0;
+        ok = length > 0 && to.write(_record, length) == length;
+        _index[i].offset = size;
+        size += length;
+    }
+    if (from) from.close();
+    if (to) to.close();
+
+    ok = ok && LittleFS.rename(TEMP_PATH, _path);
+    if (!ok) {
+        // Start over rather than keep appending after a bad record
+        Serial.println("ArrivalJournal: compaction failed, starting a new journal");
+        LittleFS.remove(TEMP_PATH);
+        LittleFS.remove(_path);
+        _stops = 0;
+        size = 0;
+    }
+    _size = size;
+    return ok;
+}
+
+// Reads the record at the file's position into _record and checks its CRC.
+// Returns its length, or 0 if it's short or damaged.
+size_t ArrivalJournal::readRecord(File& file, RecordHeader& header) {
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) return 0;
+    size_t length = sizeof(header) + header.length + 4;
+    if (header.tag != RECORD_TAG || header.count > JOURNAL_MAX_ARRIVALS || length > RECORD_MAX) return 0;
+
+    memcpy(_record, &header, sizeof(header));
+    size_t rest = length - sizeof(header);
+    if (file.read(_record + sizeof(header), rest) != rest) return 0;
+
+    uint32_t crc;
+    memcpy(&crc, _record + length - 4, 4);
+    if (crc != (uint32_t)mz_crc32(MZ_CRC32_INIT, _record, length - 4)) return 0;
+    return length;
+}
+
+// The NUL-terminated string at `at`, moving `at` past it; NULL if it runs
+// past end
+static const char* nextText(const char*& at, const char* end) {
+    const char* s = at;
+    const char* nul = (const char*)memchr(s, '\0', end - s);
+    if (!nul) return NULL;
+    at = nul + 1;
+    return s;
+}
+
+// Splits the payload in _record into the stop code and arrivals (if
+// arrivals isn't NULL). False if a field runs off the end.
+bool ArrivalJournal::decode(const RecordHeader& header, const char*& stopCode, Arrival* arrivals) {
+    const char* p = (const char*)_record + sizeof(header);
+    const char* end = p + header.length;
+
+    stopCode = nextText(p, end);
+    if (!stopCode) return false;
+    for (uint8_t i = 0; i < header.count; i++) {
+        Arrival a;
+        a.lineRef = nextText(p, end);
+        if (!a.lineRef || end - p < 4) return false;
+        memcpy(&a.expected, p, 4);
+        p += 4;
+        a.destination = nextText(p, end);
+        a.stopPoint = a.destination ? nextText(p, end) : NULL;
+        if (!a.stopPoint) return false;
+        if (arrivals) arrivals[i] = a;
+    }
+    return p == end;
+}
+
+void ArrivalJournal::index(const char* stopCode, uint32_t offset, uint32_t serverTime) {
+    uint8_t i = 0;
+    while (i < _stops && strcmp(_index[i].stopCode, stopCode) != 0) i++;
+    if (i == _stops) {
+        if (_stops == JOURNAL_MAX_STOPS) return;
+        strncpy(_index[i].stopCode, stopCode, sizeof(_index[i].stopCode) - 1);
+        _index[i].stopCode[sizeof(_index[i].stopCode) - 1] = '\0';
+        _stops++;
+    }
+    _index[i].offset = offset;
+    _index[i].serverTime = serverTime;
+}
+
+// Copies text (cut to max chars) and its NUL into _record at `at`; returns
+// the offset after it
+size_t ArrivalJournal::putText(size_t at, const char* text, size_t max) {
+    size_t n = strnlen(text, max);
+    memcpy(_record + at, text, n);
+    _record[at + n] = '\0';
+    return at + n + 1;
+}
+
+bool ArrivalJournal::append(const char* stopCode, uint32_t serverTime, const Arrival* arrivals, uint8_t count) {
+    if (!_mounted) return false;
+    if (count > JOURNAL_MAX_ARRIVALS) count = JOURNAL_MAX_ARRIVALS;
+
+    // Field limits match RECORD_MAX, so the record always fits
+    size_t at = sizeof(RecordHeader);
+    at = putText(at, stopCode, sizeof(_index[0].stopCode) - 1);
+    for (uint8_t i = 0; i < count; i++) {
+        at = putText(at, arrivals[i].lineRef, 7);
+        memcpy(_record + at, &arrivals[i].expected, 4);
+        at += 4;
+        at = putText(at, arrivals[i].destination, JOURNAL_TEXT_MAX);
+        at = putText(at, arrivals[i].stopPoint, JOURNAL_TEXT_MAX);
+    }
+
+    RecordHeader header;
+    header.tag = RECORD_TAG;
+    header.count = count;
+    header.length = at - sizeof(header);
+    header.serverTime = serverTime;
+    memcpy(_record, &header, sizeof(header));
+    uint32_t crc = mz_crc32(MZ_CRC32_INIT, _record, at);
+    memcpy(_record + at, &crc, 4);
+    size_t length = at + 4;
+
+    File file = LittleFS.open(_path, "a");
+    if (!file) return false;
+    bool ok = file.write(_record, length) == length;
+    file.close();
+    if (!ok) {
+        // A partial record would hide everything after it: rewrite without it
+        compact();
+        return false;
+    }
+
+    const char* stored = (const char*)_record + sizeof(header);
+    index(stored, _size, serverTime);
+    _size += length;
+    if (_size > JOURNAL_COMPACT_BYTES) compact();
+    return true;
+}
+
+uint8_t ArrivalJournal::replay(StopVisitor visit) {
+    File file = LittleFS.open(_path, "r");
+    if (!file) return 0;
+
+    uint32_t newest = 0;
+    for (uint8_t i = 0; i < _stops; i++) {
+        if (_index[i].serverTime > newest) newest = _index[i].serverTime;
+    }
+
+    uint8_t visited = 0;
+    Arrival arrivals[JOURNAL_MAX_ARRIVALS];
+    for (uint8_t i = 0; i < _stops; i++) {
+        RecordHeader header;
+        const char* stopCode;
+        if (!file.seek(_index[i].offset) || readRecord(file, header) == 0 ||
+            !decode(header, stopCode, arrivals)) continue;
+
+        // Keep only what's still due
+        uint8_t due = 0;
+        for (uint8_t j = 0; j < header.count; j++) {
+            if (arrivals[j].expected > newest) arrivals[due++] = arrivals[j];
+        }
+        visit(stopCode, header.serverTime, arrivals, due);
+        visited++;
+    }
+    file.close();
+    return visited;
+}
@@ -0,0 +1,111 @@
+#ifndef ARRIVAL_JOURNAL_H
+#define ARRIVAL_JOURNAL_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#define JOURNAL_MAX_STOPS 16      // stop codes the index keeps track of
+#define JOURNAL_MAX_ARRIVALS 20   // per record, as MAX_ARRIVALS in Arrivals.h
+#define JOURNAL_TEXT_MAX 63       // longer names are cut to this on the way in
+
+// Every stop's arrivals, journalled to the LittleFS partition so a reset
+// doesn't cost a full round-robin (N stops x 65 s) to fill the display
+// again.
+//
+// The file is append-only: each successful fetch adds one record holding
+// that stop's arrivals and the server time of the response, closed by a
+// CRC-32. A record replaces the stop's earlier ones. begin() scans the file
+// and indexes the newest record per stop; the scan stops at the first record
+// that doesn't check out (a write cut short by a reset), and the file is
+// then compacted -- rewritten with only the indexed records and renamed over
+// the old one, which LittleFS does atomically. It's also compacted once it
+// passes JOURNAL_COMPACT_BYTES, so it stays a few KB.
+//
+// Appends are small writes that LittleFS spreads over the whole partition
+// (its blocks are wear-levelled), so a fetch a minute wears no block much.
+// Core0 only: LittleFS and File use the heap.
+class ArrivalJournal {
+  public:
+    static const uint32_t JOURNAL_COMPACT_BYTES = 16 * 1024;
+
+    // One arrival; on replay the strings point into the journal's buffer and
+    // last until the visitor returns
+    struct Arrival {
+        const char* lineRef;
+        uint32_t expected;        // UTC epoch
+        const char* destination;
+        const char* stopPoint;
+    };
+
+    typedef void (*StopVisitor)(const char* stopCode, uint32_t serverTime,
+                                const Arrival* arrivals, uint8_t count);
+
+    ArrivalJournal();
+
+    /**
+    * Mounts LittleFS and indexes the journal, compacting it if the tail is
+    * torn. Core0 only.
+    * @param path Journal file
+    * @return true if the journal is usable
+    */
+    bool begin(const char* path = "/arrivals.jnl");
+
+    /**
+    * Records a stop's arrivals, replacing what the journal had for it.
+    * Core0 only.
+    * @param stopCode Stop the arrivals are for
+    * @param serverTime The response's timestamp (UTC epoch)
+    * @param arrivals Arrivals, at most JOURNAL_MAX_ARRIVALS
+    * @param count Number of arrivals
+    * @return true if the record is in flash
+    */
+    bool append(const char* stopCode, uint32_t serverTime, const Arrival* arrivals, uint8_t count);
+
+    /**
+    * Calls visit once for every stop in the journal, with the arrivals
+    * still due. The newest server time in the journal is the best guess at
+    * "now" before the first fetch, so arrivals before it are dropped.
+    * Core0 only.
+    * @param visit Called with each stop's arrivals
+    * @return Number of stops visited
+    */
+    uint8_t replay(StopVisitor visit);
+
+    uint32_t size() const { return _size; }
+
+  private:
+    // Record header, little-endian like the RP2350. The payload follows:
+    // the stop code, then per arrival lineRef, u32 expected, destination and
+    // stopPoint, strings NUL-terminated. Then a CRC-32 of header and payload.
+    struct RecordHeader {
+        uint8_t tag;
+        uint8_t count;
+        uint16_t length;      // payload bytes
+        uint32_t serverTime;
+    };
+
+    struct IndexEntry {
+        char stopCode[16];
+        uint32_t offset;      // of the stop's newest record
+        uint32_t serverTime;
+    };
+
+    static const size_t RECORD_MAX = sizeof(RecordHeader) + 16 +
+        JOURNAL_MAX_ARRIVALS * (8 + 4 + 2 * (JOURNAL_TEXT_MAX + 1)) + 4;
+
+    const char* _path;
+    bool _mounted;
+    uint32_t _size;
+    IndexEntry _index[JOURNAL_MAX_STOPS];
+    uint8_t _stops;
+    uint8_t _record[RECORD_MAX];
+
+    bool scan(bool& torn);
+    bool compact();
+    size_t readRecord(File& file, RecordHeader& header);
+    bool decode(const RecordHeader& header, const char*& stopCode, Arrival* arrivals);
+    void index(const char* stopCode, uint32_t offset, uint32_t serverTime);
+    size_t putText(size_t at, const char* text, size_t max);
+};
+
+#endif
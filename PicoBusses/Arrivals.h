@@ -0,0 +1,36 @@
+#ifndef ARRIVALS_H
+#define ARRIVALS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MAX_ARRIVALS 20 // Maximum number of arrivals we can store per stop
+#define STOP_CODE_MAX 16
+
+// The arrival model, shared by the parser, the aggregation and the sketch.
+// Fixed char arrays, sized like FrameRow's, and the arrival time as an
+// epoch parsed once: nothing here needs Arduino, so the same structs build
+// on the host (see CMakeLists.txt).
+struct BusArrival {
+    char lineRef[8];
+    char destinationDisplay[48];
+    char stopPointName[48];
+    uint32_t expectedArrivalEpoch;  // UTC
+};
+
+struct StopCodeData {
+    char stopCode[STOP_CODE_MAX];
+    BusArrival arrivals[MAX_ARRIVALS];
+    int arrivalCount = 0;
+    unsigned long fetchedAt = 0;  // millis() of the last good fetch, 0 for none yet
+};
+
+// Copies text into a fixed field, cut to fit and always terminated
+inline void copyText(char* out, size_t size, const char* text) {
+    size_t n = text ? strnlen(text, size - 1) : 0;
+    if (n > 0) memcpy(out, text, n);
+    out[n] = '\0';
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "CrashLog.h"
+#include "hardware/watchdog.h"
+
+static const char COUNTS_MAGIC[4] = {'N', 'B', 'R', 'C'};
+static const uint16_t COUNTS_VERSION = 1;
+static const uint32_t RECORD_MAGIC = 0x4E424352;
+static const uint32_t BUSY_STUCK_MS = 60000;  // a refresh takes seconds; a minute on BUSY is stuck
+
+// Survives a watchdog reset (or the RUN pin) in RAM the C runtime doesn't
+// zero; garbage after a power-up, which magic and check catch. The fields the
+// cores store to while running are volatile: the reset can come at any time.
+struct CrashRecord {
+    uint32_t magic;
+    uint32_t boots;                  // resets since the last power-up
+    volatile uint8_t phase;          // core0's, PHASE_IDLE between cycles
+    volatile uint8_t core1Phase;
+    volatile uint8_t reason;         // CrashLog::Reason
+    volatile uint8_t linkUp;         // at the reason
+    volatile uint32_t phaseAt;       // millis() it was entered
+    volatile uint32_t core1PhaseAt;
+    volatile uint32_t petAt;         // millis() of the last watchdog pet
+    volatile uint32_t reasonAt;
+    uint8_t cycles;                  // of timings below, newest first
+    uint32_t frames[CRASH_CYCLES];
+    uint32_t us[CRASH_CYCLES][PHASE_COUNT];
+    uint32_t heapUsed, heapLargest, arenaPeak;
+    uint32_t stack0Peak, stack1Peak;
+    uint32_t check;                  // ~magic
+};
+static CrashRecord __uninitialized_ram(crashRecord);
+
+static const char* const CAUSE_NAMES[CrashLog::CAUSE_COUNT] = {
+    "power-on", "reset", "no WiFi at boot", "BUSY stuck", "WiFi down",
+    "fetches failing", "connect wedged", "hang"
+};
+
+static const char* phaseName(uint8_t phase) {
+    return phase < PHASE_COUNT ? PhaseTimer::name((Phase)phase) : "idle";
+}
+
+CrashLog::CrashLog() : _path(NULL) {
+    memset(_counts, 0, sizeof(_counts));
+}
+
+const char* CrashLog::name(Cause cause) {
+    return cause < CAUSE_COUNT ? CAUSE_NAMES[cause] : "?";
+}
+
+void CrashLog::enter(uint8_t phase) {
+    crashRecord.phaseAt = millis();
+    crashRecord.phase = phase;
+}
+
+void CrashLog::enterCore1(uint8_t phase) {
+    crashRecord.core1PhaseAt = millis();
+    crashRecord.core1Phase = phase;
+}
+
+void CrashLog::pet() {
+    crashRecord.petAt = millis();
+}
+
+void CrashLog::noteReason(Reason reason, bool linkUp) {
+    if (crashRecord.reason == reason) return;  // the first time is the one that counts
+    crashRecord.reasonAt = millis();
+    crashRecord.linkUp = linkUp;
+    crashRecord.reason = reason;
+}
+
+void CrashLog::noteTimings(const PhaseTimer& timer) {
+    uint8_t n = 0;
+    for (uint8_t back = 0; back < CRASH_CYCLES; back++) {
+        const uint32_t* us = timer.recent(back, crashRecord.frames[n]);
+        if (!us) break;
+        memcpy(crashRecord.us[n], us, sizeof(crashRecord.us[n]));
+        n++;
+    }
+    crashRecord.cycles = n;
+}
+
+void CrashLog::noteMemory(const MemStats& mem) {
+    const MemStats::Heap& heap = mem.heap();
+    crashRecord.heapUsed = heap.used;
+    crashRecord.heapLargest = heap.largest;
+    crashRecord.arenaPeak = heap.arenaPeak;
+    crashRecord.stack0Peak = mem.core0Stack().peak;
+    crashRecord.stack1Peak = mem.core1Stack().peak;
+}
+
+// What the record and the hardware say about the last reset
+static CrashLog::Cause classify(bool intact) {
+    if (!intact) return CrashLog::CAUSE_POWER_ON;
+    if (!watchdog_enable_caused_reboot()) return CrashLog::CAUSE_RESET;
+
+    switch (crashRecord.reason) {
+        case CrashLog::REASON_NO_WIFI:
+            return CrashLog::CAUSE_NO_WIFI;
+        case CrashLog::REASON_DISPLAY_STALE:
+            if (crashRecord.core1Phase == PHASE_BUSY &&
+                crashRecord.reasonAt - crashRecord.core1PhaseAt > BUSY_STUCK_MS) {
+                return CrashLog::CAUSE_BUSY_STUCK;
+            }
+            return crashRecord.linkUp ? CrashLog::CAUSE_FETCH_FAILING : CrashLog::CAUSE_LINK_DOWN;
+        default:
+            break;
+    }
+
+    // Nobody let it through: core0 stopped petting
+    switch (crashRecord.phase) {
+        case PHASE_DNS:
+        case PHASE_CONNECT:
+        case PHASE_TLS:
+        case PHASE_FIRST_BYTE:
+            return CrashLog::CAUSE_CONNECT_WEDGED;
+        default:
+            return CrashLog::CAUSE_HANG;
+    }
+}
+
+static void printRecord(Print& out) {
+    out.print("  core0 in ");
+    out.print(phaseName(crashRecord.phase));
+    out.print(" since ");
+    out.print(crashRecord.phaseAt);
+    out.print(" ms, last pet at ");
+    out.print(crashRecord.petAt);
+    out.print(" ms; core1 in ");
+    out.print(phaseName(crashRecord.core1Phase));
+    out.print(" since ");
+    out.print(crashRecord.core1PhaseAt);
+    out.println(" ms");
+
+    out.print("  heap ");
+    out.print(crashRecord.heapUsed);
+    out.print(" used, largest free ");
+    out.print(crashRecord.heapLargest);
+    out.print(", arena peak ");
+    out.print(crashRecord.arenaPeak);
+    out.print("; stack peaks core0 ");
+    out.print(crashRecord.stack0Peak);
+    out.print(", core1 ");
+    out.println(crashRecord.stack1Peak);
+
+    for (uint8_t i = 0; i < crashRecord.cycles && i < CRASH_CYCLES; i++) {
+        out.print("  frame ");
+        out.print(crashRecord.frames[i]);
+        out.print(" (ms):");
+        for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+            uint32_t us = crashRecord.us[i][p];
+            if (us == PhaseTimer::NOT_MEASURED) continue;
+            out.print(' ');
+            out.print(PhaseTimer::name((Phase)p));
+            out.print(' ');
+            out.print(us / 1000);
+        }
+        out.println();
+    }
+}
+
+CrashLog::Cause CrashLog::begin(const char* path) {
+    _path = path;
+    bool intact = crashRecord.magic == RECORD_MAGIC && crashRecord.check == ~RECORD_MAGIC;
+    Cause cause = classify(intact);
+
+    Serial.print("CrashLog: last reset: ");
+    Serial.print(name(cause));
+    if (intact) {
+        Serial.print(", reset ");
+        Serial.print(crashRecord.boots + 1);
+        Serial.println(" since power-up");
+        printRecord(Serial);
+    } else {
+        Serial.println();
+    }
+
+    bool mounted = LittleFS.begin();
+    if (mounted) load();
+    _counts[cause]++;
+    if (mounted) save();
+
+    Serial.print("CrashLog: resets so far:");
+    for (uint8_t c = 0; c < CAUSE_COUNT; c++) {
+        if (_counts[c] == 0) continue;
+        Serial.print(' ');
+        Serial.print(CAUSE_NAMES[c]);
+        Serial.print(' ');
+        Serial.print(_counts[c]);
+    }
+    Serial.println();
+
+    // A fresh record for this boot
+    uint32_t boots = intact ? crashRecord.boots + 1 : 0;
+    memset((void*)&crashRecord, 0, sizeof(crashRecord));
+    crashRecord.boots = boots;
+    crashRecord.phase = PHASE_IDLE;
+    crashRecord.core1Phase = PHASE_IDLE;
+    crashRecord.magic = RECORD_MAGIC;
+    crashRecord.check = ~RECORD_MAGIC;
+    return cause;
+}
+
+void CrashLog::load() {
+    File file = LittleFS.open(_path, "r");
+    if (!file) return;
+    char magic[4];
+    uint16_t version;
+    uint32_t counts[CAUSE_COUNT];
+    bool ok = file.read((uint8_t*)magic, sizeof(magic)) == sizeof(magic) &&
+              memcmp(magic, COUNTS_MAGIC, sizeof(magic)) == 0 &&
+              file.read((uint8_t*)&version, sizeof(version)) == sizeof(version) &&
+              version == COUNTS_VERSION &&
+              file.read((uint8_t*)counts, sizeof(counts)) == sizeof(counts);
+    file.close();
+    if (ok) memcpy(_counts, counts, sizeof(_counts));
+}
+
+void CrashLog::save() {
+    File file = LittleFS.open(_path, "w");
+    if (!file) return;
+    file.write((const uint8_t*)COUNTS_MAGIC, sizeof(COUNTS_MAGIC));
+    file.write((const uint8_t*)&COUNTS_VERSION, sizeof(COUNTS_VERSION));
+    file.write((const uint8_t*)_counts, sizeof(_counts));
+    file.close();
+}
@@ -0,0 +1,101 @@
+#ifndef CRASH_LOG_H
+#define CRASH_LOG_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "PhaseTimer.h"
+#include "MemStats.h"
+
+#define CRASH_CYCLES 4  // poll cycles of phase timings the record keeps
+
+// What the display watchdog (or anything else) reset the chip over, kept
+// across the reset so the next boot can say.
+//
+// The record lives in RAM the C runtime doesn't zero, like NetCache's warm
+// clock, so keeping it current is a few plain stores: each core notes the
+// phase it enters (enter(), enterCore1()), the watchdog pets are stamped,
+// and a deliberate reset (display stale, no WiFi at boot) notes its reason
+// before it lets the watchdog fire. After every poll cycle the last
+// CRASH_CYCLES cycles' phase timings and the heap and stack figures are
+// copied in.
+//
+// begin() reads it at boot: with the hardware's word on whether the watchdog
+// fired, it tells a stuck BUSY line from a wedged connect, a dropped link or
+// fetches that keep failing, prints what it has, and bumps that cause's
+// counter in the LittleFS partition -- the counters survive a power-up, the
+// record doesn't.
+class CrashLog {
+  public:
+    // What the chip was last reset over
+    enum Cause : uint8_t {
+        CAUSE_POWER_ON,        // no record: power-up (or the first boot)
+        CAUSE_RESET,           // record intact, not the watchdog: RUN pin, upload, soft reset
+        CAUSE_NO_WIFI,         // no link within the boot timeout
+        CAUSE_BUSY_STUCK,      // panel stale, core1 waiting on BUSY
+        CAUSE_LINK_DOWN,       // panel stale, WiFi down
+        CAUSE_FETCH_FAILING,   // panel stale, link up, nothing new to show
+        CAUSE_CONNECT_WEDGED,  // core0 stopped petting in DNS, connect or TLS
+        CAUSE_HANG,            // core0 stopped petting anywhere else
+        CAUSE_COUNT
+    };
+
+    // Why a deliberate reset was let through
+    enum Reason : uint8_t { REASON_NONE, REASON_DISPLAY_STALE, REASON_NO_WIFI };
+
+    static const uint8_t PHASE_IDLE = PHASE_COUNT;  // between cycles
+
+    CrashLog();
+
+    /**
+    * Classifies the last reset, prints the record and the counters, saves
+    * them, and starts a fresh record. Mounts LittleFS. Core0, early in
+    * setup().
+    * @param path File the counters are kept in
+    * @return Why the chip was reset
+    */
+    Cause begin(const char* path = "/resets.bin");
+
+    /**
+    * Core0 entered phase (PHASE_IDLE between cycles). Plain stores.
+    */
+    static void enter(uint8_t phase);
+
+    /**
+    * Core1 entered phase. Plain stores; no heap, no Serial.
+    */
+    static void enterCore1(uint8_t phase);
+
+    /**
+    * The watchdog was fed; core0.
+    */
+    static void pet();
+
+    /**
+    * Notes why the reset that's about to happen is happening.
+    */
+    static void noteReason(Reason reason, bool linkUp);
+
+    /**
+    * Copies the newest CRASH_CYCLES cycles out of timer. Core0, after each
+    * poll cycle.
+    */
+    void noteTimings(const PhaseTimer& timer);
+
+    /**
+    * Copies mem's last heap sample and the stack watermarks. Core0.
+    */
+    void noteMemory(const MemStats& mem);
+
+    uint32_t count(Cause cause) const { return _counts[cause]; }
+
+    static const char* name(Cause cause);
+
+  private:
+    const char* _path;
+    uint32_t _counts[CAUSE_COUNT];
+
+    void load();
+    void save();
+};
+
+#endif
@@ -0,0 +1,329 @@
+#include "Fetcher.h"
+#include <WiFi.h>
+#include "Log.h"
+
+Fetcher::Fetcher(Client& client, const char* host, uint16_t port)
+    : _client(client), _host(host), _port(port), _resolver(nullptr),
+      _state(IDLE), _attempt(0), _stateSince(0),
+      _lineLen(0), _statusSeen(false), _status(0), _contentLength(-1), _chunked(false),
+      _body(nullptr), _bodyLen(0), _bodyCap(0),
+      _chunkState(CHUNK_SIZE), _chunkLeft(0) {
+#if PHASE_TIMING
+    _sentAt = 0;
+    _firstByteAt = 0;
+#endif
+}
+
+Fetcher::~Fetcher() {
+    if (_body) free(_body);
+}
+
+void Fetcher::begin(const String& request) {
+    release();
+    _request = request;
+    _attempt = 0;
+    startAttempt();
+}
+
+void Fetcher::release() {
+    if (_body) free(_body);
+    _body = nullptr;
+    _bodyLen = 0;
+    _bodyCap = 0;
+    _state = IDLE;
+}
+
+void Fetcher::startAttempt() {
+    // Make sure we start with a fresh connection
+    _client.stop();
+    _attempt++;
+
+    _lineLen = 0;
+    _statusSeen = false;
+    _status = 0;
+    _contentLength = -1;
+    _chunked = false;
+    _bodyLen = 0;  // keep the buffer, a retry will need it again
+    _chunkState = CHUNK_SIZE;
+    _chunkLeft = 0;
+
+    _state = RESOLVE;
+}
+
+void Fetcher::failAttempt(const char* why) {
+    LOG_WARN("Fetch attempt %u of %u: %s", _attempt, (unsigned)MAX_ATTEMPTS, why);
+    _client.stop();
+
+    if (_attempt >= MAX_ATTEMPTS) {
+        LOG_ERROR("Failed to get data after all retries");
+        if (_body) free(_body);
+        _body = nullptr;
+        _bodyLen = 0;
+        _bodyCap = 0;
+        _state = FAILED;
+        return;
+    }
+
+    _stateSince = millis();
+    _state = RETRY_WAIT;
+}
+
+void Fetcher::finish() {
+#if PHASE_TIMING
+    if (_firstByteAt != 0) phaseTimer.add(PHASE_DOWNLOAD, micros() - _firstByteAt);
+#endif
+    _client.stop();
+    _state = DONE;
+}
+
+Fetcher::State Fetcher::poll() {
+    switch (_state) {
+        case RESOLVE: {
+            PHASE_STAMP(resolveAt);
+            IPAddress ip;
+            bool found = _resolver ? _resolver(_host, ip) : WiFi.hostByName(_host, ip);
+            PHASE_ADD(PHASE_DNS, resolveAt);
+            if (!found) {
+                failAttempt("DNS lookup failed! Check WiFi.");
+            } else {
+                _state = CONNECT;
+            }
+            break;
+        }
+
+        case CONNECT: {
+            // Blocks for the TCP connect and the TLS handshake. The client
+            // underneath adds PHASE_CONNECT (and any lookup it redoes) as it
+            // goes; the handshake is whatever's left.
+#if PHASE_TIMING
+            uint32_t connectAt = micros();
+            uint32_t tcpBefore = phaseTimer.current(PHASE_CONNECT) + phaseTimer.current(PHASE_DNS);
+#endif
+            bool connected = _client.connect(_host, _port);
+#if PHASE_TIMING
+            uint32_t tcp = phaseTimer.current(PHASE_CONNECT) + phaseTimer.current(PHASE_DNS) - tcpBefore;
+            uint32_t total = micros() - connectAt;
+            phaseTimer.add(PHASE_TLS, total > tcp ? total - tcp : 0);
+#endif
+            if (!connected) {
+                failAttempt("Connection failed! Check server name, WiFi, or SSL.");
+            } else {
+                _state = SEND;
+            }
+            break;
+        }
+
+        case SEND:
+            _client.print(_request);
+#if PHASE_TIMING
+            _sentAt = micros();
+            _firstByteAt = 0;
+#endif
+            _stateSince = millis();
+            _state = HEADERS;
+            break;
+
+        case HEADERS:
+            pollHeaders();
+            break;
+
+        case BODY:
+            pollBody();
+            break;
+
+        case RETRY_WAIT:
+            if (millis() - _stateSince >= RETRY_DELAY_MS) startAttempt();
+            break;
+
+        default:
+            break;
+    }
+    return _state;
+}
+
+void Fetcher::pollHeaders() {
+    size_t budget = READ_SLICE;
+    bool gotData = false;
+
+    // Byte at a time so nothing past the blank line gets swallowed
+    while (budget > 0 && _state == HEADERS && _client.available()) {
+        int c = _client.read();
+        if (c < 0) break;
+        budget--;
+        gotData = true;
+#if PHASE_TIMING
+        if (_firstByteAt == 0) {
+            _firstByteAt = micros() | 1;  // never 0
+            phaseTimer.add(PHASE_FIRST_BYTE, _firstByteAt - _sentAt);
+        }
+#endif
+
+        if (c == '\n') {
+            headerLine();
+            _lineLen = 0;
+        } else if (c != '\r' && _lineLen < sizeof(_line) - 1) {
+            _line[_lineLen++] = (char)c;
+        }
+    }
+    if (_state != HEADERS) return;
+
+    if (gotData) _stateSince = millis();
+
+    if (!_client.connected() && !_client.available()) {
+        failAttempt(_statusSeen ? "Connection closed in headers" : "No response received");
+    } else if (millis() - _stateSince >= IDLE_TIMEOUT_MS) {
+        failAttempt("Timed out waiting for headers");
+    }
+}
+
+void Fetcher::headerLine() {
+    _line[_lineLen] = '\0';
+
+    if (!_statusSeen) {
+        // "HTTP/1.1 200 OK"
+        _statusSeen = true;
+        const char* sp = strchr(_line, ' ');
+        _status = sp ? atoi(sp + 1) : 0;
+        return;
+    }
+
+    if (_lineLen > 0) {
+        if (strncasecmp(_line, "Content-Length:", 15) == 0) {
+            _contentLength = atol(_line + 15);
+        } else if (strncasecmp(_line, "Transfer-Encoding:", 18) == 0 && strstr(_line + 18, "chunked")) {
+            _chunked = true;
+        }
+        return;
+    }
+
+    // Blank line: end of headers
+    if (_status >= 400 && _status < 500) {
+        // 429 and friends won't get better by asking again right away
+        LOG_WARN("HTTP error %d", _status);
+        _client.stop();
+        _state = FAILED;
+        return;
+    }
+    if (_status != 200) {
+        failAttempt("Unexpected HTTP status");
+        return;
+    }
+    if (!_chunked && _contentLength == 0) {
+        failAttempt("Empty body");
+        return;
+    }
+    if (!_chunked && _contentLength > 0 && !reserve((size_t)_contentLength)) {
+        failAttempt("Failed to allocate memory for body");
+        return;
+    }
+    _state = BODY;
+}
+
+void Fetcher::pollBody() {
+    uint8_t buf[256];
+    size_t budget = READ_SLICE;
+    bool gotData = false;
+
+    while (budget > 0 && _client.available()) {
+        size_t want = min(budget, sizeof(buf));
+        if (!_chunked && _contentLength >= 0) {
+            want = min(want, (size_t)_contentLength - _bodyLen);
+        }
+        int n = _client.read(buf, want);
+        if (n <= 0) break;
+        budget -= n;
+        gotData = true;
+
+        if (!consumeBody(buf, n)) {
+            failAttempt("Failed to allocate memory for body");
+            return;
+        }
+        if (bodyComplete()) {
+            finish();
+            return;
+        }
+    }
+
+    if (gotData) _stateSince = millis();
+
+    // Without a length or chunking, the body simply runs until the server stops
+    bool closeDelimited = !_chunked && _contentLength < 0;
+
+    if (!_client.connected() && !_client.available()) {
+        if (closeDelimited && _bodyLen > 0) finish();
+        else failAttempt("Connection closed mid-body");
+    } else if (millis() - _stateSince >= IDLE_TIMEOUT_MS) {
+        if (closeDelimited && _bodyLen > 0) finish();
+        else failAttempt("Timed out reading body");
+    }
+}
+
+bool Fetcher::consumeBody(const uint8_t* data, size_t len) {
+    if (!_chunked) return appendBody(data, len);
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t c = data[i];
+        switch (_chunkState) {
+            case CHUNK_SIZE:
+                if (c >= '0' && c <= '9') _chunkLeft = (_chunkLeft << 4) | (c - '0');
+                else if (c >= 'a' && c <= 'f') _chunkLeft = (_chunkLeft << 4) | (c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') _chunkLeft = (_chunkLeft << 4) | (c - 'A' + 10);
+                else if (c == ';') _chunkState = CHUNK_EXT;
+                else if (c == '\n') _chunkState = _chunkLeft ? CHUNK_DATA : CHUNK_DONE;
+                break;
+
+            case CHUNK_EXT:
+                if (c == '\n') _chunkState = _chunkLeft ? CHUNK_DATA : CHUNK_DONE;
+                break;
+
+            case CHUNK_DATA: {
+                size_t run = min(_chunkLeft, len - i);
+                if (!appendBody(data + i, run)) return false;
+                _chunkLeft -= run;
+                i += run - 1;
+                if (_chunkLeft == 0) _chunkState = CHUNK_DATA_END;
+                break;
+            }
+
+            case CHUNK_DATA_END:
+                // CRLF after the chunk data
+                if (c == '\n') _chunkState = CHUNK_SIZE;
+                break;
+
+            case CHUNK_DONE:
+                // Trailers, ignored
+                break;
+        }
+    }
+    return true;
+}
+
+bool Fetcher::reserve(size_t size) {
+    if (size <= _bodyCap) return true;
+    uint8_t* grown = (uint8_t*)realloc(_body, size);
+    if (!grown) {
+#if MEM_STATS
+        memStats.noteFailure(PHASE_DOWNLOAD, size);
+#endif
+        return false;
+    }
+    _body = grown;
+    _bodyCap = size;
+    return true;
+}
+
+bool Fetcher::appendBody(const uint8_t* data, size_t len) {
+    if (_bodyLen + len > _bodyCap) {
+        size_t want = max(max(_bodyCap * 2, _bodyLen + len), (size_t)4096);
+        if (!reserve(want)) return false;
+    }
+    memcpy(_body + _bodyLen, data, len);
+    _bodyLen += len;
+    return true;
+}
+
+bool Fetcher::bodyComplete() const {
+    if (_chunked) return _chunkState == CHUNK_DONE;
+    if (_contentLength >= 0) return _bodyLen >= (size_t)_contentLength;
+    return false;
+}
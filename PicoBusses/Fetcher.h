@@ -0,0 +1,118 @@
+#ifndef FETCHER_H
+#define FETCHER_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "PhaseTimer.h"
+#include "MemStats.h"
+
+// Resumable HTTPS GET for the 511 API.
+//
+// getData() used to do the whole request in one call: connect, delay(100),
+// spin on a 5 s idle-read loop, retry up to three times with delay(1000) in
+// between. Fetcher splits that into states and poll() does one bounded slice
+// of work per call, so loop() keeps spinning while a request is in flight.
+//
+// The TCP connect and TLS handshake still happen inside a single
+// SSLClient::connect() call -- SSLClient doesn't expose them separately -- so
+// CONNECT is the one state that can hold a poll() for a while. Every other
+// state reads or waits at most READ_SLICE bytes / one check per call.
+class Fetcher {
+  public:
+    enum State : uint8_t {
+        IDLE,        // nothing in flight
+        RESOLVE,     // DNS lookup of the API host
+        CONNECT,     // TCP connect + TLS handshake
+        SEND,        // write the GET request
+        HEADERS,     // status line and headers
+        BODY,        // response body (Content-Length, chunked or until close)
+        RETRY_WAIT,  // backing off before the next attempt
+        DONE,        // body() holds the response body
+        FAILED       // gave up
+    };
+
+    static const uint8_t  MAX_ATTEMPTS    = 3;
+    static const uint32_t RETRY_DELAY_MS  = 1000;
+    static const uint32_t IDLE_TIMEOUT_MS = 5000;  // no bytes for this long ends the read
+    static const size_t   READ_SLICE      = 1024;  // max bytes consumed per poll()
+
+    // Looks a host name up; false if it can't
+    typedef bool (*Resolver)(const char* host, IPAddress& ip);
+
+    Fetcher(Client& client, const char* host, uint16_t port);
+    ~Fetcher();
+
+    /**
+    * Replaces the DNS lookup RESOLVE does (WiFi.hostByName() by default),
+    * e.g. with one that caches.
+    */
+    void setResolver(Resolver resolver) { _resolver = resolver; }
+
+    /**
+    * Starts a new request. Any previous body is released.
+    * @param request Complete HTTP request, sent again on every attempt
+    */
+    void begin(const String& request);
+
+    /**
+    * Does one bounded slice of work and returns the new state.
+    */
+    State poll();
+
+    /**
+    * Frees the body buffer and returns to IDLE.
+    */
+    void release();
+
+    State state() const { return _state; }
+    bool busy() const { return _state != IDLE && _state != DONE && _state != FAILED; }
+    const uint8_t* body() const { return _body; }
+    size_t bodyLength() const { return _bodyLen; }
+    int statusCode() const { return _status; }
+    uint8_t attempts() const { return _attempt; }
+
+  private:
+    enum ChunkState : uint8_t { CHUNK_SIZE, CHUNK_EXT, CHUNK_DATA, CHUNK_DATA_END, CHUNK_DONE };
+
+    Client& _client;
+    const char* _host;
+    uint16_t _port;
+    Resolver _resolver;
+    String _request;
+
+    State _state;
+    uint8_t _attempt;
+    unsigned long _stateSince;  // millis() when the current wait started
+#if PHASE_TIMING
+    uint32_t _sentAt;           // micros() when the request went out
+    uint32_t _firstByteAt;      // micros() of the first response byte, 0 until then
+#endif
+
+    // Header parsing
+    char _line[96];
+    uint8_t _lineLen;
+    bool _statusSeen;
+    int _status;
+    long _contentLength;        // -1 when the server didn't send one
+    bool _chunked;
+
+    // Body
+    uint8_t* _body;
+    size_t _bodyLen;
+    size_t _bodyCap;
+    ChunkState _chunkState;
+    size_t _chunkLeft;
+
+    void startAttempt();
+    void failAttempt(const char* why);
+    void finish();
+    void pollHeaders();
+    void pollBody();
+    void headerLine();
+    bool consumeBody(const uint8_t* data, size_t len);
+    bool reserve(size_t size);
+    bool appendBody(const uint8_t* data, size_t len);
+    bool bodyComplete() const;
+};
+
+#endif
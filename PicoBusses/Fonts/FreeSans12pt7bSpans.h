@@ -0,0 +1,309 @@
+// Generated by Scripts/fontcompile.py from FreeSans12pt7b.h -- do not edit
+// 95 glyphs, column spans: 3881 bytes (GFX font: 2634 bytes)
+#pragma once
+#include "../MT_EPD.h"
+
+const uint8_t FreeSans12pt7bSpansSpans[] PROGMEM = {
+    0x02, 0x00, 0x0E, 0x10, 0x02, 0x81, 0x01, 0x00, 0x06, 0x01, 0x00, 0x04, 0x00, 0x81, 0x01, 0x00,
+    0x06, 0x01, 0x00, 0x04, 0x01, 0x09, 0x02, 0x02, 0x04, 0x02, 0x09, 0x02, 0x03, 0x04, 0x02, 0x09,
+    0x02, 0x0D, 0x03, 0x02, 0x04, 0x02, 0x07, 0x09, 0x01, 0x02, 0x0A, 0x02, 0x00, 0x07, 0x09, 0x02,
+    0x03, 0x00, 0x02, 0x04, 0x02, 0x09, 0x02, 0x03, 0x04, 0x02, 0x09, 0x02, 0x0C, 0x04, 0x02, 0x04,
+    0x02, 0x07, 0x09, 0x01, 0x02, 0x09, 0x02, 0x00, 0x06, 0x09, 0x02, 0x03, 0x00, 0x01, 0x04, 0x02,
+    0x09, 0x02, 0x01, 0x04, 0x02, 0x02, 0x03, 0x05, 0x0C, 0x03, 0x02, 0x02, 0x07, 0x0C, 0x05, 0x03,
+    0x02, 0x02, 0x07, 0x02, 0x0F, 0x02, 0x03, 0x01, 0x02, 0x08, 0x02, 0x10, 0x02, 0x81, 0x01, 0x00,
+    0x14, 0x03, 0x01, 0x02, 0x08, 0x02, 0x10, 0x02, 0x03, 0x01, 0x02, 0x09, 0x02, 0x10, 0x02, 0x03,
+    0x02, 0x02, 0x09, 0x02, 0x0F, 0x02, 0x02, 0x02, 0x04, 0x0A, 0x07, 0x02, 0x04, 0x02, 0x0B, 0x04,
+    0x01, 0x03, 0x04, 0x01, 0x02, 0x06, 0x02, 0x01, 0x03, 0x06, 0x03, 0x02, 0x01, 0x02, 0x07, 0x02,
+    0x81, 0x03, 0x01, 0x03, 0x06, 0x03, 0x0F, 0x02, 0x02, 0x02, 0x06, 0x0D, 0x02, 0x02, 0x03, 0x04,
+    0x0B, 0x03, 0x01, 0x09, 0x03, 0x01, 0x07, 0x03, 0x01, 0x06, 0x02, 0x02, 0x04, 0x03, 0x0B, 0x04,
+    0x02, 0x02, 0x03, 0x0A, 0x06, 0x03, 0x00, 0x03, 0x09, 0x03, 0x0E, 0x03, 0x03, 0x00, 0x01, 0x09,
+    0x02, 0x0F, 0x02, 0x02, 0x09, 0x02, 0x0F, 0x02, 0x81, 0x02, 0x09, 0x03, 0x0E, 0x03, 0x01, 0x0A,
+    0x06, 0x01, 0x0B, 0x04, 0x01, 0x0A, 0x05, 0x01, 0x09, 0x07, 0x03, 0x02, 0x04, 0x08, 0x03, 0x0E,
+    0x02, 0x03, 0x01, 0x06, 0x08, 0x02, 0x0F, 0x02, 0x03, 0x00, 0x03, 0x05, 0x04, 0x0F, 0x02, 0x03,
+    0x00, 0x02, 0x06, 0x03, 0x0F, 0x02, 0x03, 0x00, 0x02, 0x06, 0x04, 0x0F, 0x02, 0x04, 0x00, 0x03,
+    0x05, 0x02, 0x09, 0x03, 0x0E, 0x02, 0x02, 0x01, 0x06, 0x0A, 0x06, 0x02, 0x02, 0x04, 0x0B, 0x04,
+    0x01, 0x0B, 0x04, 0x01, 0x09, 0x08, 0x02, 0x09, 0x02, 0x0E, 0x03, 0x01, 0x10, 0x01, 0x01, 0x00,
+    0x06, 0x01, 0x00, 0x04, 0x01, 0x07, 0x08, 0x01, 0x04, 0x0E, 0x02, 0x02, 0x05, 0x10, 0x04, 0x02,
+    0x01, 0x03, 0x13, 0x03, 0x02, 0x00, 0x01, 0x15, 0x02, 0x02, 0x00, 0x01, 0x15, 0x02, 0x02, 0x01,
+    0x03, 0x13, 0x03, 0x02, 0x02, 0x05, 0x10, 0x04, 0x01, 0x04, 0x0E, 0x01, 0x07, 0x08, 0x01, 0x02,
+    0x01, 0x02, 0x02, 0x02, 0x05, 0x02, 0x01, 0x03, 0x03, 0x01, 0x00, 0x05, 0x01, 0x03, 0x03, 0x02,
+    0x02, 0x02, 0x05, 0x02, 0x01, 0x02, 0x01, 0x01, 0x04, 0x02, 0x83, 0x01, 0x00, 0x0B, 0x81, 0x01,
+    0x04, 0x02, 0x83, 0x02, 0x00, 0x02, 0x05, 0x01, 0x01, 0x00, 0x05, 0x01, 0x00, 0x02, 0x85, 0x01,
+    0x00, 0x02, 0x81, 0x01, 0x10, 0x02, 0x01, 0x0D, 0x04, 0x01, 0x0A, 0x04, 0x01, 0x07, 0x04, 0x01,
+    0x04, 0x04, 0x01, 0x01, 0x04, 0x01, 0x00, 0x02, 0x01, 0x04, 0x09, 0x01, 0x02, 0x0D, 0x02, 0x01,
+    0x04, 0x0D, 0x03, 0x02, 0x00, 0x03, 0x0E, 0x03, 0x02, 0x00, 0x02, 0x0F, 0x02, 0x82, 0x02, 0x00,
+    0x03, 0x0E, 0x03, 0x02, 0x01, 0x04, 0x0C, 0x04, 0x01, 0x02, 0x0D, 0x01, 0x04, 0x09, 0x01, 0x03,
+    0x02, 0x81, 0x01, 0x02, 0x03, 0x01, 0x01, 0x10, 0x01, 0x00, 0x11, 0x02, 0x03, 0x02, 0x0E, 0x03,
+    0x02, 0x01, 0x04, 0x0C, 0x05, 0x03, 0x01, 0x02, 0x0B, 0x02, 0x0F, 0x02, 0x03, 0x00, 0x02, 0x0A,
+    0x02, 0x0F, 0x02, 0x81, 0x03, 0x00, 0x02, 0x09, 0x02, 0x0F, 0x02, 0x81, 0x03, 0x00, 0x03, 0x08,
+    0x02, 0x0F, 0x02, 0x03, 0x01, 0x03, 0x07, 0x03, 0x0F, 0x02, 0x02, 0x01, 0x08, 0x0F, 0x02, 0x02,
+    0x03, 0x05, 0x0F, 0x02, 0x02, 0x02, 0x03, 0x0C, 0x02, 0x02, 0x01, 0x04, 0x0C, 0x04, 0x02, 0x00,
+    0x03, 0x0E, 0x02, 0x02, 0x00, 0x02, 0x0F, 0x02, 0x03, 0x00, 0x02, 0x07, 0x02, 0x0F, 0x02, 0x82,
+    0x03, 0x00, 0x03, 0x06, 0x03, 0x0E, 0x03, 0x02, 0x01, 0x09, 0x0E, 0x02, 0x02, 0x02, 0x05, 0x09,
+    0x06, 0x01, 0x0A, 0x04, 0x01, 0x0A, 0x03, 0x01, 0x09, 0x04, 0x02, 0x07, 0x03, 0x0B, 0x02, 0x02,
+    0x06, 0x02, 0x0B, 0x02, 0x02, 0x04, 0x03, 0x0B, 0x02, 0x02, 0x03, 0x03, 0x0B, 0x02, 0x02, 0x01,
+    0x03, 0x0B, 0x02, 0x01, 0x00, 0x11, 0x81, 0x01, 0x0B, 0x02, 0x81, 0x02, 0x07, 0x01, 0x0D, 0x02,
+    0x02, 0x01, 0x07, 0x0D, 0x03, 0x02, 0x00, 0x08, 0x0E, 0x02, 0x03, 0x00, 0x02, 0x06, 0x01, 0x0F,
+    0x02, 0x03, 0x00, 0x02, 0x05, 0x02, 0x0F, 0x02, 0x82, 0x03, 0x00, 0x02, 0x05, 0x03, 0x0E, 0x03,
+    0x03, 0x00, 0x02, 0x06, 0x03, 0x0D, 0x03, 0x02, 0x00, 0x02, 0x07, 0x08, 0x01, 0x08, 0x06, 0x01,
+    0x05, 0x08, 0x01, 0x02, 0x0D, 0x03, 0x01, 0x03, 0x07, 0x03, 0x0D, 0x03, 0x03, 0x01, 0x02, 0x07,
+    0x02, 0x0E, 0x03, 0x03, 0x00, 0x02, 0x06, 0x02, 0x0F, 0x02, 0x82, 0x03, 0x00, 0x02, 0x06, 0x02,
+    0x0E, 0x03, 0x03, 0x01, 0x03, 0x07, 0x03, 0x0D, 0x03, 0x02, 0x01, 0x03, 0x07, 0x08, 0x02, 0x03,
+    0x01, 0x09, 0x05, 0x01, 0x00, 0x02, 0x81, 0x02, 0x00, 0x02, 0x0F, 0x02, 0x02, 0x00, 0x02, 0x0C,
+    0x05, 0x02, 0x00, 0x02, 0x09, 0x06, 0x02, 0x00, 0x02, 0x07, 0x04, 0x02, 0x00, 0x02, 0x06, 0x03,
+    0x02, 0x00, 0x02, 0x04, 0x03, 0x02, 0x00, 0x02, 0x03, 0x02, 0x01, 0x00, 0x04, 0x01, 0x00, 0x02,
+    0x01, 0x0A, 0x04, 0x02, 0x02, 0x04, 0x09, 0x06, 0x02, 0x01, 0x09, 0x0E, 0x02, 0x03, 0x00, 0x03,
+    0x06, 0x04, 0x0F, 0x02, 0x03, 0x00, 0x02, 0x07, 0x02, 0x0F, 0x02, 0x82, 0x03, 0x00, 0x03, 0x06,
+    0x04, 0x0F, 0x02, 0x02, 0x01, 0x09, 0x0E, 0x02, 0x02, 0x02, 0x04, 0x09, 0x06, 0x01, 0x0A, 0x04,
+    0x02, 0x03, 0x05, 0x0D, 0x01, 0x02, 0x02, 0x08, 0x0D, 0x03, 0x03, 0x01, 0x03, 0x08, 0x02, 0x0E,
+    0x02, 0x03, 0x00, 0x03, 0x09, 0x02, 0x0F, 0x02, 0x03, 0x00, 0x02, 0x09, 0x02, 0x0F, 0x02, 0x82,
+    0x03, 0x00, 0x03, 0x08, 0x02, 0x0E, 0x02, 0x03, 0x01, 0x03, 0x07, 0x03, 0x0D, 0x03, 0x01, 0x02,
+    0x0D, 0x01, 0x04, 0x08, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x81, 0x03, 0x00, 0x02, 0x0A, 0x02, 0x0F,
+    0x01, 0x02, 0x00, 0x02, 0x0A, 0x05, 0x01, 0x05, 0x02, 0x01, 0x05, 0x03, 0x01, 0x04, 0x04, 0x02,
+    0x04, 0x02, 0x07, 0x01, 0x02, 0x03, 0x02, 0x07, 0x02, 0x81, 0x02, 0x03, 0x01, 0x08, 0x02, 0x02,
+    0x02, 0x02, 0x08, 0x02, 0x02, 0x02, 0x02, 0x09, 0x02, 0x02, 0x01, 0x02, 0x09, 0x02, 0x02, 0x01,
+    0x02, 0x0A, 0x01, 0x02, 0x01, 0x01, 0x0A, 0x02, 0x02, 0x00, 0x02, 0x04, 0x02, 0x8B, 0x02, 0x01,
+    0x01, 0x0A, 0x02, 0x02, 0x01, 0x02, 0x0A, 0x01, 0x02, 0x01, 0x02, 0x09, 0x02, 0x02, 0x02, 0x02,
+    0x09, 0x02, 0x02, 0x02, 0x02, 0x08, 0x02, 0x02, 0x03, 0x02, 0x08, 0x02, 0x02, 0x03, 0x02, 0x08,
+    0x01, 0x02, 0x03, 0x02, 0x07, 0x02, 0x02, 0x04, 0x02, 0x07, 0x01, 0x01, 0x04, 0x04, 0x01, 0x05,
+    0x03, 0x01, 0x05, 0x02, 0x01, 0x02, 0x03, 0x01, 0x01, 0x04, 0x01, 0x01, 0x02, 0x01, 0x00, 0x02,
+    0x03, 0x00, 0x02, 0x0A, 0x04, 0x10, 0x02, 0x03, 0x00, 0x02, 0x09, 0x05, 0x10, 0x02, 0x02, 0x00,
+    0x02, 0x08, 0x03, 0x02, 0x00, 0x03, 0x07, 0x03, 0x01, 0x01, 0x08, 0x01, 0x03, 0x04, 0x01, 0x08,
+    0x07, 0x01, 0x06, 0x0B, 0x02, 0x04, 0x04, 0x0E, 0x04, 0x02, 0x03, 0x03, 0x10, 0x03, 0x02, 0x02,
+    0x03, 0x11, 0x02, 0x03, 0x02, 0x02, 0x09, 0x06, 0x12, 0x02, 0x03, 0x01, 0x02, 0x08, 0x08, 0x12,
+    0x02, 0x04, 0x01, 0x02, 0x07, 0x03, 0x0E, 0x03, 0x13, 0x02, 0x04, 0x00, 0x02, 0x06, 0x02, 0x0F,
+    0x02, 0x13, 0x02, 0x04, 0x00, 0x02, 0x05, 0x02, 0x0F, 0x02, 0x13, 0x02, 0x81, 0x04, 0x00, 0x02,
+    0x05, 0x02, 0x0E, 0x02, 0x13, 0x02, 0x04, 0x00, 0x02, 0x05, 0x02, 0x0D, 0x02, 0x13, 0x02, 0x03,
+    0x00, 0x02, 0x06, 0x0B, 0x13, 0x02, 0x03, 0x00, 0x03, 0x07, 0x0A, 0x13, 0x01, 0x04, 0x01, 0x02,
+    0x06, 0x04, 0x0F, 0x02, 0x13, 0x01, 0x03, 0x01, 0x03, 0x06, 0x01, 0x0F, 0x02, 0x02, 0x02, 0x02,
+    0x0E, 0x03, 0x02, 0x02, 0x03, 0x0D, 0x03, 0x02, 0x03, 0x04, 0x0C, 0x03, 0x01, 0x05, 0x09, 0x01,
+    0x06, 0x06, 0x00, 0x01, 0x0F, 0x03, 0x01, 0x0C, 0x06, 0x01, 0x09, 0x07, 0x01, 0x06, 0x07, 0x02,
+    0x03, 0x07, 0x0B, 0x02, 0x02, 0x00, 0x07, 0x0B, 0x02, 0x02, 0x00, 0x04, 0x0B, 0x02, 0x81, 0x02,
+    0x00, 0x07, 0x0B, 0x02, 0x02, 0x03, 0x07, 0x0B, 0x02, 0x01, 0x06, 0x08, 0x01, 0x09, 0x07, 0x01,
+    0x0C, 0x06, 0x01, 0x0F, 0x03, 0x00, 0x01, 0x00, 0x12, 0x81, 0x03, 0x00, 0x02, 0x08, 0x02, 0x10,
+    0x02, 0x86, 0x03, 0x00, 0x03, 0x07, 0x03, 0x10, 0x02, 0x03, 0x01, 0x07, 0x09, 0x02, 0x0F, 0x02,
+    0x02, 0x03, 0x04, 0x0A, 0x07, 0x01, 0x0B, 0x04, 0x01, 0x06, 0x06, 0x01, 0x03, 0x0C, 0x02, 0x02,
+    0x04, 0x0C, 0x04, 0x02, 0x01, 0x03, 0x0E, 0x03, 0x02, 0x01, 0x02, 0x0F, 0x02, 0x02, 0x00, 0x02,
+    0x0F, 0x03, 0x02, 0x00, 0x02, 0x10, 0x02, 0x84, 0x02, 0x01, 0x02, 0x0F, 0x02, 0x02, 0x01, 0x03,
+    0x0E, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x04, 0x02, 0x04, 0x01, 0x0C, 0x02, 0x01, 0x00, 0x12, 0x81,
+    0x02, 0x00, 0x02, 0x10, 0x02, 0x86, 0x02, 0x01, 0x02, 0x0F, 0x03, 0x02, 0x01, 0x03, 0x0E, 0x03,
+    0x02, 0x02, 0x04, 0x0C, 0x04, 0x01, 0x03, 0x0C, 0x01, 0x05, 0x08, 0x01, 0x00, 0x12, 0x81, 0x03,
+    0x00, 0x02, 0x08, 0x02, 0x10, 0x02, 0x88, 0x02, 0x00, 0x02, 0x10, 0x02, 0x01, 0x00, 0x12, 0x81,
+    0x02, 0x00, 0x02, 0x08, 0x02, 0x87, 0x01, 0x00, 0x02, 0x01, 0x05, 0x07, 0x01, 0x03, 0x0B, 0x02,
+    0x02, 0x04, 0x0C, 0x04, 0x02, 0x01, 0x03, 0x0E, 0x03, 0x02, 0x01, 0x02, 0x0F, 0x02, 0x02, 0x00,
+    0x03, 0x0F, 0x03, 0x02, 0x00, 0x02, 0x10, 0x02, 0x82, 0x03, 0x00, 0x02, 0x08, 0x02, 0x10, 0x02,
+    0x81, 0x03, 0x00, 0x03, 0x08, 0x02, 0x0F, 0x02, 0x03, 0x01, 0x02, 0x08, 0x02, 0x0E, 0x03, 0x03,
+    0x01, 0x03, 0x08, 0x02, 0x0D, 0x03, 0x02, 0x02, 0x03, 0x08, 0x09, 0x02, 0x04, 0x01, 0x08, 0x0A,
+    0x01, 0x00, 0x12, 0x81, 0x01, 0x08, 0x02, 0x88, 0x01, 0x00, 0x12, 0x81, 0x01, 0x00, 0x12, 0x81,
+    0x01, 0x0C, 0x04, 0x01, 0x0C, 0x05, 0x01, 0x0F, 0x03, 0x01, 0x10, 0x02, 0x82, 0x01, 0x0F, 0x03,
+    0x01, 0x00, 0x11, 0x01, 0x00, 0x10, 0x01, 0x00, 0x12, 0x81, 0x01, 0x09, 0x02, 0x01, 0x08, 0x02,
+    0x01, 0x06, 0x03, 0x01, 0x05, 0x05, 0x01, 0x04, 0x07, 0x02, 0x03, 0x03, 0x09, 0x04, 0x02, 0x02,
+    0x03, 0x0A, 0x04, 0x02, 0x01, 0x03, 0x0C, 0x04, 0x02, 0x00, 0x03, 0x0D, 0x04, 0x02, 0x00, 0x02,
+    0x0F, 0x03, 0x02, 0x00, 0x01, 0x10, 0x02, 0x00, 0x01, 0x00, 0x12, 0x81, 0x01, 0x10, 0x02, 0x87,
+    0x01, 0x00, 0x12, 0x81, 0x01, 0x00, 0x04, 0x01, 0x02, 0x06, 0x01, 0x05, 0x06, 0x01, 0x08, 0x06,
+    0x01, 0x0B, 0x06, 0x01, 0x0E, 0x04, 0x81, 0x01, 0x0B, 0x06, 0x01, 0x08, 0x06, 0x01, 0x05, 0x06,
+    0x01, 0x02, 0x06, 0x01, 0x00, 0x05, 0x01, 0x00, 0x12, 0x81, 0x01, 0x00, 0x12, 0x81, 0x01, 0x00,
+    0x04, 0x01, 0x02, 0x04, 0x01, 0x04, 0x04, 0x01, 0x05, 0x04, 0x01, 0x07, 0x04, 0x01, 0x09, 0x04,
+    0x01, 0x0A, 0x04, 0x01, 0x0C, 0x04, 0x01, 0x0E, 0x04, 0x01, 0x00, 0x12, 0x81, 0x01, 0x06, 0x06,
+    0x01, 0x04, 0x0A, 0x02, 0x02, 0x04, 0x0C, 0x04, 0x02, 0x01, 0x03, 0x0E, 0x03, 0x02, 0x01, 0x02,
+    0x0F, 0x02, 0x02, 0x01, 0x02, 0x0F, 0x03, 0x02, 0x00, 0x02, 0x10, 0x02, 0x84, 0x02, 0x01, 0x02,
+    0x0F, 0x03, 0x02, 0x01, 0x02, 0x0F, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x03, 0x02, 0x02, 0x04, 0x0C,
+    0x04, 0x01, 0x04, 0x0A, 0x01, 0x06, 0x06, 0x01, 0x00, 0x12, 0x81, 0x02, 0x00, 0x02, 0x08, 0x02,
+    0x86, 0x02, 0x01, 0x02, 0x07, 0x03, 0x01, 0x01, 0x08, 0x01, 0x03, 0x05, 0x01, 0x06, 0x06, 0x01,
+    0x04, 0x0A, 0x02, 0x02, 0x04, 0x0C, 0x04, 0x02, 0x01, 0x03, 0x0E, 0x03, 0x02, 0x01, 0x02, 0x0F,
+    0x02, 0x02, 0x01, 0x02, 0x0F, 0x03, 0x02, 0x00, 0x02, 0x10, 0x02, 0x83, 0x03, 0x00, 0x02, 0x0D,
+    0x02, 0x10, 0x02, 0x02, 0x01, 0x02, 0x0D, 0x05, 0x02, 0x01, 0x02, 0x0E, 0x03, 0x02, 0x02, 0x02,
+    0x0E, 0x03, 0x02, 0x02, 0x04, 0x0C, 0x06, 0x02, 0x04, 0x0B, 0x10, 0x03, 0x01, 0x06, 0x06, 0x01,
+    0x00, 0x12, 0x81, 0x02, 0x00, 0x02, 0x08, 0x02, 0x87, 0x02, 0x01, 0x02, 0x07, 0x04, 0x02, 0x01,
+    0x07, 0x09, 0x09, 0x02, 0x02, 0x05, 0x0A, 0x08, 0x01, 0x11, 0x01, 0x01, 0x0C, 0x03, 0x02, 0x03,
+    0x05, 0x0C, 0x04, 0x02, 0x02, 0x07, 0x0E, 0x03, 0x03, 0x01, 0x03, 0x07, 0x02, 0x0F, 0x02, 0x03,
+    0x00, 0x03, 0x07, 0x03, 0x0F, 0x03, 0x03, 0x00, 0x02, 0x08, 0x02, 0x10, 0x02, 0x82, 0x03, 0x00,
+    0x02, 0x08, 0x03, 0x10, 0x02, 0x03, 0x00, 0x02, 0x09, 0x02, 0x10, 0x02, 0x03, 0x00, 0x03, 0x09,
+    0x02, 0x0F, 0x03, 0x03, 0x01, 0x03, 0x09, 0x03, 0x0F, 0x02, 0x02, 0x02, 0x03, 0x0A, 0x06, 0x02,
+    0x03, 0x02, 0x0B, 0x04, 0x01, 0x00, 0x02, 0x84, 0x01, 0x00, 0x12, 0x81, 0x01, 0x00, 0x02, 0x84,
+    0x01, 0x00, 0x0F, 0x01, 0x00, 0x10, 0x01, 0x0E, 0x03, 0x01, 0x0F, 0x02, 0x01, 0x10, 0x02, 0x84,
+    0x01, 0x0F, 0x02, 0x01, 0x0E, 0x03, 0x01, 0x00, 0x10, 0x01, 0x00, 0x0F, 0x00, 0x01, 0x00, 0x03,
+    0x01, 0x00, 0x06, 0x01, 0x02, 0x07, 0x01, 0x05, 0x07, 0x01, 0x08, 0x07, 0x01, 0x0B, 0x07, 0x01,
+    0x0E, 0x04, 0x01, 0x0D, 0x05, 0x01, 0x0A, 0x07, 0x01, 0x07, 0x07, 0x01, 0x04, 0x07, 0x01, 0x01,
+    0x07, 0x01, 0x00, 0x05, 0x01, 0x00, 0x02, 0x01, 0x00, 0x01, 0x01, 0x00, 0x05, 0x01, 0x00, 0x09,
+    0x01, 0x04, 0x09, 0x01, 0x08, 0x09, 0x01, 0x0C, 0x06, 0x01, 0x0D, 0x05, 0x01, 0x09, 0x08, 0x01,
+    0x06, 0x07, 0x01, 0x02, 0x08, 0x01, 0x00, 0x06, 0x01, 0x00, 0x05, 0x01, 0x01, 0x07, 0x01, 0x04,
+    0x08, 0x01, 0x08, 0x07, 0x01, 0x0B, 0x07, 0x01, 0x0E, 0x04, 0x01, 0x0A, 0x08, 0x01, 0x05, 0x0A,
+    0x01, 0x00, 0x0B, 0x01, 0x00, 0x07, 0x01, 0x00, 0x03, 0x00, 0x02, 0x00, 0x01, 0x10, 0x02, 0x02,
+    0x00, 0x03, 0x0F, 0x03, 0x02, 0x00, 0x04, 0x0D, 0x04, 0x02, 0x02, 0x04, 0x0C, 0x04, 0x02, 0x03,
+    0x04, 0x0A, 0x04, 0x01, 0x05, 0x08, 0x01, 0x06, 0x05, 0x81, 0x02, 0x05, 0x03, 0x09, 0x04, 0x02,
+    0x03, 0x04, 0x0B, 0x04, 0x02, 0x01, 0x04, 0x0C, 0x04, 0x02, 0x00, 0x04, 0x0E, 0x04, 0x02, 0x00,
+    0x02, 0x0F, 0x03, 0x02, 0x00, 0x01, 0x11, 0x01, 0x00, 0x01, 0x00, 0x02, 0x01, 0x00, 0x04, 0x01,
+    0x01, 0x04, 0x01, 0x03, 0x04, 0x01, 0x04, 0x04, 0x01, 0x06, 0x04, 0x01, 0x08, 0x0A, 0x81, 0x01,
+    0x06, 0x04, 0x01, 0x04, 0x04, 0x01, 0x02, 0x05, 0x01, 0x01, 0x04, 0x01, 0x00, 0x03, 0x01, 0x00,
+    0x02, 0x00, 0x02, 0x00, 0x02, 0x0F, 0x03, 0x02, 0x00, 0x02, 0x0E, 0x04, 0x02, 0x00, 0x02, 0x0C,
+    0x06, 0x03, 0x00, 0x02, 0x0B, 0x04, 0x10, 0x02, 0x03, 0x00, 0x02, 0x0A, 0x03, 0x10, 0x02, 0x03,
+    0x00, 0x02, 0x08, 0x04, 0x10, 0x02, 0x03, 0x00, 0x02, 0x07, 0x04, 0x10, 0x02, 0x03, 0x00, 0x02,
+    0x06, 0x03, 0x10, 0x02, 0x03, 0x00, 0x02, 0x04, 0x04, 0x10, 0x02, 0x03, 0x00, 0x02, 0x03, 0x04,
+    0x10, 0x02, 0x02, 0x00, 0x05, 0x10, 0x02, 0x02, 0x00, 0x04, 0x10, 0x02, 0x02, 0x00, 0x03, 0x10,
+    0x02, 0x01, 0x00, 0x17, 0x81, 0x02, 0x00, 0x02, 0x15, 0x02, 0x81, 0x01, 0x00, 0x02, 0x01, 0x01,
+    0x04, 0x01, 0x04, 0x04, 0x01, 0x07, 0x04, 0x01, 0x0A, 0x04, 0x01, 0x0D, 0x04, 0x01, 0x10, 0x02,
+    0x02, 0x00, 0x02, 0x15, 0x02, 0x81, 0x01, 0x00, 0x17, 0x81, 0x01, 0x08, 0x01, 0x01, 0x06, 0x03,
+    0x01, 0x03, 0x04, 0x01, 0x01, 0x04, 0x01, 0x00, 0x02, 0x01, 0x00, 0x04, 0x01, 0x02, 0x05, 0x01,
+    0x05, 0x04, 0x01, 0x07, 0x02, 0x01, 0x00, 0x01, 0x8E, 0x01, 0x00, 0x01, 0x01, 0x00, 0x02, 0x01,
+    0x00, 0x03, 0x01, 0x01, 0x03, 0x01, 0x03, 0x01, 0x02, 0x02, 0x02, 0x07, 0x04, 0x02, 0x01, 0x03,
+    0x07, 0x05, 0x03, 0x00, 0x03, 0x06, 0x02, 0x0A, 0x03, 0x03, 0x00, 0x02, 0x06, 0x02, 0x0B, 0x02,
+    0x81, 0x03, 0x00, 0x02, 0x06, 0x01, 0x0B, 0x02, 0x03, 0x00, 0x02, 0x06, 0x01, 0x0A, 0x02, 0x03,
+    0x00, 0x03, 0x05, 0x02, 0x0A, 0x01, 0x01, 0x01, 0x0B, 0x01, 0x02, 0x0B, 0x01, 0x0B, 0x02, 0x81,
+    0x01, 0x00, 0x12, 0x81, 0x02, 0x07, 0x02, 0x0E, 0x02, 0x02, 0x06, 0x02, 0x0F, 0x02, 0x02, 0x05,
+    0x02, 0x10, 0x02, 0x83, 0x02, 0x05, 0x03, 0x0F, 0x03, 0x02, 0x06, 0x03, 0x0E, 0x03, 0x01, 0x07,
+    0x09, 0x01, 0x08, 0x06, 0x01, 0x03, 0x07, 0x01, 0x02, 0x09, 0x02, 0x01, 0x03, 0x09, 0x03, 0x02,
+    0x00, 0x03, 0x0A, 0x03, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x82, 0x02, 0x00, 0x03, 0x0A, 0x03, 0x02,
+    0x01, 0x03, 0x09, 0x03, 0x02, 0x03, 0x01, 0x09, 0x02, 0x01, 0x08, 0x07, 0x01, 0x07, 0x09, 0x02,
+    0x06, 0x03, 0x0E, 0x03, 0x02, 0x05, 0x03, 0x0F, 0x03, 0x02, 0x05, 0x02, 0x10, 0x02, 0x82, 0x02,
+    0x06, 0x02, 0x0F, 0x02, 0x02, 0x06, 0x03, 0x0E, 0x02, 0x01, 0x00, 0x12, 0x81, 0x01, 0x03, 0x07,
+    0x01, 0x02, 0x09, 0x03, 0x01, 0x03, 0x05, 0x02, 0x09, 0x03, 0x03, 0x00, 0x03, 0x05, 0x02, 0x0A,
+    0x03, 0x03, 0x00, 0x02, 0x05, 0x02, 0x0B, 0x02, 0x82, 0x03, 0x00, 0x03, 0x05, 0x02, 0x0B, 0x02,
+    0x03, 0x01, 0x02, 0x05, 0x02, 0x0A, 0x02, 0x02, 0x02, 0x05, 0x09, 0x03, 0x02, 0x03, 0x04, 0x09,
+    0x01, 0x01, 0x05, 0x02, 0x01, 0x01, 0x11, 0x01, 0x00, 0x12, 0x02, 0x00, 0x02, 0x05, 0x02, 0x81,
+    0x02, 0x03, 0x07, 0x0F, 0x01, 0x02, 0x02, 0x09, 0x0F, 0x02, 0x03, 0x01, 0x03, 0x09, 0x03, 0x10,
+    0x02, 0x03, 0x00, 0x03, 0x0A, 0x03, 0x10, 0x02, 0x03, 0x00, 0x02, 0x0B, 0x02, 0x10, 0x02, 0x82,
+    0x03, 0x01, 0x02, 0x0A, 0x02, 0x0F, 0x03, 0x03, 0x01, 0x03, 0x09, 0x02, 0x0E, 0x03, 0x01, 0x00,
+    0x11, 0x01, 0x00, 0x0F, 0x01, 0x00, 0x12, 0x81, 0x01, 0x07, 0x02, 0x01, 0x06, 0x02, 0x01, 0x05,
+    0x02, 0x82, 0x01, 0x05, 0x03, 0x01, 0x06, 0x0C, 0x01, 0x07, 0x0B, 0x02, 0x00, 0x02, 0x05, 0x0D,
+    0x81, 0x01, 0x15, 0x02, 0x81, 0x02, 0x00, 0x02, 0x05, 0x12, 0x02, 0x00, 0x02, 0x05, 0x11, 0x01,
+    0x00, 0x12, 0x81, 0x01, 0x0A, 0x02, 0x01, 0x09, 0x02, 0x01, 0x08, 0x04, 0x01, 0x07, 0x07, 0x02,
+    0x06, 0x02, 0x0B, 0x04, 0x02, 0x05, 0x02, 0x0D, 0x04, 0x02, 0x05, 0x01, 0x0E, 0x04, 0x01, 0x10,
+    0x02, 0x00, 0x01, 0x00, 0x12, 0x81, 0x01, 0x00, 0x0D, 0x81, 0x01, 0x02, 0x02, 0x01, 0x01, 0x02,
+    0x01, 0x00, 0x02, 0x82, 0x01, 0x00, 0x03, 0x01, 0x01, 0x0C, 0x01, 0x02, 0x0B, 0x01, 0x01, 0x02,
+    0x01, 0x00, 0x02, 0x82, 0x01, 0x00, 0x03, 0x01, 0x00, 0x0D, 0x01, 0x01, 0x0C, 0x01, 0x00, 0x0D,
+    0x81, 0x01, 0x02, 0x02, 0x01, 0x01, 0x02, 0x01, 0x00, 0x02, 0x82, 0x01, 0x00, 0x03, 0x01, 0x01,
+    0x0C, 0x01, 0x02, 0x0B, 0x01, 0x03, 0x07, 0x01, 0x02, 0x09, 0x02, 0x01, 0x03, 0x09, 0x03, 0x02,
+    0x00, 0x03, 0x0A, 0x03, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x82, 0x02, 0x00, 0x03, 0x0A, 0x03, 0x02,
+    0x01, 0x03, 0x09, 0x03, 0x01, 0x02, 0x09, 0x01, 0x03, 0x07, 0x01, 0x00, 0x11, 0x81, 0x02, 0x02,
+    0x02, 0x09, 0x03, 0x02, 0x01, 0x02, 0x0A, 0x02, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x83, 0x02, 0x00,
+    0x03, 0x0A, 0x03, 0x02, 0x01, 0x03, 0x09, 0x03, 0x01, 0x02, 0x09, 0x01, 0x04, 0x06, 0x01, 0x03,
+    0x07, 0x01, 0x02, 0x09, 0x02, 0x01, 0x03, 0x09, 0x03, 0x02, 0x00, 0x03, 0x0A, 0x03, 0x02, 0x00,
+    0x02, 0x0B, 0x02, 0x82, 0x02, 0x01, 0x02, 0x0A, 0x02, 0x02, 0x01, 0x03, 0x09, 0x03, 0x01, 0x00,
+    0x11, 0x81, 0x01, 0x00, 0x0D, 0x81, 0x01, 0x02, 0x02, 0x01, 0x01, 0x02, 0x01, 0x00, 0x02, 0x81,
+    0x02, 0x02, 0x04, 0x09, 0x02, 0x02, 0x01, 0x06, 0x09, 0x03, 0x03, 0x00, 0x03, 0x05, 0x02, 0x0A,
+    0x03, 0x03, 0x00, 0x02, 0x05, 0x02, 0x0B, 0x02, 0x03, 0x00, 0x02, 0x06, 0x02, 0x0B, 0x02, 0x82,
+    0x03, 0x01, 0x02, 0x06, 0x03, 0x0A, 0x02, 0x02, 0x01, 0x02, 0x07, 0x05, 0x01, 0x08, 0x03, 0x01,
+    0x03, 0x02, 0x01, 0x00, 0x0F, 0x01, 0x00, 0x10, 0x02, 0x03, 0x02, 0x0E, 0x02, 0x81, 0x01, 0x00,
+    0x0B, 0x01, 0x00, 0x0C, 0x01, 0x0A, 0x03, 0x01, 0x0B, 0x02, 0x82, 0x01, 0x0A, 0x02, 0x01, 0x09,
+    0x02, 0x01, 0x00, 0x0D, 0x81, 0x01, 0x00, 0x01, 0x01, 0x00, 0x04, 0x01, 0x00, 0x07, 0x01, 0x03,
+    0x07, 0x01, 0x06, 0x07, 0x01, 0x09, 0x04, 0x81, 0x01, 0x06, 0x05, 0x01, 0x03, 0x06, 0x01, 0x00,
+    0x06, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x01, 0x01, 0x00, 0x05, 0x01, 0x01, 0x07, 0x01, 0x05,
+    0x07, 0x01, 0x09, 0x04, 0x01, 0x08, 0x05, 0x01, 0x04, 0x07, 0x01, 0x00, 0x07, 0x01, 0x00, 0x03,
+    0x01, 0x00, 0x07, 0x01, 0x03, 0x08, 0x01, 0x07, 0x06, 0x01, 0x0A, 0x03, 0x01, 0x06, 0x07, 0x01,
+    0x01, 0x08, 0x01, 0x00, 0x06, 0x01, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x02, 0x00,
+    0x03, 0x0A, 0x03, 0x02, 0x01, 0x04, 0x08, 0x03, 0x02, 0x03, 0x03, 0x07, 0x03, 0x01, 0x04, 0x04,
+    0x01, 0x04, 0x05, 0x02, 0x02, 0x03, 0x07, 0x04, 0x02, 0x00, 0x04, 0x09, 0x03, 0x02, 0x00, 0x02,
+    0x0A, 0x03, 0x02, 0x00, 0x01, 0x0C, 0x01, 0x01, 0x00, 0x01, 0x02, 0x00, 0x04, 0x10, 0x02, 0x02,
+    0x00, 0x07, 0x10, 0x02, 0x02, 0x03, 0x07, 0x0F, 0x03, 0x01, 0x06, 0x0B, 0x01, 0x0A, 0x06, 0x01,
+    0x08, 0x05, 0x01, 0x05, 0x06, 0x01, 0x02, 0x06, 0x01, 0x00, 0x05, 0x01, 0x00, 0x02, 0x02, 0x00,
+    0x02, 0x0A, 0x03, 0x02, 0x00, 0x02, 0x09, 0x04, 0x02, 0x00, 0x02, 0x08, 0x05, 0x03, 0x00, 0x02,
+    0x06, 0x03, 0x0B, 0x02, 0x03, 0x00, 0x02, 0x05, 0x03, 0x0B, 0x02, 0x03, 0x00, 0x02, 0x04, 0x03,
+    0x0B, 0x02, 0x03, 0x00, 0x02, 0x03, 0x03, 0x0B, 0x02, 0x02, 0x00, 0x05, 0x0B, 0x02, 0x02, 0x00,
+    0x03, 0x0B, 0x02, 0x02, 0x00, 0x02, 0x0B, 0x02, 0x01, 0x0B, 0x01, 0x01, 0x0A, 0x03, 0x02, 0x01,
+    0x0A, 0x0C, 0x0A, 0x02, 0x00, 0x0A, 0x0D, 0x0A, 0x02, 0x00, 0x02, 0x15, 0x02, 0x01, 0x00, 0x17,
+    0x81, 0x02, 0x00, 0x02, 0x15, 0x02, 0x02, 0x00, 0x0A, 0x0D, 0x0A, 0x02, 0x01, 0x0A, 0x0C, 0x0A,
+    0x01, 0x0A, 0x03, 0x01, 0x0B, 0x01, 0x01, 0x01, 0x02, 0x01, 0x00, 0x02, 0x81, 0x01, 0x00, 0x03,
+    0x01, 0x01, 0x02, 0x01, 0x02, 0x02, 0x01, 0x02, 0x03, 0x01, 0x03, 0x02, 0x81, 0x01, 0x02, 0x02
+};
+
+const SpanGlyph FreeSans12pt7bSpansGlyphs[] PROGMEM = {
+    {0, 0, 0, 6, 0, 1},  // 0x20 ' '
+    {0, 2, 18, 8, 3, -17},  // 0x21 '!'
+    {6, 6, 6, 8, 1, -16},  // 0x22 '"'
+    {20, 13, 16, 13, 0, -15},  // 0x23 '#'
+    {85, 11, 20, 13, 1, -17},  // 0x24 '$'
+    {144, 20, 17, 21, 1, -16},  // 0x25 '%'
+    {228, 14, 17, 16, 1, -16},  // 0x26 '&'
+    {302, 2, 6, 5, 1, -16},  // 0x27 'quote'
+    {308, 5, 23, 8, 2, -17},  // 0x28 '('
+    {329, 5, 23, 8, 1, -17},  // 0x29 ')'
+    {350, 7, 7, 9, 1, -17},  // 0x2A '*'
+    {375, 10, 11, 14, 2, -10},  // 0x2B '+'
+    {387, 2, 6, 7, 2, -1},  // 0x2C ','
+    {395, 6, 2, 8, 1, -7},  // 0x2D '-'
+    {399, 2, 2, 6, 2, -1},  // 0x2E '.'
+    {403, 7, 18, 7, 0, -17},  // 0x2F '/'
+    {424, 11, 17, 13, 1, -16},  // 0x30 '0'
+    {462, 5, 17, 13, 3, -16},  // 0x31 '1'
+    {475, 11, 17, 13, 1, -16},  // 0x32 '2'
+    {532, 11, 17, 13, 1, -16},  // 0x33 '3'
+    {580, 11, 17, 13, 1, -16},  // 0x34 '4'
+    {619, 11, 17, 13, 1, -16},  // 0x35 '5'
+    {671, 11, 17, 13, 1, -16},  // 0x36 '6'
+    {723, 11, 17, 13, 1, -16},  // 0x37 '7'
+    {768, 11, 17, 13, 1, -16},  // 0x38 '8'
+    {816, 11, 17, 13, 1, -16},  // 0x39 '9'
+    {868, 2, 13, 6, 2, -12},  // 0x3A ':'
+    {874, 2, 16, 6, 2, -11},  // 0x3B ';'
+    {886, 12, 12, 14, 1, -11},  // 0x3C '<'
+    {936, 12, 6, 14, 1, -8},  // 0x3D '='
+    {942, 12, 12, 14, 1, -11},  // 0x3E '>'
+    {996, 10, 18, 13, 2, -17},  // 0x3F '?'
+    {1038, 22, 21, 24, 1, -17},  // 0x40 '@'
+    {1170, 16, 18, 16, 0, -17},  // 0x41 'A'
+    {1222, 13, 18, 16, 2, -17},  // 0x42 'B'
+    {1256, 15, 18, 17, 1, -17},  // 0x43 'C'
+    {1308, 14, 18, 17, 2, -17},  // 0x44 'D'
+    {1339, 12, 18, 15, 2, -17},  // 0x45 'E'
+    {1356, 11, 18, 14, 2, -17},  // 0x46 'F'
+    {1369, 16, 18, 18, 1, -17},  // 0x47 'G'
+    {1440, 13, 18, 17, 2, -17},  // 0x48 'H'
+    {1452, 2, 18, 7, 2, -17},  // 0x49 'I'
+    {1456, 9, 18, 13, 1, -17},  // 0x4A 'J'
+    {1478, 14, 18, 16, 2, -17},  // 0x4B 'K'
+    {1528, 10, 18, 14, 2, -17},  // 0x4C 'L'
+    {1536, 16, 18, 20, 2, -17},  // 0x4D 'M'
+    {1578, 13, 18, 18, 2, -17},  // 0x4E 'N'
+    {1613, 17, 18, 19, 1, -17},  // 0x4F 'O'
+    {1671, 12, 18, 16, 2, -17},  // 0x50 'P'
+    {1692, 17, 19, 19, 1, -17},  // 0x51 'Q'
+    {1759, 14, 18, 17, 2, -17},  // 0x52 'R'
+    {1787, 14, 18, 16, 1, -17},  // 0x53 'S'
+    {1860, 12, 18, 15, 1, -17},  // 0x54 'T'
+    {1872, 13, 18, 17, 2, -17},  // 0x55 'U'
+    {1900, 15, 18, 15, 0, -17},  // 0x56 'V'
+    {1943, 22, 18, 22, 0, -17},  // 0x57 'W'
+    {2009, 15, 18, 16, 0, -17},  // 0x58 'X'
+    {2072, 16, 18, 16, 0, -17},  // 0x59 'Y'
+    {2114, 13, 18, 15, 1, -17},  // 0x5A 'Z'
+    {2193, 4, 23, 7, 2, -17},  // 0x5B '['
+    {2203, 7, 18, 7, 0, -17},  // 0x5C 'backslash'
+    {2224, 4, 23, 7, 1, -17},  // 0x5D ']'
+    {2234, 9, 9, 11, 1, -16},  // 0x5E '^'
+    {2261, 15, 1, 13, -1, 4},  // 0x5F '_'
+    {2265, 5, 4, 6, 1, -17},  // 0x60 '`'
+    {2280, 12, 13, 13, 1, -12},  // 0x61 'a'
+    {2336, 12, 18, 13, 1, -17},  // 0x62 'b'
+    {2372, 10, 13, 12, 1, -12},  // 0x63 'c'
+    {2409, 11, 18, 13, 1, -17},  // 0x64 'd'
+    {2445, 11, 13, 13, 1, -12},  // 0x65 'e'
+    {2497, 5, 18, 7, 1, -17},  // 0x66 'f'
+    {2512, 11, 18, 13, 1, -12},  // 0x67 'g'
+    {2564, 10, 18, 13, 1, -17},  // 0x68 'h'
+    {2587, 2, 18, 5, 2, -17},  // 0x69 'i'
+    {2593, 4, 23, 6, 0, -17},  // 0x6A 'j'
+    {2607, 11, 18, 12, 1, -17},  // 0x6B 'k'
+    {2642, 2, 18, 5, 1, -17},  // 0x6C 'l'
+    {2646, 17, 13, 19, 1, -12},  // 0x6D 'm'
+    {2685, 10, 13, 13, 1, -12},  // 0x6E 'n'
+    {2708, 11, 13, 13, 1, -12},  // 0x6F 'o'
+    {2746, 12, 17, 13, 1, -12},  // 0x70 'p'
+    {2782, 11, 17, 13, 1, -12},  // 0x71 'q'
+    {2818, 6, 13, 8, 1, -12},  // 0x72 'r'
+    {2832, 10, 13, 12, 1, -12},  // 0x73 's'
+    {2879, 5, 16, 7, 1, -15},  // 0x74 't'
+    {2894, 10, 13, 13, 1, -12},  // 0x75 'u'
+    {2917, 12, 13, 12, 0, -12},  // 0x76 'v'
+    {2949, 17, 13, 17, 0, -12},  // 0x77 'w'
+    {3000, 11, 13, 11, 0, -12},  // 0x78 'x'
+    {3047, 11, 18, 11, 0, -12},  // 0x79 'y'
+    {3086, 10, 13, 12, 1, -12},  // 0x7A 'z'
+    {3144, 5, 23, 8, 1, -17},  // 0x7B '{'
+    {3165, 2, 23, 6, 2, -17},  // 0x7C '|'
+    {3169, 5, 23, 8, 2, -17},  // 0x7D '}'
+    {3190, 10, 5, 12, 1, -10},  // 0x7E '~'
+};
+
+const SpanFont FreeSans12pt7bSpans PROGMEM = {
+    FreeSans12pt7bSpansSpans, FreeSans12pt7bSpansGlyphs, 0x20, 0x7E, 29};
@@ -0,0 +1,96 @@
+// Generated by Scripts/fontcompile.py from FreeSansBold24pt7b.h -- do not edit
+// 12 glyphs, column spans: 1081 bytes (GFX font: 8808 bytes)
+#pragma once
+#include "../MT_EPD.h"
+
+const uint8_t FreeSansBold24pt7bDigitsSpans[] PROGMEM = {
+    0x02, 0x00, 0x07, 0x0C, 0x03, 0x82, 0x02, 0x00, 0x07, 0x0A, 0x04, 0x01, 0x00, 0x0E, 0x01, 0x00,
+    0x0D, 0x01, 0x00, 0x0B, 0x01, 0x0B, 0x0D, 0x01, 0x07, 0x15, 0x01, 0x05, 0x19, 0x01, 0x03, 0x1D,
+    0x01, 0x02, 0x1F, 0x81, 0x01, 0x01, 0x21, 0x02, 0x01, 0x0A, 0x18, 0x0A, 0x02, 0x00, 0x08, 0x1B,
+    0x08, 0x02, 0x00, 0x07, 0x1C, 0x07, 0x02, 0x00, 0x06, 0x1D, 0x06, 0x83, 0x02, 0x00, 0x07, 0x1C,
+    0x07, 0x02, 0x00, 0x08, 0x1B, 0x08, 0x02, 0x01, 0x0A, 0x18, 0x0A, 0x01, 0x01, 0x21, 0x01, 0x02,
+    0x1F, 0x81, 0x01, 0x03, 0x1D, 0x01, 0x05, 0x19, 0x01, 0x07, 0x15, 0x01, 0x0B, 0x0D, 0x01, 0x06,
+    0x04, 0x83, 0x01, 0x05, 0x05, 0x82, 0x01, 0x04, 0x1D, 0x01, 0x03, 0x1E, 0x01, 0x01, 0x20, 0x01,
+    0x00, 0x21, 0x83, 0x01, 0x07, 0x05, 0x02, 0x05, 0x07, 0x1E, 0x04, 0x02, 0x04, 0x08, 0x1B, 0x07,
+    0x02, 0x03, 0x09, 0x19, 0x09, 0x02, 0x02, 0x0A, 0x18, 0x0A, 0x02, 0x01, 0x0B, 0x17, 0x0B, 0x02,
+    0x01, 0x0B, 0x16, 0x0C, 0x02, 0x00, 0x08, 0x15, 0x0D, 0x02, 0x00, 0x07, 0x15, 0x0D, 0x03, 0x00,
+    0x06, 0x14, 0x07, 0x1C, 0x06, 0x03, 0x00, 0x06, 0x13, 0x07, 0x1C, 0x06, 0x03, 0x00, 0x06, 0x12,
+    0x07, 0x1C, 0x06, 0x03, 0x00, 0x06, 0x12, 0x06, 0x1C, 0x06, 0x03, 0x00, 0x06, 0x11, 0x06, 0x1C,
+    0x06, 0x03, 0x00, 0x07, 0x10, 0x06, 0x1C, 0x06, 0x03, 0x01, 0x08, 0x0E, 0x08, 0x1C, 0x06, 0x02,
+    0x01, 0x14, 0x1C, 0x06, 0x02, 0x01, 0x13, 0x1C, 0x06, 0x02, 0x02, 0x12, 0x1C, 0x06, 0x02, 0x03,
+    0x10, 0x1C, 0x06, 0x02, 0x04, 0x0E, 0x1C, 0x06, 0x02, 0x05, 0x0C, 0x1C, 0x06, 0x02, 0x07, 0x08,
+    0x1C, 0x06, 0x02, 0x07, 0x04, 0x19, 0x03, 0x02, 0x04, 0x07, 0x19, 0x06, 0x02, 0x03, 0x08, 0x19,
+    0x07, 0x02, 0x02, 0x09, 0x19, 0x08, 0x81, 0x02, 0x01, 0x0A, 0x19, 0x09, 0x81, 0x02, 0x00, 0x08,
+    0x1B, 0x08, 0x02, 0x00, 0x07, 0x1C, 0x07, 0x02, 0x00, 0x06, 0x1D, 0x06, 0x03, 0x00, 0x06, 0x0F,
+    0x04, 0x1D, 0x06, 0x82, 0x03, 0x00, 0x07, 0x0E, 0x06, 0x1D, 0x06, 0x03, 0x00, 0x08, 0x0D, 0x07,
+    0x1C, 0x07, 0x02, 0x01, 0x15, 0x1A, 0x08, 0x01, 0x01, 0x21, 0x81, 0x02, 0x02, 0x0E, 0x11, 0x10,
+    0x02, 0x03, 0x0C, 0x12, 0x0E, 0x02, 0x04, 0x0A, 0x12, 0x0D, 0x02, 0x06, 0x06, 0x13, 0x0B, 0x01,
+    0x15, 0x07, 0x01, 0x13, 0x07, 0x01, 0x11, 0x09, 0x01, 0x10, 0x0A, 0x01, 0x0E, 0x0C, 0x02, 0x0C,
+    0x06, 0x14, 0x06, 0x02, 0x0A, 0x07, 0x14, 0x06, 0x02, 0x09, 0x06, 0x14, 0x06, 0x02, 0x07, 0x06,
+    0x14, 0x06, 0x02, 0x05, 0x07, 0x14, 0x06, 0x02, 0x04, 0x06, 0x14, 0x06, 0x02, 0x02, 0x07, 0x14,
+    0x06, 0x02, 0x00, 0x07, 0x14, 0x06, 0x01, 0x00, 0x21, 0x86, 0x01, 0x14, 0x06, 0x82, 0x02, 0x0F,
+    0x02, 0x19, 0x04, 0x02, 0x0A, 0x07, 0x19, 0x05, 0x02, 0x04, 0x0D, 0x19, 0x06, 0x02, 0x00, 0x11,
+    0x19, 0x07, 0x02, 0x00, 0x11, 0x19, 0x08, 0x81, 0x03, 0x00, 0x09, 0x0C, 0x05, 0x1A, 0x07, 0x03,
+    0x00, 0x06, 0x0B, 0x05, 0x1B, 0x07, 0x03, 0x00, 0x06, 0x0B, 0x05, 0x1C, 0x06, 0x03, 0x00, 0x06,
+    0x0A, 0x06, 0x1C, 0x06, 0x83, 0x03, 0x00, 0x06, 0x0A, 0x07, 0x1B, 0x07, 0x03, 0x00, 0x06, 0x0A,
+    0x08, 0x1A, 0x07, 0x03, 0x00, 0x06, 0x0B, 0x08, 0x19, 0x08, 0x02, 0x00, 0x06, 0x0B, 0x16, 0x02,
+    0x00, 0x06, 0x0B, 0x15, 0x02, 0x00, 0x06, 0x0C, 0x13, 0x02, 0x00, 0x06, 0x0D, 0x12, 0x02, 0x00,
+    0x06, 0x0E, 0x10, 0x02, 0x00, 0x06, 0x10, 0x0C, 0x01, 0x12, 0x08, 0x01, 0x0B, 0x0D, 0x01, 0x07,
+    0x15, 0x01, 0x05, 0x19, 0x01, 0x04, 0x1C, 0x01, 0x03, 0x1E, 0x01, 0x02, 0x1F, 0x01, 0x01, 0x21,
+    0x03, 0x01, 0x0A, 0x0E, 0x06, 0x1A, 0x08, 0x03, 0x00, 0x08, 0x0D, 0x05, 0x1C, 0x07, 0x03, 0x00,
+    0x07, 0x0D, 0x05, 0x1C, 0x07, 0x03, 0x00, 0x06, 0x0C, 0x05, 0x1D, 0x06, 0x82, 0x03, 0x00, 0x06,
+    0x0C, 0x05, 0x1C, 0x07, 0x03, 0x00, 0x07, 0x0C, 0x06, 0x1C, 0x07, 0x03, 0x00, 0x08, 0x0C, 0x08,
+    0x1A, 0x08, 0x02, 0x01, 0x07, 0x0D, 0x15, 0x81, 0x02, 0x02, 0x06, 0x0E, 0x13, 0x02, 0x02, 0x06,
+    0x0E, 0x12, 0x02, 0x04, 0x04, 0x0F, 0x10, 0x02, 0x05, 0x03, 0x11, 0x0C, 0x01, 0x13, 0x08, 0x01,
+    0x00, 0x06, 0x84, 0x02, 0x00, 0x06, 0x1D, 0x04, 0x02, 0x00, 0x06, 0x19, 0x08, 0x02, 0x00, 0x06,
+    0x15, 0x0C, 0x02, 0x00, 0x06, 0x13, 0x0E, 0x02, 0x00, 0x06, 0x10, 0x11, 0x02, 0x00, 0x06, 0x0F,
+    0x12, 0x02, 0x00, 0x06, 0x0D, 0x14, 0x02, 0x00, 0x06, 0x0B, 0x11, 0x02, 0x00, 0x06, 0x0A, 0x0D,
+    0x02, 0x00, 0x06, 0x08, 0x0C, 0x02, 0x00, 0x06, 0x07, 0x0B, 0x01, 0x00, 0x0F, 0x01, 0x00, 0x0E,
+    0x01, 0x00, 0x0C, 0x01, 0x00, 0x0A, 0x01, 0x00, 0x09, 0x01, 0x00, 0x07, 0x01, 0x00, 0x06, 0x01,
+    0x15, 0x07, 0x02, 0x06, 0x06, 0x13, 0x0B, 0x02, 0x04, 0x0A, 0x12, 0x0D, 0x02, 0x03, 0x0B, 0x11,
+    0x0F, 0x02, 0x02, 0x0D, 0x10, 0x11, 0x01, 0x02, 0x20, 0x01, 0x01, 0x21, 0x03, 0x01, 0x07, 0x0C,
+    0x09, 0x1A, 0x08, 0x03, 0x00, 0x07, 0x0D, 0x06, 0x1C, 0x07, 0x03, 0x00, 0x06, 0x0E, 0x05, 0x1D,
+    0x06, 0x03, 0x00, 0x06, 0x0E, 0x04, 0x1D, 0x06, 0x83, 0x03, 0x00, 0x07, 0x0D, 0x06, 0x1C, 0x07,
+    0x03, 0x01, 0x06, 0x0D, 0x06, 0x1C, 0x07, 0x03, 0x01, 0x08, 0x0B, 0x0A, 0x1A, 0x08, 0x01, 0x01,
+    0x21, 0x02, 0x02, 0x0D, 0x10, 0x11, 0x02, 0x03, 0x0C, 0x10, 0x11, 0x02, 0x04, 0x0A, 0x11, 0x0F,
+    0x02, 0x06, 0x06, 0x12, 0x0D, 0x01, 0x13, 0x0B, 0x01, 0x15, 0x06, 0x01, 0x08, 0x08, 0x02, 0x06,
+    0x0D, 0x1B, 0x03, 0x02, 0x04, 0x10, 0x1B, 0x05, 0x02, 0x03, 0x12, 0x1B, 0x06, 0x02, 0x02, 0x14,
+    0x1B, 0x06, 0x02, 0x02, 0x15, 0x1B, 0x07, 0x02, 0x01, 0x16, 0x1B, 0x07, 0x03, 0x01, 0x08, 0x0F,
+    0x09, 0x1B, 0x08, 0x03, 0x00, 0x07, 0x11, 0x07, 0x1C, 0x07, 0x03, 0x00, 0x07, 0x11, 0x07, 0x1D,
+    0x06, 0x03, 0x00, 0x06, 0x12, 0x06, 0x1D, 0x06, 0x83, 0x03, 0x00, 0x07, 0x11, 0x06, 0x1C, 0x07,
+    0x03, 0x00, 0x08, 0x10, 0x06, 0x1B, 0x07, 0x03, 0x01, 0x08, 0x0F, 0x06, 0x19, 0x09, 0x01, 0x01,
+    0x20, 0x01, 0x02, 0x1F, 0x01, 0x03, 0x1D, 0x01, 0x04, 0x1B, 0x01, 0x05, 0x18, 0x01, 0x07, 0x14,
+    0x01, 0x0B, 0x0C
+};
+
+const SpanGlyph FreeSansBold24pt7bDigitsGlyphs[] PROGMEM = {
+    {0, 0, 0, 13, 0, 1},  // 0x20 ' '
+    {0, 0, 0, 0, 0, 0},  // 0x21 '!'
+    {0, 0, 0, 0, 0, 0},  // 0x22 '"'
+    {0, 0, 0, 0, 0, 0},  // 0x23 '#'
+    {0, 0, 0, 0, 0, 0},  // 0x24 '$'
+    {0, 0, 0, 0, 0, 0},  // 0x25 '%'
+    {0, 0, 0, 0, 0, 0},  // 0x26 '&'
+    {0, 0, 0, 0, 0, 0},  // 0x27 'quote'
+    {0, 0, 0, 0, 0, 0},  // 0x28 '('
+    {0, 0, 0, 0, 0, 0},  // 0x29 ')'
+    {0, 0, 0, 0, 0, 0},  // 0x2A '*'
+    {0, 0, 0, 0, 0, 0},  // 0x2B '+'
+    {0, 7, 15, 12, 2, -6},  // 0x2C ','
+    {20, 0, 0, 0, 0, 0},  // 0x2D '-'
+    {20, 0, 0, 0, 0, 0},  // 0x2E '.'
+    {20, 0, 0, 0, 0, 0},  // 0x2F '/'
+    {20, 24, 35, 26, 1, -33},  // 0x30 '0'
+    {94, 14, 33, 26, 4, -32},  // 0x31 '1'
+    {115, 23, 34, 26, 2, -33},  // 0x32 '2'
+    {242, 23, 35, 26, 2, -33},  // 0x33 '3'
+    {338, 22, 33, 26, 2, -32},  // 0x34 '4'
+    {398, 23, 34, 26, 2, -32},  // 0x35 '5'
+    {507, 23, 35, 26, 2, -33},  // 0x36 '6'
+    {607, 23, 33, 26, 1, -32},  // 0x37 '7'
+    {687, 24, 35, 26, 1, -33},  // 0x38 '8'
+    {795, 24, 35, 26, 1, -33},  // 0x39 '9'
+};
+
+const SpanFont FreeSansBold24pt7bDigits PROGMEM = {
+    FreeSansBold24pt7bDigitsSpans, FreeSansBold24pt7bDigitsGlyphs, 0x20, 0x39, 56};
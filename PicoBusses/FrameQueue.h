@@ -0,0 +1,64 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "MT_EPD.h"
+#include "ArrivalBoard.h"
+
+#define FRAME_MAX_ROWS BOARD_MAX_ROWS
+
+// One row as it appears on the panel: logo, "To ...", "From ...", minutes.
+// The text comes from ArrivalBoard. The logo is looked up on core0 (it may
+// come off the filesystem) and stays valid until the frame has been drawn.
+struct FrameRow : BoardRow {
+    const NativeBitmap* logo;
+};
+
+// Everything the renderer needs to draw a frame, copied out of the arrival
+// data on core0. Fixed char arrays rather than String: the render core must
+// never touch the heap (see the render core notes in PicoBusses.ino).
+struct FrameSnapshot {
+    uint32_t sequence;
+    uint32_t fetchedAt;   // millis() when the data behind this frame arrived
+    uint8_t rowCount;
+    FrameRow rows[FRAME_MAX_ROWS];
+};
+
+// Single-producer/single-consumer ring. push() is only ever called from one
+// core and pop() only from the other. The indices are plain word-sized
+// loads and stores with acquire/release ordering -- no spinlock, no
+// read-modify-write -- so either core can be paused by a multicore lockout
+// at any instruction without leaving the other one stuck.
+template <typename T, uint8_t N>
+class SpscQueue {
+  public:
+    SpscQueue() : _head(0), _tail(0) {}
+
+    // Producer side. Returns false when full; the caller keeps the item.
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        if (head - tail >= N) return false;
+        _slots[head % N] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        uint32_t head = _head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+        item = _slots[tail % N];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    T _slots[N];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+};
+
+#endif
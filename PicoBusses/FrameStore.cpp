@@ -0,0 +1,93 @@
+#include "FrameStore.h"
+#include "miniz.h"
+
+static const char FRAME_MAGIC[4] = {'N', 'B', 'L', 'F'};
+static const uint16_t FRAME_VERSION = 1;
+
+// Deflate can grow data it can't compress; this covers the stored-block and
+// zlib framing on a snapshot-sized input
+static const size_t PACKED_MAX = sizeof(FrameSnapshot) + 64;
+
+// zlib framing for the Adler-32, and a short match search: a snapshot is
+// mostly NUL padding, which any search finds
+static const int DEFLATE_FLAGS = TDEFL_WRITE_ZLIB_HEADER | 16;
+
+FrameStore::FrameStore() : _path(NULL), _mounted(false) {}
+
+bool FrameStore::begin(const char* path) {
+    _path = path;
+    _mounted = LittleFS.begin();
+    if (!_mounted) Serial.println("FrameStore: LittleFS mount failed");
+    return _mounted;
+}
+
+bool FrameStore::save(const FrameSnapshot& frame, uint32_t asOf) {
+    if (!_mounted) return false;
+
+    // One block for the plain copy and the output
+    uint8_t* buffer = (uint8_t*)malloc(sizeof(FrameSnapshot) + PACKED_MAX);
+    if (buffer == NULL) return false;
+    FrameSnapshot* plain = (FrameSnapshot*)buffer;
+    uint8_t* packed = buffer + sizeof(FrameSnapshot);
+
+    *plain = frame;
+    for (uint8_t i = 0; i < FRAME_MAX_ROWS; i++) plain->rows[i].logo = NULL;  // meaningless after a reset
+
+    size_t packedSize = tdefl_compress_mem_to_mem(packed, PACKED_MAX, plain, sizeof(FrameSnapshot), DEFLATE_FLAGS);
+    if (packedSize == 0) {
+        Serial.println("FrameStore: deflate failed (out of heap?)");
+        free(buffer);
+        return false;
+    }
+
+    Header header;
+    memcpy(header.magic, FRAME_MAGIC, sizeof(header.magic));
+    header.version = FRAME_VERSION;
+    header.frameSize = sizeof(FrameSnapshot);
+    header.asOf = asOf;
+    header.packedSize = packedSize;
+
+    bool ok = false;
+    File file = LittleFS.open(_path, "w");
+    if (file) {
+        ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+             file.write(packed, packedSize) == packedSize;
+        file.close();
+    }
+    free(buffer);
+    if (!ok) Serial.println("FrameStore: write failed");
+    return ok;
+}
+
+bool FrameStore::load(FrameSnapshot& frame, uint32_t& asOf) {
+    if (!_mounted) return false;
+    File file = LittleFS.open(_path, "r");
+    if (!file) return false;
+
+    Header header;
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, FRAME_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FRAME_VERSION || header.frameSize != sizeof(FrameSnapshot) ||
+        header.packedSize > PACKED_MAX) {
+        file.close();
+        return false;
+    }
+
+    uint8_t* packed = (uint8_t*)malloc(header.packedSize);
+    if (packed == NULL) {
+        file.close();
+        return false;
+    }
+    bool ok = file.read(packed, header.packedSize) == header.packedSize;
+    file.close();
+
+    // The zlib header makes tinfl check the Adler-32
+    ok = ok && tinfl_decompress_mem_to_mem(&frame, sizeof(FrameSnapshot), packed, header.packedSize,
+                                           TINFL_FLAG_PARSE_ZLIB_HEADER) == sizeof(FrameSnapshot);
+    free(packed);
+    if (!ok || frame.rowCount > FRAME_MAX_ROWS) return false;
+
+    for (uint8_t i = 0; i < FRAME_MAX_ROWS; i++) frame.rows[i].logo = NULL;
+    asOf = header.asOf;
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef FRAME_STORE_H
+#define FRAME_STORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "FrameQueue.h"
+
+// The last frame, kept deflated in the LittleFS partition so a reset can put
+// it straight back on the panel instead of a splash that sits there until
+// WiFi and the first fetch come through.
+//
+// What's stored is the FrameSnapshot itself -- the text of each row, not the
+// pixels -- compressed with miniz's tdefl behind a small header holding the
+// wall-clock time the data is from. Logo pointers don't survive a reset, so
+// they're stored as NULL and the caller looks them up again after load().
+// Core0 only: LittleFS, File and the compressor all use the heap.
+class FrameStore {
+  public:
+    FrameStore();
+
+    /**
+    * Mounts LittleFS. Core0 only.
+    * @param path File the frame is kept in
+    * @return true if the filesystem is usable
+    */
+    bool begin(const char* path = "/lastframe.bin");
+
+    /**
+    * Deflates a frame and replaces the stored one with it. Core0 only. The
+    * compressor needs a ~160 KB heap block for the few ms it runs; if that
+    * isn't there the save is skipped.
+    * @param frame Frame to keep
+    * @param asOf Wall-clock time (UTC epoch) of the data in it
+    * @return true if it made it to flash
+    */
+    bool save(const FrameSnapshot& frame, uint32_t asOf);
+
+    /**
+    * Reads the stored frame back. Core0 only.
+    * @param frame Filled in on success, with every row's logo NULL
+    * @param asOf Set to the time save() was given
+    * @return false if there's no frame, or it's damaged or from a build
+    * with a different FrameSnapshot
+    */
+    bool load(FrameSnapshot& frame, uint32_t& asOf);
+
+  private:
+    // File header; little-endian like the RP2350. The deflate stream after
+    // it carries a zlib Adler-32, so a torn write fails load() instead of
+    // drawing garbage.
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t frameSize;   // sizeof(FrameSnapshot) when it was written
+        uint32_t asOf;
+        uint32_t packedSize;
+    };
+
+    const char* _path;
+    bool _mounted;
+};
+
+#endif
@@ -1,44 +1,36 @@
 #ifndef Globals_h
 #define Globals_h
 
-#define MAX_ARRIVALS 20 // Maximum number of arrivals we can store
-
-struct BusArrival {
-    String lineRef;
-    String expectedArrivalTimeStr;
-    String destinationDisplay;
-    String stopPointName;
-    time_t expectedArrivalEpoch;
-};
-
-struct StopCodeData {
-    String stopCode;
-    BusArrival arrivals[MAX_ARRIVALS];
-    int arrivalCount = 0;
-};
-
-BusArrival arrivals[MAX_ARRIVALS];
-int arrivalCount = 0;
-
 // Network Stuff
 String User_Agent = "Bus Display";
+#ifdef MOCK_API_HOST
+const char server[] = MOCK_API_HOST;  // Scripts/mock511.py, see config.template.h
+const uint16_t server_port = MOCK_API_PORT;
+#else
 const char server[] = "api.511.org";
+const uint16_t server_port = 443;
+#endif
 const char server_host[] = "api.511.org";
 
 WiFiClient wifiClient;
-SSLClient client(wifiClient, TAs, (size_t)TAs_NUM, -1, 1);
+NetCache netCache;                               // see NetCache.h
+CachedClient cachedClient(wifiClient, netCache); // connects to the cached API address
+SSLClient client(cachedClient, TAs, (size_t)TAs_NUM, -1, 1);
+Fetcher fetcher(client, server, server_port);
 
 // Data tracking
 int currentStopCodeIndex = 0;
 StopCodeData stopCodeDataArray[sizeof(stopCodes)/sizeof(stopCodes[0])];
-String globalUncompressedDataStr = "";
+GzipInflater inflater;     // the last response body, inflated
+StopMonitorParser parser;
+ArrivalBoard board;        // the rows on the panel, from every stop
 
 // Timing variables
-unsigned long beginMicros, endMicros;
-unsigned long byteCount = 0;
 time_t currentTime;
 unsigned long previousMillis = 0;
 const long interval = 65000;
+unsigned long worstLoopMicros = 0;  // longest single loop() pass since the last fetch finished
+unsigned long lastFetchDoneAt = 0;  // millis() when the last successful fetch finished
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "GzipInflater.h"
+#include <stdlib.h>
+#include <string.h>
+#include "miniz.h"
+
+static const size_t  GZIP_HEADER = 10;   // magic, CM, FLG, MTIME, XFL, OS
+static const size_t  GZIP_TRAILER = 8;   // CRC-32, ISIZE
+static const uint8_t CM_DEFLATE = 8;
+static const uint8_t FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10;
+
+GzipInflater::GzipInflater() : _text(NULL), _length(0), _wanted(0) {
+}
+
+GzipInflater::~GzipInflater() {
+    release();
+}
+
+void GzipInflater::release() {
+    free(_text);
+    _text = NULL;
+    _length = 0;
+}
+
+// Bytes before the deflate stream, or 0 if the header runs past the member
+size_t GzipInflater::headerLength(const uint8_t* member, size_t length) {
+    if (length < GZIP_HEADER + GZIP_TRAILER || member[2] != CM_DEFLATE) return 0;
+    uint8_t flags = member[3];
+    size_t at = GZIP_HEADER;
+    if (flags & FEXTRA) {
+        if (at + 2 > length) return 0;
+        at += 2 + (member[at] | (member[at + 1] << 8));
+    }
+    if (flags & FNAME) {
+        const void* end = at < length ? memchr(member + at, 0, length - at) : NULL;
+        if (end == NULL) return 0;
+        at = (const uint8_t*)end - member + 1;
+    }
+    if (flags & FCOMMENT) {
+        const void* end = at < length ? memchr(member + at, 0, length - at) : NULL;
+        if (end == NULL) return 0;
+        at = (const uint8_t*)end - member + 1;
+    }
+    if (flags & FHCRC) at += 2;
+    return at + GZIP_TRAILER <= length ? at : 0;
+}
+
+bool GzipInflater::frame(const uint8_t* body, size_t length, Member& member) {
+    // The member may not start the body
+    const uint8_t* start = NULL;
+    for (size_t i = 0; i + 1 < length; i++) {
+        if (body[i] == 0x1F && body[i + 1] == 0x8B) {
+            start = body + i;
+            length -= i;
+            break;
+        }
+    }
+    if (start == NULL) return false;
+    size_t header = headerLength(start, length);
+    if (header == 0) return false;
+
+    // ISIZE, the last 4 bytes, little-endian
+    const uint8_t* trailer = start + length - 4;
+    member.stream = start + header;
+    member.streamLength = length - header - GZIP_TRAILER;
+    member.size = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+    return true;
+}
+
+GzipInflater::Result GzipInflater::unpack(const uint8_t* body, size_t length) {
+    release();
+    _wanted = 0;
+
+    Member member;
+    if (!frame(body, length, member)) return NOT_GZIP;
+    if (member.size == 0) return CORRUPT;
+
+    _wanted = (size_t)member.size + 1;  // and a NUL, so the parser can take it as a C string
+    _text = (char*)malloc(_wanted);
+    if (_text == NULL) return NO_MEMORY;
+
+    size_t n = tinfl_decompress_mem_to_mem(_text, member.size, member.stream, member.streamLength, 0);
+    if (n != member.size) {  // failed, or ISIZE lied
+        release();
+        return CORRUPT;
+    }
+    _text[n] = '\0';
+    _length = n;
+    return INFLATED;
+}
@@ -0,0 +1,66 @@
+#ifndef GZIP_INFLATER_H
+#define GZIP_INFLATER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Inflates a gzip response body into one NUL-terminated buffer, with miniz's
+// tinfl.
+//
+// The 511 API sends gzip whatever the request asks for. The member is found
+// by its magic (1f 8b), its header walked (the optional FEXTRA, FNAME,
+// FCOMMENT and FHCRC fields included), and the output sized from the ISIZE
+// trailer, so the text is malloc'd once at its final size and handed to the
+// parser in place. Nothing here is Arduino-specific, so the host build
+// inflates the same bytes the same way.
+class GzipInflater {
+  public:
+    enum Result : uint8_t { INFLATED, NOT_GZIP, NO_MEMORY, CORRUPT };
+
+    // Where a body's gzip member keeps its deflate stream
+    struct Member {
+        const uint8_t* stream;
+        size_t streamLength;
+        uint32_t size;  // ISIZE: the inflated length, mod 2^32
+    };
+
+    GzipInflater();
+    ~GzipInflater();
+
+    /**
+    * Inflates a body, replacing the last text.
+    * @param body Response body; the gzip member may come after other bytes
+    * @param length Its length
+    * @return INFLATED, or why there's no text
+    */
+    Result unpack(const uint8_t* body, size_t length);
+
+    /**
+    * Finds a body's gzip member and walks its header, without inflating.
+    * @param body Response body; the gzip member may come after other bytes
+    * @param length Its length
+    * @param member Filled in when there is one
+    * @return false if there's no complete gzip member
+    */
+    static bool frame(const uint8_t* body, size_t length, Member& member);
+
+    /**
+    * Frees the text.
+    */
+    void release();
+
+    const char* text() const { return _text; }
+    size_t length() const { return _length; }
+
+    // Bytes the last unpack() asked malloc for (with NO_MEMORY, what failed)
+    size_t wanted() const { return _wanted; }
+
+  private:
+    char* _text;
+    size_t _length;
+    size_t _wanted;
+
+    static size_t headerLength(const uint8_t* member, size_t length);
+};
+
+#endif
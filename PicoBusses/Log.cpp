@@ -0,0 +1,170 @@
+#include "Log.h"
+#include <atomic>
+
+static_assert((LOG_RING_BYTES & (LOG_RING_BYTES - 1)) == 0, "LOG_RING_BYTES must be a power of two");
+
+// A record in the ring keeps the format as a native pointer; the wire gets
+// its low 32 bits, which is all of it on the Pico
+static const uint8_t FORMAT_AT = 5;
+static const uint8_t ARG_BYTES_AT = FORMAT_AT + sizeof(const char*);
+static const uint8_t HEADER_BYTES = ARG_BYTES_AT + 1;  // level, ms, format, argBytes
+static const uint8_t WIRE_HEADER_BYTES = 3 + 10;       // sync, 'R', core, level, ms, format, argBytes
+static const uint8_t DEFINE_SLOTS = 64;     // format strings sent since the last resend
+static const size_t  FORMAT_MAX = 160;      // longer format strings are sent cut
+
+// A frame only goes out once the port has room for all of it, so every frame
+// (8 + FORMAT_MAX, WIRE_HEADER_BYTES + LOG_RECORD_MAX) has to fit in an empty
+// USB CDC transmit buffer, 256 bytes on arduino-pico
+
+// One core's records, each a length byte and the record. Single producer
+// (that core) and single consumer (flush() on core0), with the indices as
+// plain acquire/release loads and stores like SpscQueue, so a multicore
+// lockout can park either side anywhere.
+struct LogRing {
+    uint8_t bytes[LOG_RING_BYTES];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> dropped;  // written by the producer only
+};
+static LogRing rings[2];
+
+static void put32(uint8_t* out, uint32_t v) {
+    out[0] = v;
+    out[1] = v >> 8;
+    out[2] = v >> 16;
+    out[3] = v >> 24;
+}
+
+LogRecord::LogRecord(uint8_t level, const char* format) : _length(HEADER_BYTES), _full(false) {
+    _bytes[0] = level;
+    put32(_bytes + 1, millis());
+    memcpy(_bytes + FORMAT_AT, &format, sizeof(format));
+    _bytes[ARG_BYTES_AT] = 0;
+}
+
+void LogRecord::put(char tag, uint32_t word) {
+    if (_full || _length + 5 > LOG_RECORD_MAX) {
+        _full = true;
+        return;
+    }
+    _bytes[_length] = tag;
+    put32(_bytes + _length + 1, word);
+    _length += 5;
+    _bytes[ARG_BYTES_AT] += 5;
+}
+
+void LogRecord::add(float v) {
+    uint32_t word;
+    memcpy(&word, &v, sizeof(word));
+    put('f', word);
+}
+
+void LogRecord::add(const char* s) {
+    if (s == NULL) s = "(null)";
+    size_t n = strnlen(s, LOG_STRING_MAX);
+    if (_full || _length + 2 + n > LOG_RECORD_MAX) {
+        _full = true;
+        return;
+    }
+    _bytes[_length] = 's';
+    _bytes[_length + 1] = n;
+    memcpy(_bytes + _length + 2, s, n);
+    _length += 2 + n;
+    _bytes[ARG_BYTES_AT] += 2 + n;
+}
+
+void Log::commit(const LogRecord& record) {
+    LogRing& ring = rings[get_core_num() & 1];
+    uint8_t len = record.length();
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    uint32_t tail = ring.tail.load(std::memory_order_acquire);
+    if (LOG_RING_BYTES - (head - tail) < (uint32_t)len + 1) {
+        ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    ring.bytes[head % LOG_RING_BYTES] = len;
+    const uint8_t* bytes = record.bytes();
+    for (uint8_t i = 0; i < len; i++) ring.bytes[(head + 1 + i) % LOG_RING_BYTES] = bytes[i];
+    ring.head.store(head + 1 + len, std::memory_order_release);
+}
+
+uint32_t Log::dropped() {
+    return rings[0].dropped.load(std::memory_order_relaxed) + rings[1].dropped.load(std::memory_order_relaxed);
+}
+
+// Format strings whose text has gone out; core0 only
+static const char* defined[DEFINE_SLOTS];
+static uint8_t definedCount = 0;
+
+static bool isDefined(const char* format) {
+    for (uint8_t i = 0; i < definedCount; i++) {
+        if (defined[i] == format) return true;
+    }
+    return false;
+}
+
+void Log::flush(Print& out) {
+    static uint32_t reported[2] = {0, 0};
+    static unsigned long definedAt = 0;
+    if (millis() - definedAt >= DEFINE_MS) {
+        definedCount = 0;
+        definedAt = millis();
+    }
+
+    uint8_t record[LOG_RECORD_MAX];
+    uint8_t frame[WIRE_HEADER_BYTES + LOG_RECORD_MAX];
+    for (uint8_t core = 0; core < 2; core++) {
+        LogRing& ring = rings[core];
+        for (;;) {
+            uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+            uint32_t head = ring.head.load(std::memory_order_acquire);
+            if (tail == head) break;
+
+            uint8_t len = ring.bytes[tail % LOG_RING_BYTES];
+            for (uint8_t i = 0; i < len; i++) record[i] = ring.bytes[(tail + 1 + i) % LOG_RING_BYTES];
+            const char* format;
+            memcpy(&format, record + FORMAT_AT, sizeof(format));
+
+            // The text first, the first time round
+            if (!isDefined(format)) {
+                size_t n = strnlen(format, FORMAT_MAX);
+                if ((size_t)out.availableForWrite() < 8 + n) return;
+                uint8_t define[8];
+                define[0] = LOG_SYNC;
+                define[1] = 'D';
+                put32(define + 2, (uint32_t)(uintptr_t)format);
+                define[6] = n;
+                define[7] = n >> 8;
+                out.write(define, sizeof(define));
+                out.write((const uint8_t*)format, n);
+                if (definedCount == DEFINE_SLOTS) definedCount = 0;
+                defined[definedCount++] = format;
+            }
+
+            uint8_t argBytes = record[ARG_BYTES_AT];
+            size_t frameLen = WIRE_HEADER_BYTES + argBytes;
+            if ((size_t)out.availableForWrite() < frameLen) return;
+            frame[0] = LOG_SYNC;
+            frame[1] = 'R';
+            frame[2] = core;
+            memcpy(frame + 3, record, 5);  // level, ms
+            put32(frame + 8, (uint32_t)(uintptr_t)format);
+            frame[12] = argBytes;
+            memcpy(frame + WIRE_HEADER_BYTES, record + HEADER_BYTES, argBytes);
+            out.write(frame, frameLen);
+            ring.tail.store(tail + 1 + len, std::memory_order_release);
+        }
+
+        // Drops are the newest records, so they're reported after what's left
+        uint32_t dropped = ring.dropped.load(std::memory_order_relaxed);
+        if (dropped != reported[core]) {
+            if (out.availableForWrite() < 7) return;
+            frame[0] = LOG_SYNC;
+            frame[1] = 'X';
+            frame[2] = core;
+            put32(frame + 3, dropped - reported[core]);
+            out.write(frame, 7);
+            reported[core] = dropped;
+        }
+    }
+}
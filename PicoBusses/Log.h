@@ -0,0 +1,127 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+// Levels for LOG_LEVEL. Calls below it compile to nothing, arguments and all.
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE  4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_RECORD_MAX 176   // bytes of one encoded record, arguments included
+#define LOG_STRING_MAX 40    // of one string argument; longer ones are cut
+#define LOG_RING_BYTES 2048  // per core; a power of two
+
+// Deferred, levelled logging for the running loop, from either core.
+//
+// LOG_INFO("Fetched %u bytes from %s", n, host) formats nothing. It stores
+// millis(), the format string's address and the arguments' bytes as one
+// binary record in the calling core's RAM ring: no heap, no lock and no
+// Serial, so core1 may log too. If the ring is full the record is dropped,
+// and counted. flush() runs on core0 when the loop has nothing better to do.
+// It copies whole records to the port while the USB CDC buffer has room for
+// them, and never waits on it.
+//
+// The port carries a mix of plain text and framed records: setup, the boot
+// reports and the periodic tables still print directly. Scripts/logdecode.py
+// prints both as text.
+//
+// Format strings must be literals, since only their address is kept. The
+// flusher sends each string's text ahead of the first record that uses it,
+// and again every DEFINE_MS so a decoder attached later can catch up.
+// Arguments may be integers (64-bit ones are cut to 32 bits), floats, or
+// char* and String, whose text is copied in.
+//
+// Wire format, little-endian. Each frame starts with LOG_SYNC (ASCII RS,
+// which never appears in the text):
+//   'R' u8 core, u8 level, u32 ms, u32 format, u8 argBytes, args
+//   'D' u32 format, u16 length, text         (a format string's text)
+//   'X' u8 core, u32 count                   (records dropped since the last 'X')
+// An argument is a tag and its value: 'i' i32, 'u' u32, 'f' f32, or 's' u8
+// length followed by the text.
+#define LOG_SYNC 0x1E
+
+class LogRecord {
+  public:
+    LogRecord(uint8_t level, const char* format);
+
+    void add(const char* s);
+    void add(const String& s) { add(s.c_str()); }
+    void add(float v);
+    void add(double v) { add((float)v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type add(T v) {
+        if (std::is_signed<T>::value) put('i', (uint32_t)(int32_t)v);
+        else put('u', (uint32_t)v);
+    }
+
+    const uint8_t* bytes() const { return _bytes; }
+    uint8_t length() const { return _length; }
+
+  private:
+    uint8_t _bytes[LOG_RECORD_MAX];  // level, ms, format, argBytes, args
+    uint8_t _length;
+    bool _full;                      // an argument didn't fit: the rest are left off too
+
+    void put(char tag, uint32_t word);
+};
+
+class Log {
+  public:
+    static const uint32_t DEFINE_MS = 60000;  // resend format strings this often
+
+    template <typename... Args>
+    static void write(uint8_t level, const char* format, const Args&... args) {
+        LogRecord record(level, format);
+        (record.add(args), ...);
+        commit(record);
+    }
+
+    /**
+    * Sends whole frames while out has room for them, then returns. Core0.
+    * @param out The port; its availableForWrite() has to report real room
+    */
+    static void flush(Print& out);
+
+    /**
+    * @return Records dropped on a full ring since boot, both cores
+    */
+    static uint32_t dropped();
+
+  private:
+    static void commit(const LogRecord& record);
+};
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Log::write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) Log::write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) Log::write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Log::write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#include "LogoStore.h"
+
+static const char PAK_MAGIC[4] = {'N', 'B', 'L', 'P'};
+static const uint16_t PAK_VERSION = 1;
+
+LogoStore::LogoStore() : _count(0), _released(0), _loads(0) {
+    for (uint8_t i = 0; i < LOGO_SLOTS; i++) {
+        _slots[i].entry = -1;
+        _slots[i].lastSeq = 0;
+    }
+}
+
+bool LogoStore::begin(const char* path) {
+    _count = 0;
+    if (!LittleFS.begin()) {
+        Serial.println("LogoStore: LittleFS mount failed");
+        return false;
+    }
+    _file = LittleFS.open(path, "r");
+    if (!_file) {
+        Serial.print("LogoStore: no ");
+        Serial.println(path);
+        return false;
+    }
+
+    uint8_t header[8];
+    if (_file.read(header, sizeof(header)) != sizeof(header) || memcmp(header, PAK_MAGIC, 4) != 0) {
+        Serial.println("LogoStore: not a logo pak");
+        return false;
+    }
+    uint16_t version = header[4] | (header[5] << 8);
+    uint16_t count = header[6] | (header[7] << 8);
+    if (version != PAK_VERSION || count > MAX_LOGOS) {
+        Serial.println("LogoStore: unsupported pak version or too many logos");
+        return false;
+    }
+    if (_file.read((uint8_t*)_index, count * sizeof(PakEntry)) != count * sizeof(PakEntry)) {
+        Serial.println("LogoStore: truncated index");
+        return false;
+    }
+    for (uint16_t i = 0; i < count; i++) _index[i].name[sizeof(_index[i].name) - 1] = '\0';
+    _count = count;
+
+    Serial.print("LogoStore: ");
+    Serial.print(_count);
+    Serial.println(" logos");
+    return true;
+}
+
+int16_t LogoStore::find(const char* lineRef) {
+    for (uint16_t i = 0; i < _count; i++) {
+        if (strcmp(_index[i].name, lineRef) == 0) return i;
+    }
+    return -1;
+}
+
+const NativeBitmap* LogoStore::acquire(const char* lineRef, uint32_t sequence) {
+    int16_t entry = find(lineRef);
+    if (entry < 0) return NULL;
+
+    // Aliases share data: look for the bytes, not the name
+    uint32_t released = _released.load(std::memory_order_acquire);
+    Slot* reuse = NULL;
+    for (uint8_t i = 0; i < LOGO_SLOTS; i++) {
+        Slot& slot = _slots[i];
+        if (slot.entry >= 0 && _index[slot.entry].offset == _index[entry].offset) {
+            slot.lastSeq = sequence;
+            return &slot.bitmap;
+        }
+        // Otherwise load into a free slot, else the oldest one whose frames
+        // have all been drawn
+        if (slot.entry < 0) {
+            if (!reuse || reuse->entry >= 0) reuse = &slot;
+            continue;
+        }
+        if ((int32_t)(slot.lastSeq - released) > 0) continue;  // an undrawn frame uses it
+        if (!reuse || (reuse->entry >= 0 && slot.lastSeq < reuse->lastSeq)) reuse = &slot;
+    }
+    if (!reuse) return NULL;
+
+    const PakEntry& e = _index[entry];
+    uint32_t size = (uint32_t)(e.rotation & 1 ? e.width : e.height) * (((e.rotation & 1 ? e.height : e.width) + 7) / 8);
+    reuse->entry = -1;
+    if (size > SLOT_BYTES || !_file.seek(e.offset) || _file.read(reuse->data, size) != size) return NULL;
+
+    reuse->entry = entry;
+    reuse->lastSeq = sequence;
+    reuse->bitmap.bitmap = reuse->data;
+    reuse->bitmap.width = e.width;
+    reuse->bitmap.height = e.height;
+    reuse->bitmap.rotation = e.rotation;
+    _loads++;
+    return &reuse->bitmap;
+}
@@ -0,0 +1,84 @@
+#ifndef LOGO_STORE_H
+#define LOGO_STORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include "MT_EPD.h"
+
+#define LOGO_SLOTS 10    // a panel of rows, plus room for frames still in flight
+
+// Transit logos loaded on demand from logos.pak in the LittleFS partition
+// (Scripts/assetpack.py --pak, uploaded from the sketch's data/ folder), so
+// a new line's logo is a filesystem upload instead of a reflash.
+//
+// begin() reads the pak's index; acquire() copies a logo into one of a few
+// SRAM slots the first time a frame needs it. Both run on core0 -- LittleFS
+// and File use the heap. The renderer reads slot data through the
+// NativeBitmap pointers core0 put in the frame -- while drawing, and in band
+// mode again while displayAsync() replays the display list -- and calls
+// release() once the frame has been uploaded. A slot is only reloaded after
+// every frame that used it has been released, so core0 never writes under
+// core1's feet.
+class LogoStore {
+  public:
+    static const uint16_t MAX_LOGOS = 128;
+    static const uint16_t SLOT_BYTES = 130 * 17;  // a 130x130 logo, native rows
+
+    LogoStore();
+
+    /**
+    * Mounts LittleFS and reads the pak's index. Core0 only.
+    * @param path Pak file in the filesystem
+    * @return true if the pak is there and looks right
+    */
+    bool begin(const char* path = "/logos.pak");
+
+    /**
+    * Finds a line's logo, loading it into a slot if it isn't in one. Core0
+    * only. The bitmap stays put until release() has passed sequence.
+    * @param lineRef Line to look up
+    * @param sequence Frame that will draw it
+    * @return The logo, or NULL if the pak doesn't have it or every slot is
+    * still held by an undrawn frame
+    */
+    const NativeBitmap* acquire(const char* lineRef, uint32_t sequence);
+
+    /**
+    * Marks every frame up to sequence as uploaded. Called by the renderer
+    * after displayAsync(), not before: band mode reads the slots then.
+    */
+    void release(uint32_t sequence) { _released.store(sequence, std::memory_order_release); }
+
+    uint16_t count() const { return _count; }
+    uint32_t loads() const { return _loads; }
+
+  private:
+    // On-flash index entry; the pak is little-endian like the RP2350
+    struct PakEntry {
+        char name[8];
+        uint32_t offset;
+        uint16_t width;
+        uint16_t height;
+        uint8_t rotation;
+        uint8_t reserved[3];
+    };
+
+    struct Slot {
+        int16_t entry;       // index entry loaded here, -1 for none
+        uint32_t lastSeq;    // newest frame that uses it
+        NativeBitmap bitmap;
+        uint8_t data[SLOT_BYTES];
+    };
+
+    File _file;
+    PakEntry _index[MAX_LOGOS];
+    uint16_t _count;
+    Slot _slots[LOGO_SLOTS];
+    std::atomic<uint32_t> _released;
+    uint32_t _loads;
+
+    int16_t find(const char* lineRef);
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "MT_EPD.h"
 #include <Arduino.h>
+#include "Log.h"
 
 MT_EPD::MT_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy)
     : Adafruit_GFX(800, 480),  // Always initialize with the physical dimensions
@@ -7,19 +8,34 @@ MT_EPD::MT_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy)
       _width(800), _height(480) {
 
     _orientation = 0;  // Default orientation
+    _verbose = true;
+    _spanFont = NULL;
     
     // Calculate buffer size (1 bit per pixel for each plane)
     _buffer_size = _width * _height / 8;
     
-    // Allocate memory for buffers
+#if MT_EPD_BAND_MODE
+    // No planes: an empty display list is an all-white frame
+    _buffer_bw = NULL;
+    _opCount = 0;
+    _textUsed = 0;
+    _textEndX = _textEndY = 0;
+    _recordOp = NULL;
+    _opDepth = 0;
+    _opOverflow = false;
+    _replaying = false;
+    _bandTop = 0;
+#else
+    // Allocate memory for the B/W buffer; red tiles come and go as needed
     _buffer_bw = (uint8_t*)malloc(_buffer_size);
-    _buffer_red = (uint8_t*)malloc(_buffer_size);
+    memset(_red_tiles, 0, sizeof(_red_tiles));
+    _capture = NULL;
 
-    // Initialize buffers to white (0xFF for B/W, 0x00 for red)
-    if (_buffer_bw && _buffer_red) {
+    // Initialize to white (0xFF for B/W; no red tiles means no red)
+    if (_buffer_bw) {
         memset(_buffer_bw, 0xFF, _buffer_size);
-        memset(_buffer_red, 0x00, _buffer_size);
     }
+#endif
     
     // Start with rotation 0
     setRotation(0);
@@ -28,7 +44,9 @@ MT_EPD::MT_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy)
 MT_EPD::~MT_EPD() {
     // Free allocated memory
     if (_buffer_bw) free(_buffer_bw);
-    if (_buffer_red) free(_buffer_red);
+#if !MT_EPD_BAND_MODE
+    freeRedTiles();
+#endif
 }
 
 
@@ -37,13 +55,15 @@ void MT_EPD::begin(void) {
     digitalWrite(_dc_pin, HIGH);
     digitalWrite(_rst_pin, HIGH);
     
-    Serial.println("Initializing display...");
+    if (_verbose) LOG_DEBUG("Initializing display...");
     
+#if !MT_EPD_BAND_MODE
     // Check if memory allocation was successful
-    if (!_buffer_bw || !_buffer_red) {
-        Serial.println("Error: Failed to allocate display buffers!");
+    if (!_buffer_bw) {
+        LOG_ERROR("Failed to allocate display buffers");
         return;
     }
+#endif
     
     // Hardware reset
     reset();
@@ -85,7 +105,7 @@ void MT_EPD::begin(void) {
     sendCommand(0x04);    // Power on
     waitUntilIdle();
 
-    Serial.println("Init complete");
+    if (_verbose) LOG_DEBUG("Init complete");
 }
 
 void MT_EPD::transformCoordinates(int16_t &x, int16_t &y) {
@@ -106,6 +126,15 @@ void MT_EPD::setRotation(uint8_t r) {
 }
 
 void MT_EPD::drawPixel(int16_t x, int16_t y, uint16_t color) {
+#if MT_EPD_BAND_MODE
+    if (recording()) {
+        beginOp(OP_PIXEL, x, y, color);
+        drawPixel(x, y, color);  // dry run: records the row
+        endOp();
+        return;
+    }
+#endif
+
     // Handle rotation (converting logical to physical coordinates)
     int16_t t;
     switch (getRotation()) {
@@ -126,31 +155,374 @@ void MT_EPD::drawPixel(int16_t x, int16_t y, uint16_t color) {
     }
 
     // Bounds check with physical dimensions
-    if (x < 0 || x >= 800 || y < 0 || y >= 480) return;
+    if (x < 0 || x >= 800 || y < 0 || y >= 480) {
+#if !MT_EPD_BAND_MODE
+        if (_capture) _capture->valid = false;  // might be on the panel where the tile goes
+#endif
+        return;
+    }
+    
+#if MT_EPD_BAND_MODE
+    if (!_replaying) {
+        // Dry run of a recorded call: only note which rows it touches
+        if (_recordOp) {
+            if (y < _recordOp->rowMin) _recordOp->rowMin = y;
+            if (y > _recordOp->rowMax) _recordOp->rowMax = y;
+        }
+        return;
+    }
     
+    // Replaying: only the rows of the current band exist
+    if (y < _bandTop || y >= _bandTop + BAND_ROWS) return;
+    
+    uint16_t band_idx = ((y - _bandTop) * 100) + (x / 8);
+    uint8_t band_bit = 7 - (x % 8);
+    
+    // Same colour rules as the planes below
+    if (color == EPD_BLACK) {
+        _band_bw[band_idx] &= ~(1 << band_bit);
+        _band_red[band_idx] &= ~(1 << band_bit);
+    }
+    else if (color == EPD_RED) {
+        _band_bw[band_idx] |= (1 << band_bit);
+        _band_red[band_idx] |= (1 << band_bit);
+    }
+    else { // white
+        _band_bw[band_idx] |= (1 << band_bit);
+        _band_red[band_idx] &= ~(1 << band_bit);
+    }
+#else
     // Calculate byte index and bit position as before
     uint32_t byte_idx = (y * 100) + (x / 8);
     uint8_t bit_position = 7 - (x % 8);
     
     if (byte_idx >= _buffer_size) return;
+    if (_capture) {
+        captureBits(byte_idx, 1 << bit_position, color);
+        return;
+    }
+    
+    // Red tile byte for this pixel; only red itself may allocate a tile
+    uint8_t* red = redTile(x, y, color == EPD_RED);
+    if (red) red += (y % RED_TILE_ROWS) * RED_TILE_BYTES + (x / 8) % RED_TILE_BYTES;
     
     // Set pixel according to color
     if (color == EPD_BLACK) {
         _buffer_bw[byte_idx] &= ~(1 << bit_position);
-        _buffer_red[byte_idx] &= ~(1 << bit_position);
+        if (red) *red &= ~(1 << bit_position);
     } 
     else if (color == EPD_RED) {
         _buffer_bw[byte_idx] |= (1 << bit_position);
-        _buffer_red[byte_idx] |= (1 << bit_position);
+        if (red) *red |= (1 << bit_position);
     }
     else { // white
         _buffer_bw[byte_idx] |= (1 << bit_position);
-        _buffer_red[byte_idx] &= ~(1 << bit_position);
+        if (red) *red &= ~(1 << bit_position);
+    }
+#endif
+}
+
+#if MT_EPD_BAND_MODE
+MT_EPD::DrawOp* MT_EPD::beginOp(uint8_t type, int16_t x, int16_t y, uint16_t color) {
+    _opDepth++;
+    _recordOp = NULL;
+    
+    if (_opCount >= MAX_OPS) {
+        _opOverflow = true;
+        return NULL;
     }
+    
+    DrawOp* op = &_ops[_opCount++];
+    memset(op, 0, sizeof(DrawOp));
+    op->type = type;
+    op->x = x;
+    op->y = y;
+    op->color = color;
+    op->rowMin = 0x7FFF;  // nothing touched yet
+    op->rowMax = -1;
+    
+    _recordOp = op;
+    return op;
+}
+
+void MT_EPD::endOp() {
+    _opDepth--;
+    _recordOp = NULL;
+}
+
+void MT_EPD::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (recording()) {
+        DrawOp* op = beginOp(OP_RECT, x, y, color);
+        if (op) {
+            op->w = w;
+            op->h = h;
+        }
+        Adafruit_GFX::fillRect(x, y, w, h, color);  // dry run: records the rows
+        endOp();
+        return;
+    }
+    Adafruit_GFX::fillRect(x, y, w, h, color);
+}
+
+void MT_EPD::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (recording()) {
+        // Recorded as a 1-wide rect; replay draws the same pixels
+        DrawOp* op = beginOp(OP_RECT, x, y, color);
+        if (op) {
+            op->w = 1;
+            op->h = h;
+        }
+        Adafruit_GFX::drawFastVLine(x, y, h, color);
+        endOp();
+        return;
+    }
+    Adafruit_GFX::drawFastVLine(x, y, h, color);
+}
+
+void MT_EPD::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (recording()) {
+        DrawOp* op = beginOp(OP_RECT, x, y, color);
+        if (op) {
+            op->w = w;
+            op->h = 1;
+        }
+        Adafruit_GFX::drawFastHLine(x, y, w, color);
+        endOp();
+        return;
+    }
+    Adafruit_GFX::drawFastHLine(x, y, w, color);
+}
+
+size_t MT_EPD::recordChar(uint8_t c) {
+    uint8_t flags = (wrap ? TEXT_WRAP : 0) | (_cp437 ? TEXT_CP437 : 0) | (_spanFont ? TEXT_SPAN : 0);
+    
+    // A character that carries on where the last one stopped, in the same
+    // style, extends that text op: print("To ") + println(dest) is one op
+    DrawOp* op = _opCount ? &_ops[_opCount - 1] : NULL;
+    bool extend = op && op->type == OP_TEXT &&
+                  op->ptr == currentFont() && op->color == textcolor && op->bg == textbgcolor &&
+                  op->sizeX == textsize_x && op->sizeY == textsize_y && op->flags == flags &&
+                  cursor_x == _textEndX && cursor_y == _textEndY &&
+                  op->text + op->textLen == _textUsed;
+    
+    if (extend) {
+        _opDepth++;
+        _recordOp = op;
+    } else {
+        op = beginOp(OP_TEXT, cursor_x, cursor_y, textcolor);
+        if (op) {
+            op->bg = textbgcolor;
+            op->sizeX = textsize_x;
+            op->sizeY = textsize_y;
+            op->flags = flags;
+            op->ptr = currentFont();
+            op->text = _textUsed;
+        }
+    }
+    
+    if (op) {
+        if (_textUsed < TEXT_POOL) {
+            _textPool[_textUsed++] = c;
+            op->textLen++;
+        } else {
+            _opOverflow = true;
+        }
+    }
+    
+    size_t n = writeChar(c);  // dry run: moves the cursor, records the rows
+    endOp();
+    
+    _textEndX = cursor_x;
+    _textEndY = cursor_y;
+    return n;
+}
+
+void MT_EPD::replayOp(const DrawOp& op) {
+    switch (op.type) {
+        case OP_PIXEL:
+            drawPixel(op.x, op.y, op.color);
+            break;
+            
+        case OP_RECT:
+            Adafruit_GFX::fillRect(op.x, op.y, op.w, op.h, op.color);
+            break;
+            
+        case OP_BITMAP:
+            drawBitmap(op.x, op.y, (const uint8_t*)op.ptr, op.w, op.h, op.color, op.bg);
+            break;
+            
+        case OP_NATIVE:
+            drawNativeBitmap(op.x, op.y, *(const NativeBitmap*)op.ptr, op.color, op.bg);
+            break;
+            
+        case OP_TEXT: {
+            // Put the text state back the way it was when this was recorded
+            int16_t saveX = cursor_x, saveY = cursor_y;
+            GFXfont* saveFont = gfxFont;
+            const SpanFont* saveSpanFont = _spanFont;
+            uint16_t saveColor = textcolor, saveBg = textbgcolor;
+            uint8_t saveSizeX = textsize_x, saveSizeY = textsize_y;
+            bool saveWrap = wrap, saveCp437 = _cp437;
+            
+            cursor_x = op.x;
+            cursor_y = op.y;
+            if (op.flags & TEXT_SPAN) {
+                _spanFont = (const SpanFont*)op.ptr;
+            } else {
+                _spanFont = NULL;
+                gfxFont = (GFXfont*)op.ptr;
+            }
+            textcolor = op.color;
+            textbgcolor = op.bg;
+            textsize_x = op.sizeX;
+            textsize_y = op.sizeY;
+            wrap = op.flags & TEXT_WRAP;
+            _cp437 = op.flags & TEXT_CP437;
+            
+            for (uint16_t i = 0; i < op.textLen; i++) {
+                writeChar(_textPool[op.text + i]);
+            }
+            
+            cursor_x = saveX;
+            cursor_y = saveY;
+            gfxFont = saveFont;
+            _spanFont = saveSpanFont;
+            textcolor = saveColor;
+            textbgcolor = saveBg;
+            textsize_x = saveSizeX;
+            textsize_y = saveSizeY;
+            wrap = saveWrap;
+            _cp437 = saveCp437;
+            break;
+        }
+    }
+}
+
+void MT_EPD::sendBands(bool red) {
+    _replaying = true;
+    
+    for (int16_t top = 0; top < 480; top += BAND_ROWS) {
+        _bandTop = top;
+        memset(_band_bw, 0xFF, BAND_BYTES);
+        memset(_band_red, 0x00, BAND_BYTES);
+        
+        // Replay, in order, every op that touched this band
+        for (uint16_t i = 0; i < _opCount; i++) {
+            if (_ops[i].rowMax >= top && _ops[i].rowMin < top + BAND_ROWS) {
+                replayOp(_ops[i]);
+            }
+        }
+        
+        const uint8_t* band = red ? _band_red : _band_bw;
+        for (uint16_t i = 0; i < BAND_BYTES; i++) {
+            sendData(band[i]);
+        }
+        // Process system tasks every band
+        yield();
+    }
+    
+    _replaying = false;
+}
+#else
+uint8_t* MT_EPD::redTile(int16_t x, int16_t y, bool create) {
+    uint16_t t = (y / RED_TILE_ROWS) * RED_TILES_X + (x / 8) / RED_TILE_BYTES;
+    if (!_red_tiles[t] && create) {
+        // calloc: a fresh tile has no red in it
+        _red_tiles[t] = (uint8_t*)calloc(RED_TILE_BYTES * RED_TILE_ROWS, 1);
+    }
+    return _red_tiles[t];
+}
+
+void MT_EPD::freeRedTiles() {
+    for (uint16_t t = 0; t < RED_TILES_X * RED_TILES_Y; t++) {
+        if (_red_tiles[t]) free(_red_tiles[t]);
+        _red_tiles[t] = NULL;
+    }
+}
+
+uint16_t MT_EPD::redTileCount() {
+    uint16_t count = 0;
+    for (uint16_t t = 0; t < RED_TILES_X * RED_TILES_Y; t++) {
+        if (_red_tiles[t]) count++;
+    }
+    return count;
+}
+
+void MT_EPD::readRedRow(uint16_t y, uint8_t* out) {
+    uint8_t** tiles = &_red_tiles[(y / RED_TILE_ROWS) * RED_TILES_X];
+    uint16_t offset = (y % RED_TILE_ROWS) * RED_TILE_BYTES;
+    for (uint8_t tx = 0; tx < RED_TILES_X; tx++, out += RED_TILE_BYTES) {
+        if (tiles[tx]) memcpy(out, tiles[tx] + offset, RED_TILE_BYTES);
+        else memset(out, 0x00, RED_TILE_BYTES);
+    }
+}
+
+void MT_EPD::readColumn(uint8_t column, uint8_t* bw, uint8_t* red) {
+    uint8_t** tiles = &_red_tiles[column / RED_TILE_BYTES];
+    uint8_t inTile = column % RED_TILE_BYTES;
+    for (uint16_t y = 0; y < 480; y++) {
+        bw[y] = _buffer_bw[y * 100 + column];
+        const uint8_t* tile = tiles[(y / RED_TILE_ROWS) * RED_TILES_X];
+        red[y] = tile ? tile[(y % RED_TILE_ROWS) * RED_TILE_BYTES + inTile] : 0x00;
+    }
+}
+
+void MT_EPD::sendRedPlane() {
+    // Missing tiles go out as zeros, never touching memory
+    sendCommand(0x13);
+    for (uint16_t y = 0; y < 480; y++) {
+        uint8_t** tiles = &_red_tiles[(y / RED_TILE_ROWS) * RED_TILES_X];
+        uint16_t offset = (y % RED_TILE_ROWS) * RED_TILE_BYTES;
+        for (uint8_t tx = 0; tx < RED_TILES_X; tx++) {
+            const uint8_t* src = tiles[tx] ? tiles[tx] + offset : NULL;
+            for (uint8_t i = 0; i < RED_TILE_BYTES; i++) {
+                sendData(src ? src[i] : 0x00);
+            }
+        }
+        // Process system tasks every row (100 bytes)
+        yield();
+    }
+}
+#endif
+
+void MT_EPD::sendPlanes() {
+#if MT_EPD_BAND_MODE
+    sendCommand(0x10);
+    sendBands(false);
+    sendCommand(0x13);
+    sendBands(true);
+#else
+    // Send black/white buffer
+    sendCommand(0x10);
+    for (uint32_t i = 0; i < _buffer_size; i++) {
+        sendData(_buffer_bw[i]);
+        // Process system tasks every 100 bytes
+        if ((i % 100) == 0) yield();
+    }
+    
+    // Send red buffer
+    sendRedPlane();
+#endif
 }
 
 void MT_EPD::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, 
                          int16_t w, int16_t h, uint16_t color, uint16_t bg_color) {
+#if MT_EPD_BAND_MODE
+    if (recording()) {
+        // Only the pointer is kept, so the bitmap has to outlive the upload
+        DrawOp* op = beginOp(OP_BITMAP, x, y, color);
+        if (op) {
+            op->w = w;
+            op->h = h;
+            op->bg = bg_color;
+            op->ptr = bitmap;
+        }
+        drawBitmap(x, y, bitmap, w, h, color, bg_color);  // dry run: records the rows
+        endOp();
+        return;
+    }
+#endif
+
     // Iterate through each row
     for (int16_t j = 0; j < h; j++) {
         // Iterate through each byte in the row
@@ -171,6 +543,400 @@ void MT_EPD::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
     }
 }
 
+void MT_EPD::drawNativeBitmap(int16_t x, int16_t y, const NativeBitmap& bitmap,
+                              uint16_t color, uint16_t bg_color) {
+#if MT_EPD_BAND_MODE
+    if (recording()) {
+        // Only the pointer is kept, so the bitmap has to outlive the upload
+        DrawOp* op = beginOp(OP_NATIVE, x, y, color);
+        if (op) {
+            op->bg = bg_color;
+            op->ptr = &bitmap;
+        }
+        drawNativeBitmap(x, y, bitmap, color, bg_color);  // dry run: records the rows
+        endOp();
+        return;
+    }
+#else
+    if (color == EPD_BLACK && bg_color == EPD_WHITE && blitNativeBitmap(x, y, bitmap)) return;
+#endif
+
+    // Same pixels drawBitmap() would set, read out of the native rows
+    for (int16_t j = 0; j < bitmap.height; j++) {
+        for (int16_t i = 0; i < bitmap.width; i++) {
+            drawPixel(x + i, y + j, nativeBit(bitmap, i, j) ? color : bg_color);
+        }
+    }
+}
+
+bool MT_EPD::nativeBit(const NativeBitmap& bitmap, int16_t i, int16_t j) {
+    // Stored row and bit of logical pixel (i, j); see Scripts/imagegen.py
+    uint16_t row, bit, rowBits;
+    switch (bitmap.rotation) {
+        case 1:  row = i; bit = bitmap.height - 1 - j; rowBits = bitmap.height; break;
+        case 2:  row = bitmap.height - 1 - j; bit = bitmap.width - 1 - i; rowBits = bitmap.width; break;
+        case 3:  row = bitmap.width - 1 - i; bit = j; rowBits = bitmap.height; break;
+        default: row = j; bit = i; rowBits = bitmap.width; break;
+    }
+    uint8_t b = pgm_read_byte(&bitmap.bitmap[row * ((rowBits + 7) / 8) + bit / 8]);
+    return b & (0x80 >> (bit % 8));
+}
+
+size_t MT_EPD::write(uint8_t c) {
+#if MT_EPD_BAND_MODE
+    if (recording()) return recordChar(c);
+#endif
+    return writeChar(c);
+}
+
+size_t MT_EPD::writeChar(uint8_t c) {
+    return _spanFont ? writeSpanChar(c) : Adafruit_GFX::write(c);
+}
+
+uint8_t MT_EPD::currentYAdvance() {
+    if (_spanFont) return _spanFont->yAdvance;
+    return gfxFont ? (uint8_t)pgm_read_byte(&gfxFont->yAdvance) : 8;
+}
+
+size_t MT_EPD::writeSpanChar(uint8_t c) {
+    const SpanFont& font = *_spanFont;
+    
+    // Mirrors Adafruit_GFX::write() for GFX fonts
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += (int16_t)textsize_y * font.yAdvance;
+    } else if (c != '\r' && c >= font.first && c <= font.last) {
+        const SpanGlyph& glyph = font.glyph[c - font.first];
+        if (glyph.width > 0 && glyph.height > 0) {
+            if (wrap && ((cursor_x + textsize_x * (glyph.xOffset + glyph.width)) > width())) {
+                cursor_x = 0;
+                cursor_y += (int16_t)textsize_y * font.yAdvance;
+            }
+            drawSpanChar(cursor_x, cursor_y, font, glyph, textcolor, textsize_x, textsize_y);
+        }
+        cursor_x += glyph.xAdvance * (int16_t)textsize_x;
+    }
+    return 1;
+}
+
+void MT_EPD::drawSpanChar(int16_t x, int16_t y, const SpanFont& font, const SpanGlyph& glyph,
+                          uint16_t color, uint8_t sizeX, uint8_t sizeY) {
+    const uint8_t* p = font.spans + glyph.spanOffset;
+    const uint8_t* column = p;  // count byte of the last column spelled out
+    
+    uint8_t col = 0;
+    while (col < glyph.width) {
+        uint8_t code = pgm_read_byte(p);
+        uint8_t times = 1;
+        if (code & 0x80) {
+            // Repeat the previous column
+            times = code & 0x7F;
+            p++;
+        } else {
+            column = p;
+            p += 1 + 2 * code;
+        }
+        
+        uint8_t runs = pgm_read_byte(column);
+        for (; times > 0 && col < glyph.width; times--, col++) {
+            for (uint8_t r = 0; r < runs; r++) {
+                uint8_t start = pgm_read_byte(column + 1 + 2 * r);
+                uint8_t len = pgm_read_byte(column + 2 + 2 * r);
+                drawSpan(x + (glyph.xOffset + col) * sizeX, y + (glyph.yOffset + start) * sizeY,
+                         len, color, sizeX, sizeY);
+            }
+        }
+    }
+}
+
+void MT_EPD::drawSpan(int16_t x, int16_t y, int16_t len, uint16_t color, uint8_t sizeX, uint8_t sizeY) {
+#if !MT_EPD_BAND_MODE
+    if (_buffer_bw && getRotation() == 1 && sizeX == 1 && sizeY == 1) {
+        // A logical column run is one stretch of a physical row
+        fillNativeSpan(x, WIDTH - 1 - (y + len - 1), WIDTH - 1 - y, color);
+        return;
+    }
+#endif
+    // Same pixels GFX's drawChar() would set for this run
+    if (sizeX == 1 && sizeY == 1) {
+        drawFastVLine(x, y, len, color);
+    } else {
+        fillRect(x, y, sizeX, len * sizeY, color);
+    }
+}
+
+size_t MT_EPD::printNative(const NativeFont& font, const char* text) {
+#if MT_EPD_BAND_MODE
+    bool native = false;  // no planes to copy into; the display list records print()
+#else
+    // The atlas only holds black, size 1, rotation 1 glyphs of its source font
+    bool native = _buffer_bw && getRotation() == 1 && currentFont() == font.source &&
+                  textcolor == EPD_BLACK && textsize_x == 1 && textsize_y == 1;
+#endif
+    
+    size_t n = 0;
+    for (const char* p = text; *p; p++, n++) {
+        const char* slot = native ? strchr(font.chars, *p) : NULL;
+        if (!slot) {
+            write(*p);
+            continue;
+        }
+        
+#if !MT_EPD_BAND_MODE
+        const NativeGlyph& glyph = font.glyph[slot - font.chars];
+        if (glyph.width > 0 && glyph.height > 0) {
+            // Same wrap rule as Adafruit_GFX::write()
+            if (wrap && (cursor_x + glyph.xOffset + glyph.width) > width()) {
+                cursor_x = 0;
+                cursor_y += currentYAdvance();
+            }
+            // Glyphs hanging off the panel need drawPixel()'s clipping
+            if (blitNativeGlyph(font, glyph)) {
+                // done
+            } else if (_spanFont) {
+                drawSpanChar(cursor_x, cursor_y, *_spanFont, _spanFont->glyph[*p - _spanFont->first],
+                             textcolor, 1, 1);
+            } else {
+                drawChar(cursor_x, cursor_y, *p, textcolor, textbgcolor, 1);
+            }
+        }
+        cursor_x += glyph.xAdvance;
+#endif
+    }
+    return n;
+}
+
+#if !MT_EPD_BAND_MODE
+bool MT_EPD::blitNativeGlyph(const NativeFont& font, const NativeGlyph& glyph) {
+    // Rotation 1: logical column -> physical row, logical row -> 799 - x
+    int16_t top = cursor_y + glyph.yOffset;
+    int16_t px0 = WIDTH - 1 - (top + glyph.height - 1);  // physical x of the glyph's bottom
+    int16_t py0 = cursor_x + glyph.xOffset;              // physical row of its first column
+    if (px0 < 0 || px0 + glyph.height > WIDTH || py0 < 0 || py0 + glyph.width > HEIGHT) return false;
+    
+    uint8_t rowBytes = (glyph.height + 7) / 8;
+    uint8_t shift = px0 & 7;
+    const uint8_t* src = font.bitmap + glyph.bitmapOffset;
+    
+    for (uint8_t i = 0; i < glyph.width; i++) {
+        uint32_t row_idx = (uint32_t)(py0 + i) * 100 + (px0 / 8);
+        for (uint8_t b = 0; b < rowBytes; b++) {
+            uint8_t bits = pgm_read_byte(src++);
+            if (!bits) continue;
+            // A source byte straddles two plane bytes unless px0 is byte aligned
+            paintBits(row_idx + b, bits >> shift, EPD_BLACK);
+            if (shift) paintBits(row_idx + b + 1, (uint8_t)(bits << (8 - shift)), EPD_BLACK);
+        }
+    }
+    return true;
+}
+
+void MT_EPD::fillNativeSpan(int16_t py, int16_t px_first, int16_t px_last, uint16_t color) {
+    // Same clipping drawPixel() would do, pixel by pixel
+    if (_capture && (py < 0 || py >= HEIGHT || px_first < 0 || px_last > WIDTH - 1)) {
+        _capture->valid = false;
+    }
+    if (py < 0 || py >= HEIGHT) return;
+    if (px_first < 0) px_first = 0;
+    if (px_last > WIDTH - 1) px_last = WIDTH - 1;
+    if (px_first > px_last) return;
+    
+    uint32_t row_idx = (uint32_t)py * 100;
+    uint8_t first_byte = px_first / 8;
+    uint8_t last_byte = px_last / 8;
+    for (uint8_t b = first_byte; b <= last_byte; b++) {
+        uint8_t mask = 0xFF;
+        if (b == first_byte) mask &= 0xFF >> (px_first % 8);
+        if (b == last_byte) mask &= 0xFF << (7 - px_last % 8);
+        paintBits(row_idx + b, mask, color);
+    }
+}
+
+void MT_EPD::paintBits(uint32_t byte_idx, uint8_t mask, uint16_t color) {
+    if (!mask) return;
+    if (_capture) {
+        captureBits(byte_idx, mask, color);
+        return;
+    }
+    
+    // Same colour rules as drawPixel(), for up to 8 pixels at once
+    uint16_t y = byte_idx / 100;
+    uint8_t xb = byte_idx % 100;
+    uint8_t* red = redTile(xb * 8, y, color == EPD_RED);
+    if (red) red += (y % RED_TILE_ROWS) * RED_TILE_BYTES + xb % RED_TILE_BYTES;
+    
+    if (color == EPD_BLACK) {
+        _buffer_bw[byte_idx] &= ~mask;
+        if (red) *red &= ~mask;
+    }
+    else if (color == EPD_RED) {
+        _buffer_bw[byte_idx] |= mask;
+        if (red) *red |= mask;
+    }
+    else { // white
+        _buffer_bw[byte_idx] |= mask;
+        if (red) *red &= ~mask;
+    }
+}
+
+void MT_EPD::captureBits(uint32_t byte_idx, uint8_t mask, uint16_t color) {
+    PlaneTile& tile = *_capture;
+    int16_t y = byte_idx / 100;
+    int16_t xb = byte_idx % 100;
+    
+    // Bits of this plane byte that are inside the rect
+    uint8_t inside = 0;
+    if (y >= tile.row0 && y < tile.row0 + tile.rows && xb >= tile.col0 && xb < tile.col0 + tile.cols) {
+        inside = 0xFF;
+        if (xb == tile.col0) inside &= 0xFF >> (tile.pxFirst % 8);
+        if (xb == tile.col0 + tile.cols - 1) inside &= 0xFF << (7 - tile.pxLast % 8);
+    }
+    
+    // Anything drawTile() couldn't replay spoils the tile
+    if ((mask & ~inside) || color == EPD_RED || (color != EPD_BLACK && tile.mode == TILE_BLACK)) {
+        tile.valid = false;
+        return;
+    }
+    
+    uint8_t* p = tile.data + (y - tile.row0) * tile.cols + (xb - tile.col0);
+    if (color == EPD_BLACK) *p &= ~mask;
+    else *p |= mask;
+}
+
+void MT_EPD::writeBits(uint32_t byte_idx, uint8_t mask, uint8_t bits) {
+    // Black where bits is 0, white where it's 1, for the pixels in mask;
+    // a faster paintBits() pair for the black-and-white blits
+    if (!mask) return;
+    if (_capture) {
+        if (mask & ~bits) captureBits(byte_idx, mask & ~bits, EPD_BLACK);
+        if (mask & bits) captureBits(byte_idx, mask & bits, EPD_WHITE);
+        return;
+    }
+    
+    _buffer_bw[byte_idx] = (_buffer_bw[byte_idx] & ~mask) | (bits & mask);
+    uint16_t y = byte_idx / 100;
+    uint8_t xb = byte_idx % 100;
+    uint8_t* red = redTile(xb * 8, y, false);
+    if (red) red[(y % RED_TILE_ROWS) * RED_TILE_BYTES + xb % RED_TILE_BYTES] &= ~mask;
+}
+
+bool MT_EPD::blitNativeBitmap(int16_t x, int16_t y, const NativeBitmap& bitmap) {
+    if (!_buffer_bw || bitmap.rotation != 1 || getRotation() != 1) return false;
+    
+    // Rotation 1: stored row i is physical row x + i; bit k is physical x px0 + k
+    int16_t px0 = WIDTH - 1 - (y + bitmap.height - 1);
+    int16_t first = px0 < 0 ? 0 : px0;
+    int16_t last = px0 + bitmap.height - 1;
+    if (last > WIDTH - 1) last = WIDTH - 1;
+    if (first > last) return true;  // entirely off the panel
+    
+    int16_t rowBytes = (bitmap.height + 7) / 8;
+    for (int16_t i = 0; i < bitmap.width; i++) {
+        int16_t py = x + i;
+        if (py < 0 || py >= HEIGHT) continue;
+        const uint8_t* src = bitmap.bitmap + i * rowBytes;
+        uint32_t row_idx = (uint32_t)py * 100;
+        
+        for (int16_t b = first / 8; b <= last / 8; b++) {
+            // The 8 stored bits landing in plane byte b, zero past either end
+            int16_t off = b * 8 - px0;
+            int16_t c = off >> 3;
+            uint8_t shift = off & 7;
+            uint8_t lo = (c >= 0 && c < rowBytes) ? pgm_read_byte(src + c) : 0;
+            uint8_t hi = (c + 1 >= 0 && c + 1 < rowBytes) ? pgm_read_byte(src + c + 1) : 0;
+            uint8_t bits = shift ? (uint8_t)((lo << shift) | (hi >> (8 - shift))) : lo;
+            
+            uint8_t mask = 0xFF;
+            if (b == first / 8) mask &= 0xFF >> (first % 8);
+            if (b == last / 8) mask &= 0xFF << (7 - last % 8);
+            writeBits(row_idx + b, mask, ~bits);  // set bits are black
+        }
+    }
+    return true;
+}
+
+uint8_t MT_EPD::tileByte(const PlaneTile& tile, const uint8_t* row, int16_t px) {
+    // The 8 tile pixels starting at physical x = px; white outside the tile
+    int16_t c = (px >> 3) - tile.col0;
+    uint8_t shift = px & 7;
+    uint8_t lo = (c >= 0 && c < tile.cols) ? row[c] : 0xFF;
+    if (!shift) return lo;
+    uint8_t hi = (c + 1 >= 0 && c + 1 < tile.cols) ? row[c + 1] : 0xFF;
+    return (uint8_t)((lo << shift) | (hi >> (8 - shift)));
+}
+#endif
+
+#if MT_EPD_BAND_MODE
+// Nothing is rasterized until displayAsync(), so there is nothing to capture
+bool MT_EPD::beginTile(PlaneTile&, uint8_t*, uint16_t, int16_t, int16_t, int16_t, int16_t, uint8_t) {
+    return false;
+}
+
+bool MT_EPD::endTile() {
+    return false;
+}
+
+void MT_EPD::drawTile(const PlaneTile&, int16_t) {
+}
+#else
+bool MT_EPD::beginTile(PlaneTile& tile, uint8_t* data, uint16_t capacity,
+                       int16_t x, int16_t y, int16_t w, int16_t h, uint8_t mode) {
+    if (!_buffer_bw || _capture || getRotation() != 1 || w <= 0 || h <= 0) return false;
+    
+    // Rotation 1: logical columns x.. are physical rows, logical rows y.. end at 799 - y
+    tile.row0 = x;
+    tile.rows = w;
+    tile.pxFirst = WIDTH - 1 - (y + h - 1);
+    tile.pxLast = WIDTH - 1 - y;
+    tile.col0 = (tile.pxFirst >> 3) & 0xFF;
+    tile.cols = (tile.pxLast >> 3) - (tile.pxFirst >> 3) + 1;
+    if (tile.pxFirst < 0 || (uint32_t)tile.rows * tile.cols > capacity) return false;
+    
+    tile.data = data;
+    tile.capacity = capacity;
+    tile.mode = mode;
+    tile.valid = true;
+    memset(data, 0xFF, (uint32_t)tile.rows * tile.cols);
+    _capture = &tile;
+    return true;
+}
+
+bool MT_EPD::endTile() {
+    if (!_capture) return false;
+    bool valid = _capture->valid;
+    _capture = NULL;
+    return valid;
+}
+
+void MT_EPD::drawTile(const PlaneTile& tile, int16_t dy) {
+    if (!_buffer_bw || _capture || !tile.valid) return;
+    
+    // Moving down the screen is moving to lower physical x; clip like drawPixel()
+    int16_t first = tile.pxFirst - dy;
+    int16_t last = tile.pxLast - dy;
+    if (first < 0) first = 0;
+    if (last > WIDTH - 1) last = WIDTH - 1;
+    if (first > last) return;
+    
+    for (uint16_t r = 0; r < tile.rows; r++) {
+        int16_t py = tile.row0 + r;
+        if (py < 0 || py >= HEIGHT) continue;
+        const uint8_t* row = tile.data + r * tile.cols;
+        uint32_t row_idx = (uint32_t)py * 100;
+        
+        for (int16_t b = first / 8; b <= last / 8; b++) {
+            uint8_t bits = tileByte(tile, row, b * 8 + dy);
+            uint8_t mask = 0xFF;
+            if (b == first / 8) mask &= 0xFF >> (first % 8);
+            if (b == last / 8) mask &= 0xFF << (7 - last % 8);
+            
+            // Black pixels are set in both modes; only a copy also restores white
+            writeBits(row_idx + b, tile.mode == TILE_COPY ? mask : (uint8_t)(mask & ~bits), bits);
+        }
+    }
+}
+#endif
+
 void MT_EPD::setDisplayOrientation(uint8_t orientation) {
     _orientation = orientation & 3;  // 0-3
     
@@ -186,15 +952,22 @@ void MT_EPD::setDisplayOrientation(uint8_t orientation) {
 }
 
 void MT_EPD::clearDisplay(void) {
-    Serial.println("Clearing display...");
+    if (_verbose) LOG_DEBUG("Clearing display...");
     
-    if (!_buffer_bw || !_buffer_red) return;
+#if MT_EPD_BAND_MODE
+    // An empty display list is an all-white frame
+    _opCount = 0;
+    _textUsed = 0;
+    _opOverflow = false;
+#else
+    if (!_buffer_bw) return;
     
     // Fill black/white buffer with white (0xFF)
     memset(_buffer_bw, 0xFF, _buffer_size);
     
-    // Fill red buffer with no red (0x00)
-    memset(_buffer_red, 0x00, _buffer_size);
+    // No red: drop every red tile
+    freeRedTiles();
+#endif
 }
 
 void MT_EPD::drawBox(int x_start, int y_start, int width, int height, uint16_t color) {
@@ -203,34 +976,33 @@ void MT_EPD::drawBox(int x_start, int y_start, int width, int height, uint16_t c
 }
 
 void MT_EPD::display(void) {
-    Serial.println("Updating display...");
+    displayAsync();
+    waitUntilIdle();
+}
+
+void MT_EPD::displayAsync(void) {
+    if (_verbose) LOG_DEBUG("Updating display...");
     
-    if (!_buffer_bw || !_buffer_red) return;
+#if !MT_EPD_BAND_MODE
+    if (!_buffer_bw) return;
+#endif
     
-    // Send black/white buffer
-    sendCommand(0x10);
-    for (uint32_t i = 0; i < _buffer_size; i++) {
-        sendData(_buffer_bw[i]);
-        // Process system tasks every 100 bytes
-        if ((i % 100) == 0) yield();
-    }
+    // The controller ignores RAM writes while it's refreshing
+    if (isBusy()) waitUntilIdle();
     
-    // Send red buffer
-    sendCommand(0x13);
-    for (uint32_t i = 0; i < _buffer_size; i++) {
-        sendData(_buffer_red[i]);
-        // Process system tasks every 100 bytes
-        if ((i % 100) == 0) yield();
-    }
+    sendPlanes();
     
-    // Update display
+    // Start the refresh; the panel now holds this frame in its own RAM
     sendCommand(0x12);
-    waitUntilIdle();
+}
+
+bool MT_EPD::isBusy(void) {
+    return digitalRead(_busy_pin) == HIGH;
 }
 
 
 void MT_EPD::sleep(void) {
-    Serial.println("Entering sleep mode...");
+    if (_verbose) LOG_DEBUG("Entering sleep mode...");
     sendCommand(0x02);    // Power off
     waitUntilIdle();
     sendCommand(0x07);    // Deep sleep
@@ -238,7 +1010,7 @@ void MT_EPD::sleep(void) {
 }
 
 void MT_EPD::reset(void) {
-    Serial.println("Resetting...");
+    if (_verbose) LOG_DEBUG("Resetting...");
     digitalWrite(_rst_pin, HIGH);
     delay(10);
     digitalWrite(_rst_pin, LOW);
@@ -262,11 +1034,11 @@ void MT_EPD::sendData(uint8_t data) {
 }
 
 void MT_EPD::waitUntilIdle(void) {
-    Serial.println("Waiting for busy signal...");
+    if (_verbose) LOG_DEBUG("Waiting for busy signal...");
     while(digitalRead(_busy_pin) == HIGH) {
         delay(100);
     }
-    Serial.println("Busy signal cleared");
+    if (_verbose) LOG_DEBUG("Busy signal cleared");
 }
 
 void MT_EPD::writeRAM(uint16_t xSize, uint16_t ySize, uint8_t* buffer, uint16_t offset, uint8_t command) {
@@ -319,7 +1091,7 @@ void MT_EPD::updatePartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     uint8_t* partialBuffer = createPartialBuffer(x, y, w, h, &bufferSize);
     
     if (!partialBuffer) {
-        Serial.println("Failed to create partial buffer");
+        LOG_WARN("Failed to create partial buffer");
         return;
     }
     
@@ -365,6 +1137,9 @@ void MT_EPD::updatePartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 }
 
 uint8_t* MT_EPD::createPartialBuffer(uint16_t x, uint16_t y, uint16_t w, uint16_t h, size_t* bufferSize) {
+    // Needs the B/W plane, which band mode doesn't have
+    if (!_buffer_bw) return NULL;
+    
     // Calculate buffer size for the region (bytes)
     // Round up width to nearest byte boundary (8 pixels)
     uint16_t widthBytes = (w + 7) / 8;
@@ -411,19 +1186,7 @@ uint8_t* MT_EPD::createPartialBuffer(uint16_t x, uint16_t y, uint16_t w, uint16_
 }
 
 void MT_EPD::displayPartial() {
-    // Send black/white buffer
-    sendCommand(0x10);
-    for (uint32_t i = 0; i < _buffer_size; i++) {
-        sendData(_buffer_bw[i]);
-        if ((i % 100) == 0) yield();
-    }
-    
-    // Send red buffer
-    sendCommand(0x13);
-    for (uint32_t i = 0; i < _buffer_size; i++) {
-        sendData(_buffer_red[i]);
-        if ((i % 100) == 0) yield();
-    }
+    sendPlanes();
     
     // Display update
     sendCommand(0x12); // DISPLAY_REFRESH
@@ -7,6 +7,84 @@
 #include <SPI.h>
 #include <Adafruit_GFX.h>
 
+// Band mode: 1 drops the 96 KB of planes. Drawing calls are recorded into a
+// small display list instead, and displayAsync() rasterizes that list
+// BAND_ROWS physical rows at a time straight into the panel's RAM. Output is
+// byte-identical to the plane path; the cost is re-running the draw calls
+// once per band they touch, twice (B/W pass, red pass).
+#ifndef MT_EPD_BAND_MODE
+#define MT_EPD_BAND_MODE 0
+#endif
+
+// A GFX glyph re-packed in the panel's native layout for rotation 1, by
+// Scripts/fontatlas.py. Each stored row is one physical row (one logical
+// column of the glyph); bit k is physical x = glyph bottom + k, so a row
+// shifts straight into the B/W plane.
+typedef struct {
+    uint16_t bitmapOffset;
+    uint8_t width;       // logical width = physical rows
+    uint8_t height;      // logical height = bits per physical row
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} NativeGlyph;
+
+typedef struct {
+    const uint8_t* bitmap;
+    const NativeGlyph* glyph;
+    const char* chars;        // characters in the atlas, in glyph order
+    const void* source;       // the GFXfont or SpanFont it matches
+} NativeFont;
+
+// A glyph in a span font (Scripts/fontcompile.py): GFXglyph's metrics, with
+// the bitmap replaced by runs of set pixels, column by column. Per column:
+// a run count n (< 0x80) then n (start row, length) pairs, or 0x80 | k for
+// "the previous column, k more times".
+typedef struct {
+    uint16_t spanOffset;
+    uint8_t width;
+    uint8_t height;
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} SpanGlyph;
+
+typedef struct {
+    const uint8_t* spans;
+    const SpanGlyph* glyph;
+    uint8_t first;            // glyph[0] is this character
+    uint8_t last;
+    uint8_t yAdvance;
+} SpanFont;
+
+// A bitmap stored the way the panel scans it for one rotation, by
+// Scripts/imagegen.py --native. Stored rows are physical rows, in
+// increasing order, each ceil(bits per row / 8) bytes, MSB first along
+// physical x. Under rotation 1 a stored row is one logical column of the
+// image, bit k being logical row height - 1 - k.
+typedef struct {
+    const uint8_t* bitmap;
+    uint16_t width;       // logical size
+    uint16_t height;
+    uint8_t rotation;     // the setRotation() it was packed for
+} NativeBitmap;
+
+// A rectangle of drawing captured in the panel's native layout, so it can
+// be pasted back later with a few byte ops per physical row. The storage
+// belongs to the caller; beginTile() fills in the rest.
+typedef struct {
+    uint8_t* data;        // rows x cols bytes, B/W plane layout
+    uint16_t capacity;
+    int16_t row0;         // first physical row
+    uint16_t rows;
+    int16_t pxFirst;      // physical x range the rect covers
+    int16_t pxLast;
+    uint8_t col0;         // plane bytes covering pxFirst..pxLast
+    uint8_t cols;
+    uint8_t mode;         // MT_EPD::TILE_COPY or MT_EPD::TILE_BLACK
+    bool valid;
+} PlaneTile;
+
 class MT_EPD : public Adafruit_GFX {
   public:
     MT_EPD(int8_t cs, int8_t dc, int8_t rst, int8_t busy);
@@ -15,6 +93,20 @@ class MT_EPD : public Adafruit_GFX {
     void begin();
     void clearDisplay();
     void display();
+
+    /**
+    * Uploads both planes and starts the refresh, without waiting for it to
+    * finish. The panel keeps its own copy of the frame, so the planes are
+    * free to draw the next frame as soon as this returns. Waits first if a
+    * previous refresh is still running.
+    */
+    void displayAsync();
+
+    /**
+    * @return true while the panel is refreshing (BUSY pin high)
+    */
+    bool isBusy();
+
     void sleep();
     void drawBox(int x_start, int y_start, int width, int height, uint16_t color);
     void sendCommand(uint8_t command);
@@ -25,6 +117,37 @@ class MT_EPD : public Adafruit_GFX {
     void setRotation(uint8_t r) override; // Add this in the public section
     void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, 
                 uint16_t color, uint16_t bg_color = EPD_WHITE);
+
+    /**
+    * Draws a panel-native bitmap: the same pixels as drawBitmap() of the
+    * image it was packed from. At its own rotation, on the panel, in black
+    * on white, each stored row is shifted straight into the B/W plane.
+    * Anything else goes pixel by pixel.
+    * @param x, y Logical top left
+    * @param bitmap Bitmap from imagegen.py; kept until the upload in band mode
+    * @param color Colour of set bits
+    * @param bg_color Colour of clear bits
+    */
+    void drawNativeBitmap(int16_t x, int16_t y, const NativeBitmap& bitmap,
+                          uint16_t color, uint16_t bg_color = EPD_WHITE);
+
+#if MT_EPD_BAND_MODE
+    // Recorded into the display list in band mode
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+
+    /**
+    * @return Number of draw operations recorded since the last clearDisplay()
+    */
+    uint16_t displayListOps() { return _opCount; }
+
+    /**
+    * @return true if the display list ran out of room since the last
+    * clearDisplay(); whatever didn't fit is missing from the frame
+    */
+    bool displayListOverflowed() { return _opOverflow; }
+#endif
     
     // Set physical display orientation
     void setDisplayOrientation(uint8_t orientation);
@@ -51,16 +174,117 @@ class MT_EPD : public Adafruit_GFX {
     uint8_t* createPartialBuffer(uint16_t x, uint16_t y, uint16_t w, uint16_t h, size_t* bufferSize);
 
     void waitUntilIdle();
+
+    /**
+    * Turns the progress messages on or off. They go through LOG_DEBUG
+    * (Log.h), which is safe from either core and compiled out above debug.
+    */
+    void setVerbose(bool verbose) { _verbose = verbose; }
+
+    /**
+    * Prints text from a pre-rotated atlas, a physical row of each glyph at a
+    * time instead of a drawPixel() per pixel. Same pixels and cursor
+    * movement as print() in the atlas's source font. Characters not in the
+    * atlas, and any state the atlas can't do (other colours, sizes,
+    * rotations, band mode), go through print() instead.
+    * @param font Atlas to draw from; its source font should be the current font
+    * @param text Characters to print
+    * @return Number of characters printed
+    */
+    size_t printNative(const NativeFont& font, const char* text);
+
+    /**
+    * Draws text with a span font instead of the GFX font. Each run of a
+    * glyph column is one fill -- under rotation 1, a few byte masks in one
+    * plane row. Same pixels and cursor movement as the GFX font it was
+    * compiled from. Unlike setFont() there is no 6 px baseline nudge, so
+    * set the cursor afterwards.
+    * @param font Span font, or NULL to go back to the GFX font
+    */
+    void setSpanFont(const SpanFont* font) { _spanFont = font; }
+
+    size_t write(uint8_t c) override;
+
+    /**
+    * Sends drawing into a tile instead of the planes, until endTile(). The
+    * tile can then be pasted with drawTile() for the same pixels as drawing
+    * it again. TILE_COPY replays every pixel drawn inside the rect (a bitmap
+    * with a background); TILE_BLACK only replays black pixels, and leaves the
+    * rest of the rect alone (text). Rotation 1 and the planes only.
+    * @param tile Tile to fill
+    * @param data Storage for the tile, kept until the tile is no longer used
+    * @param capacity Size of data in bytes
+    * @param x, y, w, h Logical rect the drawing should stay inside
+    * @param mode TILE_COPY or TILE_BLACK
+    * @return false if the tile can't be captured here; nothing was started
+    */
+    bool beginTile(PlaneTile& tile, uint8_t* data, uint16_t capacity,
+                   int16_t x, int16_t y, int16_t w, int16_t h, uint8_t mode);
+
+    /**
+    * Ends the capture started by beginTile().
+    * @return true if the tile holds everything that was drawn: no pixel
+    * fell outside the rect, no red, nothing but black in a TILE_BLACK tile
+    */
+    bool endTile();
+
+    /**
+    * Pastes a captured tile into the planes.
+    * @param tile Valid tile from beginTile()/endTile()
+    * @param dy Logical distance below the rect it was captured at
+    */
+    void drawTile(const PlaneTile& tile, int16_t dy);
+
+#if !MT_EPD_BAND_MODE
+    /**
+    * Copies one physical row (100 bytes) of the red plane, with zeros where
+    * no tile is allocated.
+    * @param y Physical row, 0-479
+    * @param out 100-byte destination
+    */
+    void readRedRow(uint16_t y, uint8_t* out);
+
+    /**
+    * Copies one byte column of both planes: physical x 8*column to
+    * 8*column+7, every row, the way they're packed in the row bytes.
+    * @param column Byte column, 0-99
+    * @param bw 480-byte destination for the black/white plane
+    * @param red 480-byte destination for the red plane (zeros where no tile)
+    */
+    void readColumn(uint8_t column, uint8_t* bw, uint8_t* red);
+
+    /**
+    * @return Number of red tiles currently allocated
+    */
+    uint16_t redTileCount();
+#endif
         
     static const uint16_t EPD_BLACK = 0x0000;
     static const uint16_t EPD_WHITE = 0xFFFF;
     static const uint16_t EPD_RED = 0xF800;
 
-    // Buffers for black/white and red planes
+    static const uint8_t TILE_COPY = 0;
+    static const uint8_t TILE_BLACK = 1;
+
+    // Red plane tiling: 80 px x 16 rows per tile, 10 x 30 tiles
+    static const uint8_t RED_TILE_BYTES = 10;
+    static const uint8_t RED_TILE_ROWS = 16;
+    static const uint8_t RED_TILES_X = 100 / RED_TILE_BYTES;
+    static const uint8_t RED_TILES_Y = 480 / RED_TILE_ROWS;
+
+    // Black/white plane (NULL in band mode)
     uint8_t* _buffer_bw;
-    uint8_t* _buffer_red;
     uint32_t _buffer_size;
 
+#if !MT_EPD_BAND_MODE
+    // Red plane. Red only shows up in a few places (the boot logo), so the
+    // plane is kept as tiles and a tile is only allocated once a red pixel
+    // lands in it; missing tiles are all zero. The allocation happens in
+    // drawPixel(), so red must only be drawn from core0 -- core1 stays off
+    // the heap. clearDisplay() frees every tile.
+    uint8_t* _red_tiles[RED_TILES_X * RED_TILES_Y];
+#endif
+
   private:
     int16_t _width;
     int16_t _height;
@@ -69,10 +293,81 @@ class MT_EPD : public Adafruit_GFX {
     int8_t _rst_pin;
     int8_t _busy_pin;
     uint8_t _orientation;  // Physical orientation
+    bool _verbose;
+    const SpanFont* _spanFont;
+
+    const void* currentFont() { return _spanFont ? (const void*)_spanFont : (const void*)gfxFont; }
+    uint8_t currentYAdvance();
+    size_t writeChar(uint8_t c);
+    size_t writeSpanChar(uint8_t c);
+    void drawSpanChar(int16_t x, int16_t y, const SpanFont& font, const SpanGlyph& glyph,
+                      uint16_t color, uint8_t sizeX, uint8_t sizeY);
+    void drawSpan(int16_t x, int16_t y, int16_t len, uint16_t color, uint8_t sizeX, uint8_t sizeY);
 
     void writeRAM(uint16_t xSize, uint16_t ySize, uint8_t* buffer, uint16_t offset, uint8_t command);
+#if MT_EPD_BAND_MODE
+    enum DrawOpType : uint8_t { OP_PIXEL, OP_RECT, OP_BITMAP, OP_TEXT, OP_NATIVE };
 
-    
+    // One recorded drawing call. rowMin/rowMax are the physical rows it
+    // touched when it was recorded, so bands it misses can skip it.
+    struct DrawOp {
+        uint8_t type;
+        uint8_t sizeX, sizeY;  // OP_TEXT: text size
+        uint8_t flags;         // OP_TEXT: TEXT_WRAP | TEXT_CP437 | TEXT_SPAN
+        uint16_t color;
+        uint16_t bg;           // OP_BITMAP/OP_NATIVE background, OP_TEXT background
+        int16_t x, y, w, h;    // OP_TEXT: cursor at the first character
+        const void* ptr;       // OP_BITMAP: bitmap, OP_NATIVE: NativeBitmap, OP_TEXT: GFXfont or SpanFont
+        uint16_t text;         // OP_TEXT: first character in _textPool
+        uint16_t textLen;
+        int16_t rowMin, rowMax;
+    };
+
+    static const uint8_t TEXT_WRAP = 0x01;
+    static const uint8_t TEXT_CP437 = 0x02;
+    static const uint8_t TEXT_SPAN = 0x04;
+
+    static const uint8_t BAND_ROWS = 16;
+    static const uint16_t BAND_BYTES = BAND_ROWS * 100;
+    static const uint8_t MAX_OPS = 96;         // a full arrivals frame uses ~40
+    static const uint16_t TEXT_POOL = 1024;
+
+    DrawOp _ops[MAX_OPS];
+    uint16_t _opCount;
+    char _textPool[TEXT_POOL];
+    uint16_t _textUsed;
+    int16_t _textEndX, _textEndY;  // cursor after the last recorded character
+    DrawOp* _recordOp;             // op whose rows the current dry run tracks
+    uint8_t _opDepth;              // >0 while a recorded call runs its dry run
+    bool _opOverflow;
+    bool _replaying;
+    int16_t _bandTop;              // first physical row of the band being rasterized
+    uint8_t _band_bw[BAND_BYTES];
+    uint8_t _band_red[BAND_BYTES];
+
+    // Not replaying, and not inside another recorded call
+    bool recording() { return !_replaying && _opDepth == 0; }
+    DrawOp* beginOp(uint8_t type, int16_t x, int16_t y, uint16_t color);
+    void endOp();
+    void replayOp(const DrawOp& op);
+    size_t recordChar(uint8_t c);
+    void sendBands(bool red);
+#else
+    uint8_t* redTile(int16_t x, int16_t y, bool create);
+    void freeRedTiles();
+    void sendRedPlane();
+    bool blitNativeGlyph(const NativeFont& font, const NativeGlyph& glyph);
+    void fillNativeSpan(int16_t py, int16_t px_first, int16_t px_last, uint16_t color);
+    void paintBits(uint32_t byte_idx, uint8_t mask, uint16_t color);
+    void captureBits(uint32_t byte_idx, uint8_t mask, uint16_t color);
+    void writeBits(uint32_t byte_idx, uint8_t mask, uint8_t bits);
+    bool blitNativeBitmap(int16_t x, int16_t y, const NativeBitmap& bitmap);
+    uint8_t tileByte(const PlaneTile& tile, const uint8_t* row, int16_t px);
+
+    PlaneTile* _capture;           // tile being drawn into, or NULL
+#endif
+    void sendPlanes();
+    bool nativeBit(const NativeBitmap& bitmap, int16_t i, int16_t j);
 
     void reset();
 };
@@ -0,0 +1,165 @@
+#include "MemStats.h"
+#include <malloc.h>
+
+#if MEM_STATS
+MemStats memStats;
+#endif
+
+// Stack regions from the SDK's linker script: core0 runs on the main stack
+// in scratch Y, core1 on the one in scratch X
+extern "C" uint32_t __StackBottom, __StackTop, __StackOneBottom, __StackOneTop;
+
+static const uint32_t STACK_PAINT = 0x5053544B;
+static const uint32_t PAINT_MARGIN = 256;  // bytes left alone below the caller's frame
+static volatile bool core1Painted = false;
+
+// Fills [bottom, caller's frame - PAINT_MARGIN) with STACK_PAINT
+static void __attribute__((noinline)) paint(uint32_t* bottom, uint32_t* top) {
+    uint32_t* limit = (uint32_t*)__builtin_frame_address(0) - PAINT_MARGIN / 4;
+    if (limit > top) limit = top;
+    for (uint32_t* p = bottom; p < limit; p++) *p = STACK_PAINT;
+}
+
+static MemStats::Stack watermark(const uint32_t* bottom, const uint32_t* top) {
+    const uint32_t* p = bottom;
+    while (p < top && *p == STACK_PAINT) p++;
+    MemStats::Stack stack;
+    stack.size = (top - bottom) * 4;
+    stack.peak = (top - p) * 4;
+    return stack;
+}
+
+MemStats::MemStats() : _failures(0) {
+    memset(&_heap, 0, sizeof(_heap));
+    memset(_phases, 0, sizeof(_phases));
+}
+
+void MemStats::begin() {
+    paint(&__StackBottom, &__StackTop);
+    sample();
+}
+
+void MemStats::paintCore1() {
+    paint(&__StackOneBottom, &__StackOneTop);
+    core1Painted = true;
+}
+
+MemStats::Stack MemStats::core0Stack() const {
+    return watermark(&__StackBottom, &__StackTop);
+}
+
+MemStats::Stack MemStats::core1Stack() const {
+    if (!core1Painted) {
+        Stack none = {0, 0};
+        return none;
+    }
+    return watermark(&__StackOneBottom, &__StackOneTop);
+}
+
+// The arena's high-water mark. Full newlib keeps it in usmblks (the arena
+// itself shrinks when the top is trimmed); newlib-nano leaves usmblks at 0
+// but never trims, so there the arena is its own high-water mark.
+static uint32_t arenaPeakOf(const struct mallinfo& info) {
+    return max((uint32_t)info.arena, (uint32_t)info.usmblks);
+}
+
+MemStats::Mark MemStats::mark() {
+    struct mallinfo info = mallinfo();
+    Mark mark;
+    mark.used = info.uordblks;
+    mark.arenaPeak = arenaPeakOf(info);
+    return mark;
+}
+
+void MemStats::note(Phase phase, const Mark& since) {
+    struct mallinfo info = mallinfo();
+    uint32_t used = info.uordblks;
+    uint32_t arenaPeak = arenaPeakOf(info);
+
+    PhaseMem& mem = _phases[phase];
+    mem.held = (int32_t)(used - since.used);
+    if (mem.held > mem.heldMax) mem.heldMax = mem.held;
+    if (arenaPeak > since.arenaPeak) mem.arenaRaised += arenaPeak - since.arenaPeak;
+
+    if (used > _heap.usedPeak) _heap.usedPeak = used;
+    if (arenaPeak > _heap.arenaPeak) _heap.arenaPeak = arenaPeak;
+}
+
+void MemStats::noteFailure(Phase phase, size_t size) {
+    _phases[phase].failures++;
+    _failures++;
+    Serial.print("MemStats: ");
+    Serial.print(size);
+    Serial.print(" byte allocation failed in ");
+    Serial.println(PhaseTimer::name(phase));
+}
+
+// Largest block malloc() would hand out, knowing the top of the arena plus
+// what's left to grow it gives at least topRun. Anything bigger must come from
+// a free chunk inside the arena, so only those sizes are probed, and a probe
+// never grows the arena.
+uint32_t MemStats::largestBlock(uint32_t topRun) const {
+    struct mallinfo info = mallinfo();
+    uint32_t binned = info.fordblks > info.keepcost ? info.fordblks - info.keepcost : 0;
+    uint32_t lo = topRun;  // fits
+    uint32_t hi = binned;  // may fit
+    while (hi > lo + 16) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        void* block = malloc(mid);
+        if (block) {
+            free(block);
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+const MemStats::Heap& MemStats::sample() {
+    struct mallinfo info = mallinfo();
+    _heap.total = rp2040.getTotalHeap();
+    _heap.used = info.uordblks;
+    _heap.free = _heap.total > _heap.used ? _heap.total - _heap.used : 0;
+    _heap.freeChunks = info.ordblks;
+    uint32_t arenaPeak = arenaPeakOf(info);
+    if (arenaPeak > _heap.arenaPeak) _heap.arenaPeak = arenaPeak;
+    if (_heap.used > _heap.usedPeak) _heap.usedPeak = _heap.used;
+
+    uint32_t unclaimed = _heap.total > (uint32_t)info.arena ? _heap.total - info.arena : 0;
+    _heap.largest = largestBlock(unclaimed + info.keepcost);
+    if (_heap.largest > _heap.free) _heap.largest = _heap.free;
+    _heap.fragmentation = _heap.free ? 100 - (uint8_t)((uint64_t)_heap.largest * 100 / _heap.free) : 0;
+    return _heap;
+}
+
+void MemStats::printLine(Print& out) {
+    sample();
+    Stack core0 = core0Stack();
+    Stack core1 = core1Stack();
+    char line[160];
+    int n = snprintf(line, sizeof(line),
+                     "Heap: %lu used (peak %lu, arena peak %lu), %lu free, largest %lu, %u%% fragmented; stack core0 %lu/%lu",
+                     (unsigned long)_heap.used, (unsigned long)_heap.usedPeak, (unsigned long)_heap.arenaPeak,
+                     (unsigned long)_heap.free, (unsigned long)_heap.largest, _heap.fragmentation,
+                     (unsigned long)core0.peak, (unsigned long)core0.size);
+    if (core1.size > 0 && n > 0 && (size_t)n < sizeof(line)) {
+        snprintf(line + n, sizeof(line) - n, ", core1 %lu/%lu",
+                 (unsigned long)core1.peak, (unsigned long)core1.size);
+    }
+    out.println(line);
+}
+
+void MemStats::report(Print& out) const {
+    out.print("Heap by phase (bytes): held last / held max / arena raised / failed allocations; ");
+    out.print(_failures);
+    out.println(" failed in all");
+    char line[64];
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+        const PhaseMem& mem = _phases[p];
+        if (mem.heldMax == 0 && mem.held == 0 && mem.arenaRaised == 0 && mem.failures == 0) continue;
+        snprintf(line, sizeof(line), "  %-10s %7ld %7ld %7lu %4u", PhaseTimer::name((Phase)p),
+                 (long)mem.held, (long)mem.heldMax, (unsigned long)mem.arenaRaised, mem.failures);
+        out.println(line);
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <Arduino.h>
+#include "PhaseTimer.h"
+
+// Heap and stack telemetry.
+//
+// Heap: newlib's mallinfo() gives the bytes in use, the free chunks and how
+// far the arena has ever been pushed (its high-water mark: the number that
+// runs into the stacks). The largest free block isn't in there, so sample()
+// finds it by bisecting with malloc()/free(). Fragmentation is the share of
+// free heap that isn't in that block.
+//
+// Per phase: MEM_MARK() before and MEM_NOTE() after a phase of the poll
+// cycle (the PhaseTimer phases) record what the phase left held, and how much
+// it raised the arena's high-water mark -- a peak inside the phase shows up
+// there even if it was freed before the phase ended. Allocation failures are
+// counted per phase as the code that allocates reports them.
+//
+// arduino-pico already wraps malloc()/free() (--wrap, for its lock) and a
+// sketch can't add a second wrapper, so there are no per-call counts; what
+// mallinfo() shows is what there is.
+//
+// Stacks: begin() and paintCore1() fill each core's unused stack with a
+// pattern, and the watermark is how much of it has been overwritten since.
+// Core1's stack is the SDK's (scratch X); core1 paints it itself from
+// setup1(), which touches no heap and no Serial.
+//
+// 1 keeps the telemetry in; 0 compiles MEM_MARK()/MEM_NOTE() out. Core0
+// only, except paintCore1().
+#ifndef MEM_STATS
+#define MEM_STATS 1
+#endif
+
+class MemStats {
+  public:
+    struct Heap {
+        uint32_t total;        // heap between the end of .bss and the stacks
+        uint32_t used;         // in malloc'd blocks
+        uint32_t free;         // total - used
+        uint32_t largest;      // largest block malloc() would hand out now
+        uint32_t arenaPeak;    // furthest the arena has ever reached
+        uint32_t usedPeak;     // most in use at any sample or note
+        uint16_t freeChunks;   // free chunks inside the arena
+        uint8_t fragmentation; // % of free that isn't in the largest block
+    };
+
+    struct Stack {
+        uint32_t size;
+        uint32_t peak;         // most ever used, from the paint
+    };
+
+    // What's been seen for one phase
+    struct PhaseMem {
+        int32_t held;          // net bytes the phase left allocated, last time
+        int32_t heldMax;
+        uint32_t arenaRaised;  // bytes it pushed the arena high-water up, in total
+        uint16_t failures;     // allocations that failed in it
+    };
+
+    // Heap state at the start of a phase
+    struct Mark {
+        uint32_t used;
+        uint32_t arenaPeak;
+    };
+
+    MemStats();
+
+    /**
+    * Paints core0's stack below the caller's frame. Call first thing in
+    * setup().
+    */
+    void begin();
+
+    /**
+    * Paints core1's stack below the caller's frame. Call from setup1().
+    */
+    static void paintCore1();
+
+    Mark mark();
+
+    /**
+    * Files what the heap did since mark under phase.
+    */
+    void note(Phase phase, const Mark& since);
+
+    /**
+    * Counts a failed allocation of size bytes against phase and prints it.
+    */
+    void noteFailure(Phase phase, size_t size);
+
+    /**
+    * Takes a full sample, including the largest-block probe.
+    */
+    const Heap& sample();
+
+    const Heap& heap() const { return _heap; }
+    Stack core0Stack() const;
+    Stack core1Stack() const;
+    const PhaseMem& phase(Phase phase) const { return _phases[phase]; }
+    uint32_t failures() const { return _failures; }
+
+    /**
+    * One line: heap, fragmentation and both stacks. Samples first.
+    */
+    void printLine(Print& out);
+
+    /**
+    * Per-phase table.
+    */
+    void report(Print& out) const;
+
+  private:
+    Heap _heap;
+    PhaseMem _phases[PHASE_COUNT];
+    uint32_t _failures;
+
+    uint32_t largestBlock(uint32_t limit) const;
+};
+
+#if MEM_STATS
+extern MemStats memStats;
+
+#define MEM_MARK(name) MemStats::Mark name = memStats.mark()
+#define MEM_NOTE(phase, since) memStats.note(phase, since)
+#else
+#define MEM_MARK(name)
+#define MEM_NOTE(phase, since)
+#endif
+
+#endif
@@ -0,0 +1,231 @@
+#include "MetricsServer.h"
+#include <stdarg.h>
+
+MetricsServer::MetricsServer(uint16_t port, Collector collect)
+    : _server(port), _collect(collect), _frame(NULL), _profile(NULL), _profiling(false),
+      _profileStart(false), _listening(false), _state(LISTEN),
+      _stateSince(0), _scrapes(0), _lineLen(0), _headLen(0), _bodyLen(0), _sent(0) {
+}
+
+void MetricsServer::begin() {
+    if (_listening) return;
+    _server.begin();
+    _listening = true;
+}
+
+void MetricsServer::close() {
+    _png.end();
+    _profiling = false;
+    _client.stop();
+    _state = LISTEN;
+}
+
+void MetricsServer::poll() {
+    if (!_listening) return;
+
+    switch (_state) {
+        case LISTEN:
+            _client = _server.accept();
+            if (!_client) return;
+            _lineLen = 0;
+            _stateSince = millis();
+            _state = REQUEST;
+            break;
+
+        case REQUEST: {
+            // Only the request line matters; the headers after it are left unread
+            size_t budget = sizeof(_line);
+            while (budget-- > 0 && _client.available()) {
+                int c = _client.read();
+                if (c < 0) break;
+                if (c == '\n') {
+                    _line[_lineLen] = '\0';
+                    startResponse();
+                    return;
+                }
+                if (c != '\r' && _lineLen < sizeof(_line) - 1) _line[_lineLen++] = (char)c;
+            }
+            if (!_client.connected() || millis() - _stateSince >= IDLE_TIMEOUT_MS) close();
+            break;
+        }
+
+        case RESPONSE: {
+            // A streamed body is refilled once the last slice is out
+            if (_sent >= _headLen + _bodyLen && streaming()) refill();
+
+            size_t total = _headLen + _bodyLen;
+            int room = _client.availableForWrite();
+            if (room > 0) {
+                size_t want = min(min((size_t)room, (size_t)WRITE_SLICE), total - _sent);
+                const char* from = _sent < _headLen ? _head + _sent : _body + (_sent - _headLen);
+                if (_sent < _headLen) want = min(want, _headLen - _sent);
+                size_t n = _client.write((const uint8_t*)from, want);
+                if (n > 0) {
+                    _sent += n;
+                    _stateSince = millis();
+                }
+            }
+            if (_sent >= total && !streaming()) {
+                _client.flush();
+                close();
+            } else if (!_client.connected() || millis() - _stateSince >= IDLE_TIMEOUT_MS) {
+                close();
+            }
+            break;
+        }
+    }
+}
+
+// Replaces the body, all sent, with the next slice of the streamed one
+void MetricsServer::refill() {
+    if (!_png.done()) {
+        _bodyLen = _png.read((uint8_t*)_body, sizeof(_body));
+    } else {
+        _bodyLen = _profile((uint8_t*)_body, sizeof(_body), _profileStart);
+        _profileStart = false;
+        if (_bodyLen == 0) _profiling = false;
+    }
+    _headLen = 0;
+    _sent = 0;
+    _stateSince = millis();
+}
+
+// Whether the request line is a GET of path (with or without a version)
+static bool requested(const char* line, const char* path) {
+    if (strncmp(line, "GET ", 4) != 0) return false;
+    size_t n = strlen(path);
+    return strncmp(line + 4, path, n) == 0 && (line[4 + n] == ' ' || line[4 + n] == '\0');
+}
+
+// Builds the whole response for the request line in _line, or just its head
+// when the body is streamed
+void MetricsServer::startResponse() {
+    const char* status;
+    const char* type = "text/plain; version=0.0.4";
+    bool streamed = false;
+    if (requested(_line, "/metrics")) {
+        // The collector stops short of the end, so there's always room to say
+        // whether it was cut off
+        MetricsWriter out(_body, sizeof(_body) - TRAILER_ROOM);
+        _collect(out);
+        MetricsWriter trailer(_body + out.length(), sizeof(_body) - out.length());
+        trailer.family("nextbus_metrics_truncated", "gauge", "1 if the metrics didn't fit the response buffer");
+        trailer.value("nextbus_metrics_truncated", (uint32_t)(out.truncated() ? 1 : 0));
+        _bodyLen = out.length() + trailer.length();
+        status = "200 OK";
+        _scrapes++;
+    } else if (requested(_line, "/frame.png") && _frame && _frame(_png)) {
+        _bodyLen = 0;
+        status = "200 OK";
+        type = "image/png";
+        streamed = true;
+    } else if (requested(_line, "/profile") && _profile) {
+        _bodyLen = 0;
+        status = "200 OK";
+        type = "application/octet-stream";
+        streamed = true;
+        _profiling = true;
+        _profileStart = true;
+    } else if (requested(_line, "/frame.png") && _frame) {
+        static const char NO_FRAME[] = "No frame to show (out of heap?)\n";
+        memcpy(_body, NO_FRAME, sizeof(NO_FRAME) - 1);
+        _bodyLen = sizeof(NO_FRAME) - 1;
+        status = "503 Service Unavailable";
+    } else {
+        static const char NOT_FOUND[] = "Try /metrics\n";
+        memcpy(_body, NOT_FOUND, sizeof(NOT_FOUND) - 1);
+        _bodyLen = sizeof(NOT_FOUND) - 1;
+        status = "404 Not Found";
+    }
+
+    int n;
+    if (streamed) {
+        n = snprintf(_head, sizeof(_head),
+                     "HTTP/1.1 %s\r\nContent-Type: %s\r\n"
+                     "Cache-Control: no-store\r\nConnection: close\r\n\r\n",
+                     status, type);
+    } else {
+        n = snprintf(_head, sizeof(_head),
+                     "HTTP/1.1 %s\r\nContent-Type: %s\r\n"
+                     "Content-Length: %u\r\nConnection: close\r\n\r\n",
+                     status, type, (unsigned)_bodyLen);
+    }
+    _headLen = (n > 0 && (size_t)n < sizeof(_head)) ? n : 0;
+    _sent = 0;
+    _stateSince = millis();
+    _state = RESPONSE;
+}
+
+MetricsWriter::MetricsWriter(char* buffer, size_t capacity)
+    : _buffer(buffer), _capacity(capacity), _length(0), _truncated(false) {
+}
+
+// Appends one formatted line, or nothing (and sets _truncated) if it won't fit
+void MetricsWriter::line(const char* format, ...) {
+    if (_truncated) return;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(_buffer + _length, _capacity - _length, format, args);
+    va_end(args);
+    if (n < 0 || (size_t)n >= _capacity - _length) {
+        _truncated = true;
+        return;
+    }
+    _length += n;
+}
+
+void MetricsWriter::family(const char* name, const char* type, const char* help) {
+    line("# HELP %s %s\n", name, help);
+    line("# TYPE %s %s\n", name, type);
+}
+
+void MetricsWriter::value(const char* name, uint32_t v) {
+    line("%s %lu\n", name, (unsigned long)v);
+}
+
+void MetricsWriter::value(const char* name, int32_t v) {
+    line("%s %ld\n", name, (long)v);
+}
+
+void MetricsWriter::value(const char* name, float v) {
+    line("%s %.3f\n", name, (double)v);
+}
+
+void MetricsWriter::value(const char* name, const char* label, const char* labelValue, float v) {
+    line("%s{%s=\"%s\"} %.3f\n", name, label, labelValue, (double)v);
+}
+
+const uint32_t LatencyHistogram::BOUNDS_MS[BUCKETS] = {
+    250, 500, 1000, 2000, 4000, 8000, 16000, 32000
+};
+
+LatencyHistogram::LatencyHistogram() : _sumMs(0), _count(0) {
+    memset(_counts, 0, sizeof(_counts));
+}
+
+void LatencyHistogram::observe(uint32_t ms) {
+    uint8_t i = 0;
+    while (i < BUCKETS && ms > BOUNDS_MS[i]) i++;
+    _counts[i]++;
+    _sumMs += ms;
+    _count++;
+}
+
+void LatencyHistogram::write(MetricsWriter& out, const char* name, const char* help) const {
+    char sample[64];
+    out.family(name, "histogram", help);
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        cumulative += _counts[i];
+        char le[12];
+        snprintf(le, sizeof(le), "%.2f", BOUNDS_MS[i] / 1000.0);
+        snprintf(sample, sizeof(sample), "%s_bucket", name);
+        out.value(sample, "le", le, (float)cumulative);
+    }
+    snprintf(sample, sizeof(sample), "%s_bucket", name);
+    out.value(sample, "le", "+Inf", (float)_count);
+    snprintf(sample, sizeof(sample), "%s_sum", name);
+    out.value(sample, (float)(_sumMs / 1000.0));
+    snprintf(sample, sizeof(sample), "%s_count", name);
+    out.value(sample, _count);
+}
@@ -0,0 +1,152 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "PngEncoder.h"
+
+// Prometheus text exposition of the display's health, served on the WiFi
+// interface at /metrics for a scraper to poll, and, once their sources are
+// set, what the panel was last drawn with at /frame.png and the profiler's
+// samples at /profile.
+//
+// Like Fetcher, the server is a state machine and poll() does one bounded
+// slice per loop() pass: accept, read the request line, or write up to
+// WRITE_SLICE bytes of the response (and no more than the socket will take).
+// A scrape never holds up the fetch or the render core. The response is
+// built in one go into a buffer the server owns, so there's no heap per
+// scrape; metrics that don't fit are cut off at a line boundary and
+// nextbus_metrics_truncated says so. /frame.png is streamed instead: the
+// same buffer is refilled from a PngEncoder a few rows at a time once the
+// last slice is out, and the response ends when the connection closes. The
+// encoder's compressor is only allocated for that scrape. /profile streams
+// the same way. One client at a time; a second one waits in the listen
+// backlog.
+class MetricsWriter;
+
+class MetricsServer {
+  public:
+    enum State : uint8_t { LISTEN, REQUEST, RESPONSE };
+
+    static const size_t   BODY_MAX        = 6144;
+    static const size_t   TRAILER_ROOM    = 192;   // of BODY_MAX, kept for nextbus_metrics_truncated
+    static const size_t   WRITE_SLICE     = 512;   // max bytes written per poll()
+    static const uint32_t IDLE_TIMEOUT_MS = 2000;  // no progress for this long drops the client
+
+    // Appends the metrics; called once per scrape, on core0
+    typedef void (*Collector)(MetricsWriter& out);
+
+    // Begins png with the current frame; false if there isn't one to give
+    typedef bool (*FrameSource)(PngEncoder& png);
+
+    // Writes the next slice of a binary dump, the first one when start is
+    // set; bytes written, 0 once it's done
+    typedef size_t (*ProfileSource)(uint8_t* out, size_t max, bool start);
+
+    MetricsServer(uint16_t port, Collector collect);
+
+    /**
+    * Starts listening. Call once the link is up.
+    */
+    void begin();
+
+    /**
+    * Serves source's frame at /frame.png; until this is called it's a 404.
+    */
+    void setFrameSource(FrameSource source) { _frame = source; }
+
+    /**
+    * Serves source's dump at /profile; until this is called it's a 404.
+    */
+    void setProfileSource(ProfileSource source) { _profile = source; }
+
+    /**
+    * Does one bounded slice of work. Does nothing before begin().
+    */
+    void poll();
+
+    uint32_t scrapes() const { return _scrapes; }
+
+  private:
+    WiFiServer _server;
+    Collector _collect;
+    FrameSource _frame;
+    PngEncoder _png;         // streaming /frame.png while not done()
+    ProfileSource _profile;
+    bool _profiling;         // streaming /profile
+    bool _profileStart;      // the next slice is the dump's first
+    bool _listening;
+    State _state;
+    WiFiClient _client;
+    unsigned long _stateSince;
+    uint32_t _scrapes;
+
+    char _line[64];          // request line
+    uint8_t _lineLen;
+    char _head[128];         // status line and headers
+    size_t _headLen;
+    char _body[BODY_MAX];
+    size_t _bodyLen;
+    size_t _sent;            // of head + body
+
+    bool streaming() const { return !_png.done() || _profiling; }
+    void refill();
+    void startResponse();
+    void close();
+};
+
+// Appends Prometheus text lines to a fixed buffer
+class MetricsWriter {
+  public:
+    MetricsWriter(char* buffer, size_t capacity);
+
+    /**
+    * # HELP and # TYPE lines for a metric family.
+    * @param type "counter", "gauge" or "histogram"
+    */
+    void family(const char* name, const char* type, const char* help);
+
+    void value(const char* name, uint32_t v);
+    void value(const char* name, int32_t v);
+    void value(const char* name, float v);
+
+    /**
+    * A sample with one label, e.g. name{stop="13565"} v.
+    */
+    void value(const char* name, const char* label, const char* labelValue, float v);
+
+    size_t length() const { return _length; }
+    bool truncated() const { return _truncated; }
+
+  private:
+    char* _buffer;
+    size_t _capacity;
+    size_t _length;
+    bool _truncated;
+
+    void line(const char* format, ...);
+};
+
+// Cumulative histogram of durations, in the fixed buckets Prometheus wants
+// (le="..." upper bounds, plus +Inf)
+class LatencyHistogram {
+  public:
+    static const uint8_t BUCKETS = 8;
+
+    LatencyHistogram();
+
+    void observe(uint32_t ms);
+
+    /**
+    * Writes name_bucket / name_sum / name_count, in seconds.
+    */
+    void write(MetricsWriter& out, const char* name, const char* help) const;
+
+  private:
+    static const uint32_t BOUNDS_MS[BUCKETS];
+    uint32_t _counts[BUCKETS + 1];  // per bucket, not cumulative; last is +Inf
+    uint64_t _sumMs;
+    uint32_t _count;
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "NetCache.h"
+#include "PhaseTimer.h"
+#include "Log.h"
+
+static const char CACHE_MAGIC[4] = {'N', 'B', 'N', 'C'};
+static const uint16_t CACHE_VERSION = 1;
+
+// The server's clock at the last fetch, carried over a watchdog reset (or
+// the RUN pin) in RAM the C runtime doesn't zero. Garbage after a power-up,
+// which the check word catches.
+struct WarmClock {
+    uint32_t magic;
+    uint32_t epoch;
+    uint32_t check;
+};
+static WarmClock __uninitialized_ram(warmClock);
+static const uint32_t WARM_MAGIC = 0x4E42434B;
+
+// How long before the reset the last fetch may have been: the display
+// watchdog's stale limit plus its timeout, rounded up. Ages come out a
+// little high, never low.
+static const uint32_t WARM_SLACK_S = 6 * 60;
+
+NetCache::NetCache()
+    : _path(NULL), _enabled(false), _dirty(false),
+      _ssid(NULL), _password(NULL), _linkStart(0), _hinted(false), _leaseInUse(false),
+      _lookedUp(false), _epoch(0), _epochAt(0) {
+    memset(&_record, 0, sizeof(_record));
+}
+
+bool NetCache::begin(const char* path) {
+    _path = path;
+    _enabled = LittleFS.begin();
+    if (!_enabled) {
+        Serial.println("NetCache: LittleFS mount failed");
+        return false;
+    }
+
+    if (warmClock.magic == WARM_MAGIC && warmClock.check == (warmClock.epoch ^ WARM_MAGIC)) {
+        _epoch = warmClock.epoch + WARM_SLACK_S;
+        _epochAt = millis();
+    }
+
+    File file = LittleFS.open(_path, "r");
+    if (!file) return false;
+    bool ok = file.read((uint8_t*)&_record, sizeof(_record)) == sizeof(_record) &&
+              memcmp(_record.magic, CACHE_MAGIC, sizeof(_record.magic)) == 0 &&
+              _record.version == CACHE_VERSION;
+    file.close();
+    if (!ok) memset(&_record, 0, sizeof(_record));
+    return ok;
+}
+
+void NetCache::save() {
+    _dirty = false;
+    if (!_enabled) return;
+    memcpy(_record.magic, CACHE_MAGIC, sizeof(_record.magic));
+    _record.version = CACHE_VERSION;
+    File file = LittleFS.open(_path, "w");
+    if (!file) return;
+    file.write((const uint8_t*)&_record, sizeof(_record));
+    file.close();
+}
+
+uint32_t NetCache::epochNow() const {
+    if (_epoch == 0) return 0;
+    return _epoch + (millis() - _epochAt) / 1000;
+}
+
+// Stamped and known to be younger than ttl
+bool NetCache::fresh(uint32_t stamp, uint32_t ttl) const {
+    uint32_t now = epochNow();
+    return stamp != 0 && now != 0 && now - stamp < ttl;
+}
+
+void NetCache::startLink(const char* ssid, const char* password) {
+    _ssid = ssid;
+    _password = password;
+    WiFi.mode(WIFI_STA);
+
+    if (!_enabled || !(_record.flags & HAS_LINK)) {
+        joinCold();
+        return;
+    }
+
+    if ((_record.flags & HAS_LEASE) && fresh(_record.leaseAt, LEASE_REUSE_S)) {
+        WiFi.config(IPAddress(_record.ip), IPAddress(_record.dns), IPAddress(_record.gateway), IPAddress(_record.subnet));
+        _leaseInUse = true;
+    } else if (_leaseInUse) {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress(), IPAddress());  // 0.0.0.0: back to DHCP
+        _leaseInUse = false;
+    }
+    WiFi.beginNoBlock(ssid, password, _record.bssid);
+    _hinted = true;
+    _linkStart = millis();
+}
+
+// Full scan for the SSID, and DHCP
+void NetCache::joinCold() {
+    if (_leaseInUse) {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress(), IPAddress());
+        _leaseInUse = false;
+    }
+    if (_hinted) WiFi.disconnect();
+    WiFi.beginNoBlock(_ssid, _password);
+    _hinted = false;
+    _linkStart = millis();
+}
+
+bool NetCache::pollLink() {
+    if (WiFi.status() != WL_CONNECTED) {
+        if (_hinted && millis() - _linkStart > HINT_TIMEOUT_MS) {
+            LOG_WARN("NetCache: hinted join timed out, doing a full one");
+            joinCold();
+        }
+        return false;
+    }
+
+    uint32_t took = millis() - _linkStart;
+    if (!_hinted) {
+        _record.coldLinkMs = took;
+        LOG_INFO("NetCache: WiFi up in %lu ms", took);
+    } else if (_record.coldLinkMs > took) {
+        LOG_INFO("NetCache: WiFi up in %lu ms with the cached BSSID%s, %lu ms faster than a full join",
+                 took, _leaseInUse ? " and lease" : "", _record.coldLinkMs - took);
+    } else {
+        LOG_INFO("NetCache: WiFi up in %lu ms with the cached BSSID%s", took, _leaseInUse ? " and lease" : "");
+    }
+
+    WiFi.BSSID(_record.bssid);
+    _record.channel = WiFi.channel();
+    if (!_leaseInUse) {
+        // A fresh lease from DHCP; stamped now, or on the first fetch if the
+        // time isn't known yet
+        _record.ip = WiFi.localIP();
+        _record.gateway = WiFi.gatewayIP();
+        _record.subnet = WiFi.subnetMask();
+        _record.dns = WiFi.dnsIP();
+        _record.leaseAt = epochNow();
+    }
+    _record.flags |= HAS_LINK | HAS_LEASE;
+    save();
+    return true;
+}
+
+bool NetCache::cached(const char* host, IPAddress& ip) const {
+    // Without a clock the age is unknown: only trust what DNS said this boot
+    uint32_t now = epochNow();
+    bool expired = now == 0 || _record.addressAt == 0 ? !_lookedUp
+                                                      : now - _record.addressAt >= ADDRESS_TTL_S;
+    if (!_enabled || !(_record.flags & HAS_ADDRESS) || expired || strcmp(_record.host, host) != 0) return false;
+    ip = IPAddress(_record.address);
+    return true;
+}
+
+bool NetCache::resolve(const char* host, IPAddress& ip) {
+    if (cached(host, ip)) {
+        if (_record.coldResolveMs > 0) {
+            LOG_INFO("NetCache: %s from cache, ~%lu ms of DNS saved", host, _record.coldResolveMs);
+        }
+        return true;
+    }
+
+    unsigned long start = millis();
+    if (!WiFi.hostByName(host, ip)) return false;
+    if (!_enabled) return true;
+
+    strncpy(_record.host, host, sizeof(_record.host) - 1);
+    _record.host[sizeof(_record.host) - 1] = '\0';
+    _record.address = ip;
+    _record.addressAt = epochNow();
+    _record.coldResolveMs = millis() - start;
+    _record.flags |= HAS_ADDRESS;
+    _lookedUp = true;
+    save();
+    return true;
+}
+
+void NetCache::forgetAddress(const char* host) {
+    if (!(_record.flags & HAS_ADDRESS) || strcmp(_record.host, host) != 0) return;
+    LOG_WARN("NetCache: dropping the cached address of %s, looking it up again", host);
+    _record.flags &= ~HAS_ADDRESS;
+    _lookedUp = false;
+    save();
+}
+
+void NetCache::forgetLease() {
+    _record.flags &= ~HAS_LEASE;
+    save();
+}
+
+void NetCache::noteServerTime(uint32_t epoch) {
+    _epoch = epoch;
+    _epochAt = millis();
+    warmClock.magic = WARM_MAGIC;
+    warmClock.epoch = epoch;
+    warmClock.check = epoch ^ WARM_MAGIC;
+
+    // Stamp what was cached before the time was known
+    if ((_record.flags & HAS_LEASE) && _record.leaseAt == 0) {
+        _record.leaseAt = epoch;
+        _dirty = true;
+    }
+    if ((_record.flags & HAS_ADDRESS) && _record.addressAt == 0 && _lookedUp) {
+        _record.addressAt = epoch;
+        _dirty = true;
+    }
+    if (_dirty) save();
+}
+
+int CachedClient::connect(const char* host, uint16_t port) {
+    IPAddress ip;
+    if (_cache.cached(host, ip)) {
+        PHASE_STAMP(connectAt);
+        int connected = _client.connect(ip, port);
+        PHASE_ADD(PHASE_CONNECT, connectAt);
+        if (connected) return 1;
+        _cache.forgetAddress(host);
+    }
+    PHASE_STAMP(resolveAt);
+    bool found = _cache.resolve(host, ip);  // a real lookup now
+    PHASE_ADD(PHASE_DNS, resolveAt);
+    if (!found) return 0;
+    PHASE_STAMP(connectAt);
+    int connected = _client.connect(ip, port);
+    PHASE_ADD(PHASE_CONNECT, connectAt);
+    return connected;
+}
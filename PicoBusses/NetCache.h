@@ -0,0 +1,162 @@
+#ifndef NET_CACHE_H
+#define NET_CACHE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <LittleFS.h>
+
+// Warm-start hints for the network, kept in the LittleFS partition: the
+// access point's BSSID and channel, the DHCP lease, and the API host's
+// address. A join with a known BSSID skips the scan for the SSID, a reused
+// lease skips DHCP, and a cached address skips DNS.
+//
+// Every hint has a fallback. A hinted join that hasn't come up within
+// HINT_TIMEOUT_MS is dropped for a plain one; an address that doesn't
+// connect is looked up again (TLS still checks the certificate against the
+// host name, so a stale address can't be mistaken for the server). A reused
+// lease can't be checked that way, so it's only used while it's younger
+// than LEASE_REUSE_S, and that needs to know the time: the server's clock
+// from the last fetch, which survives a reset in uninitialized RAM. After
+// a power-up there's no clock, and DHCP runs as usual. So does DNS: a
+// cached address of unknown age could be one that still takes a TCP
+// connect but is no longer the API, and would be used forever.
+//
+// The cold timings (full join, DNS lookup) are kept too, so every warm
+// start can report what it saved. Core0 only.
+class NetCache {
+  public:
+    static const uint32_t HINT_TIMEOUT_MS = 8000;         // hinted join -> full join
+    static const uint32_t LEASE_REUSE_S   = 30UL * 60UL;  // well inside any router's lease time
+    static const uint32_t ADDRESS_TTL_S   = 60UL * 60UL;  // re-resolve the API host this often
+
+    NetCache();
+
+    /**
+    * Mounts LittleFS and loads the hints. Without begin() nothing is cached
+    * and every join and lookup is a cold one.
+    * @param path File the hints are kept in
+    * @return true if there were hints to load
+    */
+    bool begin(const char* path = "/netcache.bin");
+
+    /**
+    * Starts joining the access point, with the BSSID and lease if there
+    * are usable ones. Returns right away; poll with pollLink().
+    */
+    void startLink(const char* ssid, const char* password);
+
+    /**
+    * Call until it returns true. Falls back to a full join if the hinted
+    * one doesn't come up in time. Once up, notes the link's BSSID, channel
+    * and lease and reports the time saved.
+    * @return true once the link is up
+    */
+    bool pollLink();
+
+    /**
+    * The address of host, from the cache while it's fresh, else from DNS.
+    * @param host Host name
+    * @param ip Set to its address
+    * @return false if DNS failed
+    */
+    bool resolve(const char* host, IPAddress& ip);
+
+    /**
+    * The cached address of host, without falling back to DNS or reporting.
+    * @return false if there's no fresh one
+    */
+    bool cached(const char* host, IPAddress& ip) const;
+
+    /**
+    * Drops the cached address of host, after a connect or a fetch through
+    * it failed.
+    */
+    void forgetAddress(const char* host);
+
+    /**
+    * Stops reusing the lease: the link came up with it but nothing works.
+    * The next startLink() does DHCP.
+    */
+    void forgetLease();
+
+    /**
+    * Feeds the server's clock (UTC epoch) in after a fetch; the lease and
+    * address ages are measured against it.
+    */
+    void noteServerTime(uint32_t epoch);
+
+    bool leaseInUse() const { return _leaseInUse; }
+
+    /**
+    * @return true once a reused lease is past LEASE_REUSE_S; rejoin, and
+    * DHCP will run
+    */
+    bool leaseStale() const { return _leaseInUse && !fresh(_record.leaseAt, LEASE_REUSE_S); }
+
+  private:
+    // On-flash record, little-endian like the RP2350
+    struct Record {
+        char magic[4];
+        uint16_t version;
+        uint8_t bssid[6];
+        uint8_t channel;       // reported only: the join API takes no channel
+        uint8_t flags;         // HAS_*
+        uint32_t ip, gateway, subnet, dns;
+        uint32_t leaseAt;      // server time the lease was seen, 0 if unknown
+        char host[32];
+        uint32_t address;
+        uint32_t addressAt;    // server time it was resolved, 0 if unknown
+        uint32_t coldLinkMs;   // the last full join + DHCP
+        uint32_t coldResolveMs;
+    };
+
+    enum : uint8_t { HAS_LINK = 1, HAS_LEASE = 2, HAS_ADDRESS = 4 };
+
+    const char* _path;
+    bool _enabled;
+    bool _dirty;
+    Record _record;
+
+    const char* _ssid;
+    const char* _password;
+    unsigned long _linkStart;
+    bool _hinted;
+    bool _leaseInUse;
+    bool _lookedUp;            // the cached address came from DNS this boot
+
+    uint32_t _epoch;           // server time at _epochAt, 0 if unknown
+    unsigned long _epochAt;
+
+    uint32_t epochNow() const;
+    bool fresh(uint32_t stamp, uint32_t ttl) const;
+    void joinCold();
+    void save();
+};
+
+// Client wrapper for SSLClient to sit on: connects to the cached address
+// of a host instead of resolving it on every connect, and falls back to DNS
+// once if that address doesn't answer.
+class CachedClient : public Client {
+  public:
+    CachedClient(Client& client, NetCache& cache) : _client(client), _cache(cache) {}
+
+    int connect(IPAddress ip, uint16_t port) override { return _client.connect(ip, port); }
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t b) override { return _client.write(b); }
+    size_t write(const uint8_t* buf, size_t size) override { return _client.write(buf, size); }
+    using Print::write;
+    int available() override { return _client.available(); }
+    int read() override { return _client.read(); }
+    int read(uint8_t* buf, size_t size) override { return _client.read(buf, size); }
+    int peek() override { return _client.peek(); }
+    void flush() override { _client.flush(); }
+    void stop() override { _client.stop(); }
+    uint8_t connected() override { return _client.connected(); }
+    operator bool() override { return (bool)_client; }
+
+  private:
+    Client& _client;
+    NetCache& _cache;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "PhaseTimer.h"
+
+#if PHASE_TIMING
+PhaseTimer phaseTimer;
+#endif
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "wifi", "dns", "connect", "tls", "first byte", "download",
+    "inflate", "parse", "aggregate", "render", "spi upload", "busy"
+};
+
+PhaseTimer::PhaseTimer() : _filed(0) {
+    beginCycle();
+}
+
+const char* PhaseTimer::name(Phase phase) {
+    return phase < PHASE_COUNT ? PHASE_NAMES[phase] : "?";
+}
+
+void PhaseTimer::beginCycle() {
+    _current.frame = 0;
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) _current.us[p] = NOT_MEASURED;
+}
+
+void PhaseTimer::endCycle(uint32_t frame) {
+    _current.frame = frame;
+    _ring[_filed % CYCLES] = _current;
+    _filed++;
+    beginCycle();
+}
+
+void PhaseTimer::addToFrame(uint32_t frame, Phase phase, uint32_t us) {
+    if (frame == 0) return;
+    uint32_t kept = _filed < CYCLES ? _filed : CYCLES;
+    for (uint32_t i = 1; i <= kept; i++) {
+        Cycle& cycle = _ring[(_filed - i) % CYCLES];
+        if (cycle.frame != frame) continue;
+        uint32_t& slot = cycle.us[phase];
+        slot = (slot == NOT_MEASURED) ? us : slot + us;
+        return;
+    }
+}
+
+const uint32_t* PhaseTimer::recent(uint8_t back, uint32_t& frame) const {
+    if (back >= CYCLES || back >= _filed) return NULL;
+    const Cycle& cycle = _ring[(_filed - 1 - back) % CYCLES];
+    frame = cycle.frame;
+    return cycle.us;
+}
+
+uint8_t PhaseTimer::summary(Phase phase, uint32_t& min, uint32_t& median, uint32_t& p99) const {
+    uint32_t sorted[CYCLES];
+    uint8_t n = 0;
+    uint32_t kept = _filed < CYCLES ? _filed : CYCLES;
+    for (uint32_t i = 0; i < kept; i++) {
+        uint32_t us = _ring[i].us[phase];
+        if (us == NOT_MEASURED) continue;
+
+        // Insertion sort; CYCLES is small and this runs once a report
+        uint8_t j = n++;
+        while (j > 0 && sorted[j - 1] > us) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = us;
+    }
+
+    min = median = p99 = 0;
+    if (n == 0) return 0;
+    min = sorted[0];
+    median = sorted[(n - 1) / 2];
+    p99 = sorted[(n * 99 + 99) / 100 - 1];  // nearest rank
+    return n;
+}
+
+void PhaseTimer::report(Print& out) const {
+    uint32_t kept = _filed < CYCLES ? _filed : CYCLES;
+    out.print("Phase timing over the last ");
+    out.print(kept);
+    out.println(" cycles (us): min / median / p99");
+    char line[64];
+    for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+        uint32_t min, median, p99;
+        uint8_t n = summary((Phase)p, min, median, p99);
+        if (n == 0) continue;
+        snprintf(line, sizeof(line), "  %-10s %9lu %9lu %9lu  (%u)",
+                 PHASE_NAMES[p], (unsigned long)min, (unsigned long)median, (unsigned long)p99, n);
+        out.println(line);
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <Arduino.h>
+
+// Per-phase timing of every poll cycle, from the WiFi check to the panel
+// going idle with the result.
+//
+// Core0 phases add microseconds to the cycle in progress; endCycle() files
+// it in a fixed ring of CYCLES records, tagged with the frame it produced.
+// The render core's phases (render, SPI upload, BUSY) come back seconds
+// later through plain stores, like the frame latency does, and core0 adds
+// them to that frame's record with addToFrame(). Nothing allocates, and
+// add() is a compare and an add.
+//
+// 1 keeps the timers in; 0 compiles every PHASE_STAMP()/PHASE_ADD() and the
+// ring out. Set it here rather than in the sketch: Fetcher.cpp and
+// NetCache.cpp time their own phases.
+#ifndef PHASE_TIMING
+#define PHASE_TIMING 1
+#endif
+
+enum Phase : uint8_t {
+    PHASE_WIFI,        // link check before the fetch
+    PHASE_DNS,         // API host lookup (or cache hit)
+    PHASE_CONNECT,     // TCP connect
+    PHASE_TLS,         // TLS handshake
+    PHASE_FIRST_BYTE,  // request sent -> first response byte
+    PHASE_DOWNLOAD,    // first byte -> body complete
+    PHASE_INFLATE,     // gunzip
+    PHASE_PARSE,       // JSON -> arrivals
+    PHASE_AGGREGATE,   // arrivals -> frame snapshot
+    PHASE_RENDER,      // snapshot -> planes (core1)
+    PHASE_UPLOAD,      // planes -> panel over SPI (core1)
+    PHASE_BUSY,        // panel refresh, BUSY high (core1)
+    PHASE_COUNT
+};
+
+class PhaseTimer {
+  public:
+    static const uint8_t CYCLES = 64;                  // ~70 minutes of 65 s polls
+    static const uint32_t NOT_MEASURED = 0xFFFFFFFF;
+
+    PhaseTimer();
+
+    /**
+    * Starts a new cycle; phases added from here on are its.
+    */
+    void beginCycle();
+
+    /**
+    * Adds time to a phase of the cycle in progress. Repeats (retries)
+    * accumulate.
+    */
+    void add(Phase phase, uint32_t us) {
+        uint32_t& slot = _current.us[phase];
+        slot = (slot == NOT_MEASURED) ? us : slot + us;
+    }
+
+    /**
+    * @return What a phase of the cycle in progress has so far, or 0
+    */
+    uint32_t current(Phase phase) const {
+        return _current.us[phase] == NOT_MEASURED ? 0 : _current.us[phase];
+    }
+
+    /**
+    * Files the cycle in progress in the ring.
+    * @param frame Sequence of the frame it produced, 0 for none
+    */
+    void endCycle(uint32_t frame);
+
+    /**
+    * Adds a render-core phase to the cycle that produced frame, if it's
+    * still in the ring.
+    */
+    void addToFrame(uint32_t frame, Phase phase, uint32_t us);
+
+    /**
+    * Min, median and p99 of a phase over the ring, skipping cycles that
+    * didn't get to it.
+    * @return Number of cycles that did
+    */
+    uint8_t summary(Phase phase, uint32_t& min, uint32_t& median, uint32_t& p99) const;
+
+    /**
+    * Prints the summary table.
+    */
+    void report(Print& out) const;
+
+    uint32_t cycles() const { return _filed; }
+
+    /**
+    * A filed cycle's phases, newest first.
+    * @param back 0 for the newest
+    * @param frame Set to the frame it produced
+    * @return Its PHASE_COUNT timings (NOT_MEASURED where skipped), or NULL
+    * if the ring doesn't go back that far
+    */
+    const uint32_t* recent(uint8_t back, uint32_t& frame) const;
+
+    static const char* name(Phase phase);
+
+  private:
+    struct Cycle {
+        uint32_t frame;
+        uint32_t us[PHASE_COUNT];
+    };
+
+    Cycle _ring[CYCLES];
+    Cycle _current;
+    uint32_t _filed;   // cycles filed so far; the newest is at (_filed - 1) % CYCLES
+};
+
+#if PHASE_TIMING
+extern PhaseTimer phaseTimer;
+
+#define PHASE_STAMP(name) uint32_t name = micros()
+#define PHASE_ADD(phase, since) phaseTimer.add(phase, micros() - (since))
+#else
+#define PHASE_STAMP(name)
+#define PHASE_ADD(phase, since)
+#endif
+
+#endif
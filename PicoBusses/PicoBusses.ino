@@ -39,29 +39,48 @@ String stopCodes[] = {"13565", "16633"};
 
 // You should not have to adjust anything below this line.
 
-//#define DEBUG_MODE
-
 #include <SPI.h>
 #include <WiFi.h>
 #include <HTTPClient.h>
 
 #include <SSLClient.h>
+#ifdef MOCK_API_HOST
+#include "trust_anchors_mock.h"  // the test CA of Scripts/mock511.py, see config.template.h
+#else
 #include "trust_anchors.h"
+#endif
 #include "miniz.h"
 #include <ArduinoUniqueID.h>
 #include <NTPClient.h>
 #include <TimeLib.h>
 #include <ArduinoJson.h>
 #include "imagedata.h"
+#include "Fetcher.h"
+#include "GzipInflater.h"        // the portable core: inflate, parse, aggregate
+#include "StopMonitorParser.h"   //   and lay out rows, host-buildable too
+#include "ArrivalBoard.h"        //   (see CMakeLists.txt)
+#include "NetCache.h"
+#include "FrameQueue.h"
+#include "RowTileCache.h"
 #include "Globals.h"
-#include "transit_bitmap.h"
-#include "muni_bitmap.h"
-#include "Fonts/FreeSansBold18pt7b.h"
-#include "Fonts/FreeSansBold24pt7b.h"
-#include "Fonts/FreeSans12pt7b.h"
+#include "assets.h"          // logos, linked in from assets.S (Scripts/assetpack.py)
+#include "LogoStore.h"
+#include "FrameStore.h"
+#include "ArrivalJournal.h"
+#include "PhaseTimer.h"
+#include "MemStats.h"
+#include "CrashLog.h"
+#include "MetricsServer.h"
+#include "Log.h"             // set LOG_LEVEL there to LOG_LEVEL_DEBUG for the fetch details
+#include "Profiler.h"
+// Span fonts compiled from the GFX fonts by Scripts/fontcompile.py; the
+// 24pt one only has what the times line needs
+#include "Fonts/FreeSansBold24pt7bDigits.h"
+#include "Fonts/FreeSans12pt7bSpans.h"
 #include <Adafruit_GFX.h>
 
 #include "MT_EPD.h"
+#include "digit_atlas.h"
 
 // Hardware watchdog (RP2040 / RP2350) — drives the display watchdog below.
 #if defined(ARDUINO_ARCH_RP2040)
@@ -80,15 +99,7 @@ String stopCodes[] = {"13565", "16633"};
 #define EPD_SCK   18  // SPI Clock
 #define EPD_CS    17  // Chip Select
 
-struct LineInfo {
-  String lineRef;         // The line number/reference
-  String destination;     // The destination 
-  String stopPoint;       // The stop point
-  bool active;            // Whether this line is active in current update
-};
-
 String CurrentTimeToString(time_t time);
-time_t iso8601ToEpoch(String datetime);
 MT_EPD display(EPD_CS, EPD_DC, EPD_RST, EPD_BUSY);
 
 bool positionsInitialized = false;
@@ -100,9 +111,10 @@ bool positionsInitialized = false;
 // so the panel never refreshes again.
 //
 // We arm the hardware watchdog once and feed it from petWatchdog(), which is
-// sprinkled into every place core0 can block for a while (loop(), the WiFi
-// connect loop, the getData() read/retry loops). petWatchdog() only feeds the
-// dog while the screen has refreshed within DISPLAY_STALE_LIMIT_MS;
+// called from every place core0 can block for a while (loop() and the WiFi
+// connect loop; the fetch itself runs one slice per loop() pass, see Fetcher).
+// petWatchdog() only feeds the dog while the screen has refreshed within
+// DISPLAY_STALE_LIMIT_MS;
 // lastDisplayUpdate == 0 keeps us fed through boot. If frames stop coming, the
 // pets stop and the chip resets within WDT_TIMEOUT_MS, rerunning setup().
 //
@@ -114,6 +126,22 @@ bool positionsInitialized = false;
 // Set USE_DISPLAY_WATCHDOG to 0 to compile the watchdog out entirely.
 #define USE_DISPLAY_WATCHDOG 1
 
+// Each core notes the phase it's in, and a deliberate reset notes its reason,
+// in a record that survives the reset (see CrashLog.h). The next boot prints
+// it and counts the cause in flash: stuck BUSY, wedged connect, WiFi down,
+// fetches failing or a plain hang.
+// Set USE_CRASH_LOG to 0 to compile it out.
+#define USE_CRASH_LOG 1
+
+#if USE_CRASH_LOG
+CrashLog crashLog;
+#define CRASH_ENTER(phase) CrashLog::enter(phase)
+#define CRASH_ENTER_CORE1(phase) CrashLog::enterCore1(phase)
+#else
+#define CRASH_ENTER(phase)
+#define CRASH_ENTER_CORE1(phase)
+#endif
+
 const unsigned long DISPLAY_STALE_LIMIT_MS = 5UL * 60UL * 1000UL; // ~5 minutes
 const uint32_t WDT_TIMEOUT_MS = 12000;  // > worst-case blocking op (TLS connect); within RP2350 limit
 volatile unsigned long lastDisplayUpdate = 0; // millis() of last display.display()
@@ -124,6 +152,11 @@ inline void petWatchdog() {
 #if defined(ARDUINO_ARCH_RP2040) && USE_DISPLAY_WATCHDOG
   if ((millis() - lastDisplayUpdate) < DISPLAY_STALE_LIMIT_MS) {
     watchdog_update();
+#if USE_CRASH_LOG
+    CrashLog::pet();
+  } else {
+    CrashLog::noteReason(CrashLog::REASON_DISPLAY_STALE, WiFi.status() == WL_CONNECTED);
+#endif
   }
 #endif
 }
@@ -136,36 +169,239 @@ inline void startDisplayWatchdog() {
 #endif
 }
 
-LineInfo lineInfoArray[10];
-int lineInfoCount = 0;
+// ---- Render core ------------------------------------------------------------
+// Rendering and the panel upload run on core1 so they don't add to the
+// network cycle on core0. core0 turns the arrival data into a FrameSnapshot
+// (plain chars, built in updateDisplay()) and pushes it through renderQueue;
+// loop1() pops the newest one, draws it and refreshes the panel.
+//
+// core1 gets paused at arbitrary points: the CYW43 driver (and any flash
+// write) uses multicore lockout, which parks core1 in an IRQ until core0 is
+// done. Anything core1 holds while parked, core0 can't get. So core1 never
+// takes a lock core0 might want:
+//   - no heap (malloc's lock is shared): no String, no new, no malloc
+//   - no Serial (the USB mutex): log with LOG_* (Log.h), which only stores
+//     into a lock-free ring that core0 flushes
+//   - renderQueue is a lock-free SPSC ring, no spinlocks
+// core0 owns the display until the first snapshot (the splash in setup(), the
+// WiFi error screen from pollBoot()); core1 only touches it after that
+// snapshot arrives, which is after the link is up.
+//
+// The panel is the front buffer. displayAsync() uploads the planes into the
+// controller's RAM and starts the refresh, which takes seconds on a tri-colour
+// panel. The MCU-side planes are then the back buffer: loop1() draws the next
+// frame into them while the glass is still changing, and only waits for BUSY
+// right before the next upload. The upload is the swap.
+//
+// Set USE_RENDER_CORE to 0 to render inline on core0 instead.
+#define USE_RENDER_CORE 1
+
+SpscQueue<FrameSnapshot, 3> renderQueue;
+FrameSnapshot pendingFrame;           // core0's next frame, until it fits in the queue
+bool framePending = false;
+uint32_t frameSequence = 0;
+bool frameHandedOver = false;         // a frame has gone to the renderer; core1 owns the display
+volatile uint32_t framesOnGlass = 0;  // sequence of the last frame the panel finished
+volatile uint32_t glassLatencyMs = 0; // fetch finished -> that frame's refresh finished
+volatile uint32_t renderUs = 0;       // that frame: drawing it into the planes,
+volatile uint32_t uploadUs = 0;       //   sending them to the panel over SPI,
+volatile uint32_t busyUs = 0;         //   and the refresh (BUSY) after that
+
+// Every poll cycle is timed phase by phase, from the link check to the panel
+// going idle (see PhaseTimer.h); the core1 phases come back with the frame
+// through the globals above. The min / median / p99 of each phase over the
+// last PhaseTimer::CYCLES cycles are printed every PHASE_REPORT_CYCLES.
+// Set PHASE_TIMING to 0 in PhaseTimer.h to compile the timers out.
+//
+// Heap and stack use are printed after every fetch, and what each phase
+// held and how far it pushed the heap go out with the phase timing (see
+// MemStats.h). Set MEM_STATS to 0 in MemStats.h to compile that out.
+//
+// Where inside a phase the time goes: with PROFILER set to 1 in Profiler.h,
+// a timer interrupt samples the PC on both cores during the fetch slices and
+// core1's render and upload. http://<display>:9100/profile hands the samples
+// over, and Scripts/profsym.py turns them into a profile. Off by default.
+#define PHASE_REPORT_CYCLES 16
+#if MEM_STATS
+MemStats::Mark fetchMark;  // heap when the request started
+#endif
+
+// The BSSID, DHCP lease and API address are cached in flash (see
+// NetCache.h), so a rejoin after a reset or a dropped link skips the scan,
+// DHCP and DNS when it can; each join and lookup reports what it saved.
+// Set USE_NET_CACHE to 0 for a full join and a DNS lookup every time.
+#define USE_NET_CACHE 1
+
+// ---- Boot sequence ----------------------------------------------------------
+// setup() doesn't wait on anything slow. startBoot() sets WiFi associating
+// (beginNoBlock) before anything else, setup() then reads flash and starts
+// the splash -- or the restored last frame -- refreshing with displayAsync(),
+// and returns. loop() runs pollBoot() until the link comes up and issues the
+// first fetch right then, so DNS, the TLS handshake and the GET overlap the
+// panel's refresh instead of following it. (core1's first displayAsync()
+// waits out a refresh that's still going.) If there's no link within
+// WIFI_TIMEOUT_MS and no frame has been handed to the renderer yet -- a
+// restored last frame doesn't count, core0 drew that itself -- core0 still
+// owns the display, and resetDevice() says so on the panel.
+//
+// The boot timeline (millis() since reset) is printed once the first
+// arrivals are on glass: time-to-first-arrivals is the number to watch.
+enum BootStage : uint8_t { BOOT_LINK, BOOT_RUNNING };
+BootStage bootStage = BOOT_LINK;
+const unsigned long WIFI_TIMEOUT_MS = 180000;  // 3 minutes
+unsigned long bootLinkStartAt = 0;   // beginNoBlock() called
+unsigned long bootSplashAt = 0;      // splash / restored frame sent to the panel
+unsigned long bootLinkUpAt = 0;      // associated, with an IP
+unsigned long bootFirstFetchAt = 0;  // first fetch done
+bool bootReported = false;
+
+// Rows rarely change between fetches; only their minutes do. The row tile
+// cache keeps each row's logo and labels as pasteable tiles (see
+// RowTileCache.h), so a frame redraws just the times.
+// Set USE_ROW_TILE_CACHE to 0 to draw every row in full.
+#define USE_ROW_TILE_CACHE 1
+
+// Logos come from logos.pak on the LittleFS partition (see LogoStore.h):
+// upload PicoBusses/data with the LittleFS uploader, and pick a Flash Size
+// with room for an FS. Only the fallback logo is linked into the firmware.
+// Set USE_ASSET_FS to 0 to link every logo in instead.
+#define USE_ASSET_FS 1
+
+#if USE_ASSET_FS
+LogoStore logoStore;
+#endif
+
+// Warm boot: the newest frame is kept deflated in flash (see FrameStore.h),
+// and setup() puts it back up -- with an "As of" badge, since its minutes
+// are as old as the frame -- instead of the splash. The screen is useful
+// right after a reset, however long WiFi and the first fetch take.
+// LittleFS wear: at most one save per LAST_FRAME_SAVE_MS.
+// Set USE_WARM_BOOT to 0 to always show the splash.
+#define USE_WARM_BOOT 1
+
+#if USE_WARM_BOOT
+FrameStore frameStore;
+const unsigned long LAST_FRAME_SAVE_MS = 5UL * 60UL * 1000UL;
+#endif
+
+// Each stop's arrivals are journalled to flash as they're fetched (see
+// ArrivalJournal.h) and replayed in setup(), so after a reset the first
+// fetch's frame already has every stop instead of one per 65 s poll.
+// Set USE_ARRIVAL_JOURNAL to 0 to start from empty stops.
+#define USE_ARRIVAL_JOURNAL 1
+
+#if USE_ARRIVAL_JOURNAL
+ArrivalJournal arrivalJournal;
+#endif
+
+// Health for a Prometheus scraper at http://<display>:9100/metrics (see
+// MetricsServer.h): poll latency, API budget, per-stop data age, refreshes,
+// heap, RSSI and rejoins. Served a slice per loop() pass, like a fetch.
+// http://<display>:9100/frame.png is the planes as a PNG, to see what the
+// panel shows without walking over to it (not in band mode: no planes).
+// Set USE_METRICS to 0 to leave the port closed.
+#define USE_METRICS 1
+
+const uint16_t METRICS_PORT = 9100;
+const uint8_t API_REQUESTS_PER_HOUR = 60;  // the 511 API's default limit per key
+unsigned long fetchStartedAt = 0;          // millis() the current fetch began
+unsigned long apiRequestAt[API_REQUESTS_PER_HOUR];  // ring of the last requests' millis()
+uint8_t apiRequestNext = 0;
+uint32_t apiRequests = 0;                  // HTTP requests sent, retries included
+uint32_t fetchFailures = 0;
+uint32_t relinks = 0;
+uint32_t framesReplaced = 0;               // core0: pending frame overwritten by a newer one
+volatile uint32_t framesSkipped = 0;       // core1: popped but never shown, a newer one was queued
+volatile uint32_t refreshes = 0;           // frames that reached the glass
+
+#if USE_METRICS
+void collectMetrics(MetricsWriter& out);
+LatencyHistogram pollLatency;
+MetricsServer metricsServer(METRICS_PORT, collectMetrics);
+#if !MT_EPD_BAND_MODE
+bool beginFrameSnapshot(PngEncoder& png);
+#endif
+#endif
 
 const int ROW_HEIGHT = 135;
 
 
-void printHexBuffer(const uint8_t* buffer, size_t length);
-void getData(void);
+void startFetch(const String& stopCode);
+void finishFetch(bool ok);
 void decompressGzippedData(const uint8_t *gzippedData, size_t gzippedDataSize);
-uint32_t getUncompressedLength(const uint8_t* data, size_t dataSize);
-void parseAndFormatBusArrivals(const String& jsonData);
+void parseAndFormatBusArrivals(const char* json, size_t length);
 void removeOldArrivals(void);
 void displayArrivals(void);
 void resetDevice(void);
-bool connectToWiFiWithTimeout(void);
-void collectActiveLines(void);
+uint8_t fetchPhase(Fetcher::State state);
+void startBoot(void);
+void pollBoot(void);
+void relink(void);
+bool resolveHost(const char* host, IPAddress& ip);
 void updateDisplay(void);
-const uint8_t* getTransitLogo(String lineRef);
+void submitPendingFrame(void);
+void renderFrame(const FrameSnapshot& frame);
+void paintRowLogo(const FrameRow& row, int16_t y);
+void paintRowLabels(const FrameRow& row, int16_t y);
+void frameOnGlass(uint32_t sequence, uint32_t fetchedAt,
+                  uint32_t renderTook, uint32_t uploadTook, uint32_t uploadedAt);
+void reportFrameLatency(void);
+const NativeBitmap* getTransitLogo(const char* lineRef, uint32_t sequence);
+bool restoreLastFrame(void);
+void saveLastFrame(const FrameSnapshot& frame);
+void drawAgeBadge(uint32_t asOf);
+void journalStopArrivals(int stopCodeIndex);
+void restoreStopArrivals(const char* stopCode, uint32_t serverTime,
+                         const ArrivalJournal::Arrival* arrivals, uint8_t count);
+
+#if USE_ROW_TILE_CACHE
+RowTileCache rowTiles(display, paintRowLogo, paintRowLabels);
+#endif
 
 
 void setup() {
+#if MEM_STATS
+  memStats.begin();  // paint core0's stack while it's still shallow
+#endif
+#if PROFILER
+  Profiler::begin();
+#endif
   Serial.begin(115200);
   delay(1000);
   Serial.println("EPD image test");
   Serial.println(">>> BUILD CHECK: inline-watchdog + immediate-fetch (rev C) <<<");
 
+#if USE_CRASH_LOG
+  // Before the watchdog is armed again: what reset us last time
+  crashLog.begin();
+#endif
+
   // Arm the watchdog up front. lastDisplayUpdate is still 0, so petWatchdog()
   // stays in its boot grace window until the first real frame sets the clock.
   startDisplayWatchdog();
 
+  // WiFi associates in the background while the rest of setup() runs
+#if USE_NET_CACHE
+  netCache.begin();
+#endif
+  fetcher.setResolver(resolveHost);
+  startBoot();
+
+  bool logosFound = true;
+#if USE_ASSET_FS
+  // Rows without a logo in the pak get the built-in fallback
+  logosFound = logoStore.begin();
+  if (!logosFound) {
+    LOG_WARN("No logos.pak: every row gets the fallback logo. Upload PicoBusses/data with the LittleFS uploader (see README)");
+  }
+#endif
+#if USE_WARM_BOOT
+  frameStore.begin();
+#endif
+#if USE_ARRIVAL_JOURNAL
+  arrivalJournal.begin();
+#endif
+
   // Configure pins
   pinMode(EPD_BS, OUTPUT);
   pinMode(EPD_CS, OUTPUT);
@@ -190,15 +426,15 @@ void setup() {
   
   // Draw the bitmap at position (0,0)
   /* Keeping this here for later, these are the 'rows'
-  display.drawBitmap(0, 0, transit_logo_48, 130, 130, MT_EPD::EPD_BLACK);
-  display.drawBitmap(0, 135, transit_logo_L, 130, 130, MT_EPD::EPD_BLACK);
-  display.drawBitmap(0, 270, transit_logo_LOWL, 130, 130, MT_EPD::EPD_BLACK);
-  display.drawBitmap(0, 405, transit_logo_CA, 130, 130, MT_EPD::EPD_BLACK);
-  display.drawBitmap(0, 540, transit_logo_714, 130, 130, MT_EPD::EPD_BLACK);
-  display.drawBitmap(0, 675, transit_logo_39T, 130, 130, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 0, transit_logo_48, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 135, transit_logo_L, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 270, transit_logo_LOWL, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 405, transit_logo_CA, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 540, transit_logo_714, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 675, transit_logo_39T, MT_EPD::EPD_BLACK);
   
 
-  display.drawBitmap(0, 0, transit_logo_48, 130, 130, MT_EPD::EPD_BLACK);
+  display.drawNativeBitmap(0, 0, transit_logo_48, MT_EPD::EPD_BLACK);
 
   display.setFont(&FreeSans12pt7b);
   display.setCursor(135, 25);
@@ -217,71 +453,191 @@ void setup() {
   display.println("20, 120, 180");
   */
 
-  display.drawBitmap(0, 250, epd_bitmap_Muni_worm_logo, 480, 258, MT_EPD::EPD_RED);
-
+  // The last frame if there is one, else the splash
+  bool restored = false;
+#if USE_WARM_BOOT
+  restored = restoreLastFrame();
+#endif
+  if (!restored) {
+    display.drawBitmap(0, 250, epd_bitmap_Muni_worm_logo, 480, 258, MT_EPD::EPD_RED);
+    if (!logosFound) {
+      // Otherwise the first frame's fallback logos would look like a bug
+      display.setTextSize(2);
+      display.setTextColor(MT_EPD::EPD_BLACK);
+      display.setCursor(20, 540);
+      display.println("No logos.pak in LittleFS:");
+      display.setCursor(20, 560);
+      display.println("upload PicoBusses/data");
+      display.setTextSize(1);
+    }
+  }
   
-  // Do ONE full update with both logo and initial text
-  display.display();
+  // Start the refresh and move on; loop() fetches as soon as WiFi is up,
+  // whether or not the panel is done
+  display.displayAsync();
+#if USE_ASSET_FS
+  if (restored) logoStore.release(frameSequence);  // the restored frame is uploaded
+#endif
   lastDisplayUpdate = millis();  // first real frame: anchors the watchdog's stale clock
+  bootSplashAt = lastDisplayUpdate;
   petWatchdog();
-  // waitUntilIdle() already blocked until the panel finished; a short settle is plenty
-  delay(1000);
-
-  // Connect to WiFi with timeout
-  if (!connectToWiFiWithTimeout()) {
-    resetDevice(); // Loop back to the beginning, we're fucked.
-  }
 
   // Figure out the stop codes for all this shit
   for (int i = 0; i < sizeof(stopCodes)/sizeof(stopCodes[0]); i++) {
-    stopCodeDataArray[i].stopCode = stopCodes[i];
+    copyText(stopCodeDataArray[i].stopCode, sizeof(stopCodeDataArray[i].stopCode), stopCodes[i].c_str());
     stopCodeDataArray[i].arrivalCount = 0; // Initialize the count of arrivals to 0
   }
 
+#if USE_ARRIVAL_JOURNAL
+  // Refill the stops from before the reset; what's already gone is dropped
+  arrivalJournal.replay(restoreStopArrivals);
+#endif
+
+#if USE_RENDER_CORE
+  // From here on core1 owns the display, and core1 must not print. Clear the
+  // planes here too: that frees the splash's red tiles on core0, so core1's
+  // clearDisplay() never has to call free(). The panel still shows the splash.
+  display.clearDisplay();
+#endif
+
   Serial.println("finished setup");
+#if MEM_STATS
+  memStats.printLine(Serial);  // the display planes are already in there
+#endif
 
 }
   
 void loop() {
   petWatchdog();  // feed the watchdog whenever the screen is healthy
 
+  // Nothing to fetch until the link is up
+  if (bootStage != BOOT_RUNNING) {
+    pollBoot();
+    Log::flush(Serial);
+    return;
+  }
+
+  // Rejoin if the radio dropped, or a reused lease has run its course
+  PHASE_STAMP(linkCheckAt);
+  if (!fetcher.busy() && (WiFi.status() != WL_CONNECTED || netCache.leaseStale())) {
+    LOG_WARN(WiFi.status() != WL_CONNECTED ? "WiFi dropped, rejoining" : "Reused lease is old, rejoining for DHCP");
+    relink();
+    return;
+  }
+
+  unsigned long passStart = micros();
+
   static bool firstFetch = true;          // fetch right away on boot, don't wait 65 s
   unsigned long currentMillis = millis(); // capture the current time
 
-  if (firstFetch || (currentMillis - previousMillis >= interval)) { // first run, or 65 s elapsed
+  if (!fetcher.busy() && (firstFetch || (currentMillis - previousMillis >= interval))) { // first run, or 65 s elapsed
     firstFetch = false;
     previousMillis = currentMillis;
+#if PHASE_TIMING
+    phaseTimer.beginCycle();
+    PHASE_ADD(PHASE_WIFI, linkCheckAt);
+#endif
+#if MEM_STATS
+    fetchMark = memStats.mark();
+#endif
 
-    Serial.print("Fetching stopCode ");
-    Serial.println(stopCodeDataArray[currentStopCodeIndex].stopCode);
-    getData(stopCodeDataArray[currentStopCodeIndex].stopCode);
-    #ifdef DEBUG_MODE
-    Serial.println(CurrentTimeToString(currentTime));
-    #endif
-    removeOldArrivals();
-
-    Serial.print("Data length: ");
-    Serial.println(globalUncompressedDataStr.length());
-
-    if (globalUncompressedDataStr.length() > 0) {
-        #ifdef DEBUG_MODE
-        Serial.print("JSON string length: ");
-        Serial.println(globalUncompressedDataStr.length());
-        #endif
-        parseAndFormatBusArrivals(globalUncompressedDataStr);
-        displayArrivals();
-        currentStopCodeIndex = (currentStopCodeIndex + 1) % (sizeof(stopCodes)/sizeof(stopCodes[0]));
-        updateDisplay();
-    } else {
-        Serial.println("No data or failed to fetch data");
+    LOG_INFO("Fetching stopCode %s", stopCodeDataArray[currentStopCodeIndex].stopCode);
+    startFetch(stopCodeDataArray[currentStopCodeIndex].stopCode);
+  }
+
+  // One bounded slice of the request per pass
+  if (fetcher.busy()) {
+    CRASH_ENTER(fetchPhase(fetcher.state()));
+    PROFILE_RESUME();
+    Fetcher::State state = fetcher.poll();
+    if (state == Fetcher::DONE || state == Fetcher::FAILED) {
+      finishFetch(state == Fetcher::DONE);  // inflate and parse
     }
-    Serial.println("");
-    Serial.println("");
+    PROFILE_PAUSE();
   }
+
+  submitPendingFrame();  // retry a frame that didn't fit in the render queue
+  reportFrameLatency();
+#if USE_METRICS
+  metricsServer.poll();
+#endif
+
+  unsigned long passMicros = micros() - passStart;
+  if (passMicros > worstLoopMicros) worstLoopMicros = passMicros;
+
+  // Let the log out between fetches, as much as the USB buffer takes
+  if (!fetcher.busy()) Log::flush(Serial);
 }
 
 // (watchdog feeder lives up top now — see petWatchdog() / startDisplayWatchdog())
 
+#if USE_RENDER_CORE
+// core1: wait for snapshots and draw the newest one. See the render core
+// notes up top for what this side may and may not do.
+void setup1() {
+#if MEM_STATS
+  MemStats::paintCore1();
+#endif
+#if PROFILER
+  Profiler::begin();
+#endif
+}
+
+void loop1() {
+  static FrameSnapshot frame;  // static: keep ~1 KB off core1's small stack
+  static bool refreshing = false;
+  static uint32_t refreshingSeq = 0;
+  static uint32_t refreshingFetchedAt = 0;
+  static uint32_t refreshingRenderUs = 0;
+  static uint32_t refreshingUploadUs = 0;
+  static uint32_t refreshingUploadedAt = 0;
+  bool haveFrame = false;
+
+  // Skip straight to the newest frame if several piled up during a refresh
+  while (renderQueue.pop(frame)) {
+    if (haveFrame) framesSkipped = framesSkipped + 1;  // core1 is the only writer
+    haveFrame = true;
+  }
+
+  if (haveFrame) {
+    // Draws into the back buffer; the panel may still be refreshing the last one
+    CRASH_ENTER_CORE1(PHASE_RENDER);
+    uint32_t renderStart = micros();
+    PROFILE_RESUME();
+    renderFrame(frame);
+    PROFILE_PAUSE();
+    uint32_t renderTook = micros() - renderStart;
+
+    if (refreshing) {
+      CRASH_ENTER_CORE1(PHASE_BUSY);
+      display.waitUntilIdle();
+      frameOnGlass(refreshingSeq, refreshingFetchedAt, refreshingRenderUs, refreshingUploadUs, refreshingUploadedAt);
+    }
+    CRASH_ENTER_CORE1(PHASE_UPLOAD);
+    uint32_t uploadStart = micros();
+    PROFILE_RESUME();
+    display.displayAsync();
+    PROFILE_PAUSE();
+#if USE_ASSET_FS
+    logoStore.release(frame.sequence);  // uploaded: its logos may be reloaded now
+#endif
+    CRASH_ENTER_CORE1(PHASE_BUSY);
+    refreshing = true;
+    refreshingSeq = frame.sequence;
+    refreshingFetchedAt = frame.fetchedAt;
+    refreshingRenderUs = renderTook;
+    refreshingUploadedAt = micros();
+    refreshingUploadUs = refreshingUploadedAt - uploadStart;
+  } else if (refreshing && !display.isBusy()) {
+    frameOnGlass(refreshingSeq, refreshingFetchedAt, refreshingRenderUs, refreshingUploadUs, refreshingUploadedAt);
+    CRASH_ENTER_CORE1(CrashLog::PHASE_IDLE);
+    refreshing = false;
+  } else {
+    delay(10);
+  }
+}
+#endif
+
 void resetDevice() {
   // On occasion of the WiFi not working, need to tell the user.
   display.begin();
@@ -304,6 +660,9 @@ void resetDevice() {
 
   // Reset the Pico
   #if defined(ARDUINO_ARCH_RP2040)
+  #if USE_CRASH_LOG
+    CrashLog::noteReason(CrashLog::REASON_NO_WIFI, false);
+  #endif
     watchdog_enable(1, 1);  // 1ms timeout; the while(1) below never pets, so we reboot
     while(1);  // Wait for watchdog to reset
   #else
@@ -311,605 +670,672 @@ void resetDevice() {
   #endif
 }
 
-bool connectToWiFiWithTimeout() {
-  Serial.print("Connecting to WiFi");
-  
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(ssid, password);
-  
-  // Try to connect for 3 minutes (180 seconds)
-  const unsigned long timeout = 180000; // 3 minutes in milliseconds
-  unsigned long startTime = millis();
-  
-  while (WiFi.status() != WL_CONNECTED) {
-    petWatchdog();
-    // Check if timed out
-    if (millis() - startTime > timeout) {
-      Serial.println("\nWiFi connection timed out after 3 minutes!");
-      return false;
+// Starts associating with the access point and returns right away
+void startBoot() {
+  CRASH_ENTER(PHASE_WIFI);
+  Serial.println("Connecting to WiFi");
+  netCache.startLink(ssid, password);
+  bootLinkStartAt = millis();
+}
+
+// Drops back to waiting for the link, after it went down or has to be
+// rejoined; pollBoot() takes it from there
+void relink() {
+  relinks++;
+  fetcher.release();
+  startBoot();
+  bootStage = BOOT_LINK;
+}
+
+// The pipeline phase a Fetcher state belongs to, for the crash record
+uint8_t fetchPhase(Fetcher::State state) {
+  switch (state) {
+    case Fetcher::RESOLVE: return PHASE_DNS;
+    case Fetcher::CONNECT: return PHASE_TLS;  // TCP connect and handshake, one call
+    case Fetcher::SEND:
+    case Fetcher::HEADERS: return PHASE_FIRST_BYTE;
+    case Fetcher::BODY:    return PHASE_DOWNLOAD;
+    default:               return CrashLog::PHASE_IDLE;
+  }
+}
+
+// Fetcher's DNS lookup: the cached address while it's fresh
+bool resolveHost(const char* host, IPAddress& ip) {
+  return netCache.resolve(host, ip);
+}
+
+// Called from loop() until the link is up, then hands over to the fetch cycle
+void pollBoot() {
+  if (!netCache.pollLink()) {
+    // After the first frame core1 owns the display: a rejoin that never
+    // comes up is left to the display watchdog instead
+    if (!frameHandedOver && millis() - bootLinkStartAt > WIFI_TIMEOUT_MS) {
+      Serial.println("WiFi connection timed out after 3 minutes!");
+      resetDevice(); // Loop back to the beginning, we're fucked.
     }
-    
-    delay(500);
-    Serial.print(".");
+    delay(10);
+    return;
   }
-  
-  Serial.println("\nConnected to WiFi!");
-  Serial.print("IP address: ");
+
+  if (bootLinkUpAt == 0) bootLinkUpAt = millis();
+#if USE_METRICS
+#if !MT_EPD_BAND_MODE
+  metricsServer.setFrameSource(beginFrameSnapshot);
+#endif
+#if PROFILER
+  metricsServer.setProfileSource(Profiler::dump);
+#endif
+  metricsServer.begin();
+#endif
+  Serial.print("Connected to WiFi, IP address: ");
   Serial.println(WiFi.localIP());
-  
-  return true;
+  bootStage = BOOT_RUNNING;  // loop()'s first pass starts the first fetch
 }
 
 String CurrentTimeToString(time_t time) {
     char timeString[20];
 
     snprintf(timeString, sizeof(timeString), "%04d-%02d-%02d %02d:%02d:%02d", 
-             year(time), month(time), day(time), hour(time), minute(time));
+             year(time), month(time), day(time), hour(time), minute(time), second(time));
 
     return String(timeString);
 }
 
-time_t iso8601ToEpoch(String datetime) {
-    tmElements_t tm;
+void startFetch(const String& stopCode) {
+  LOG_DEBUG("Got to startFetch");
 
-    int Year, Month, Day, Hour, Minute, Second;
-    sscanf(datetime.c_str(), "%d-%d-%dT%d:%d:%dZ", &Year, &Month, &Day, &Hour, &Minute, &Second);
+  String path = "/transit/StopMonitoring?api_key=" + 
+               APIkey + "&agency=SF&stopCode=" + stopCode + "&format=json";
 
-    tm.Year = Year - 1970; // tmElements_t.Year is the number of years since 1970
-    tm.Month = Month;
-    tm.Day = Day;
-    tm.Hour = Hour;
-    tm.Minute = Minute;
-    tm.Second = Second;
+  // Built once; the Fetcher resends it unchanged on every retry
+  String request = "GET " + path + " HTTP/1.1\r\n";
+  request += "Host: " + String(server) + "\r\n";
+  request += "User-Agent: " + User_Agent + "\r\n";
+  request += "Connection: close\r\n\r\n";
 
-    return makeTime(tm);
+  fetchStartedAt = millis();
+  fetcher.begin(request);
 }
 
-
-void printHexBuffer(const uint8_t* buffer, size_t length) {
-  for (size_t i = 0; i < length; i++) {
-    if (buffer[i] < 0x10) {
-      Serial.print("0"); // Add leading zero for values < 0x10
-    }
-    Serial.print(buffer[i], HEX);
-    Serial.print(" ");
-    if ((i + 1) % 16 == 0) { // Line break every 16 bytes
-      Serial.println();
-    }
+// Runs once the Fetcher lands in DONE or FAILED: inflate, parse, redraw.
+void finishFetch(bool ok) {
+  // Every attempt counts against the API's hourly budget
+  for (uint8_t i = 0; i < fetcher.attempts(); i++) {
+    apiRequestAt[apiRequestNext] = millis();
+    apiRequestNext = (apiRequestNext + 1) % API_REQUESTS_PER_HOUR;
+    apiRequests++;
   }
-  Serial.println(); // Final newline
-}
-
-void getData(String stopCode) {
-  const int maxRetries = 3;
-  int retryCount = 0;
-  bool requestSuccess = false;
+  if (!ok) fetchFailures++;
+#if USE_METRICS
+  pollLatency.observe(millis() - fetchStartedAt);
+#endif
 
-  #ifdef DEBUG_MODE
-  Serial.println("Got to getData");
-  Serial.println("Attempting to connect to server...");
-  #endif
+  // The whole request (TLS session, body buffer) is filed under download
+  MEM_NOTE(PHASE_DOWNLOAD, fetchMark);
+  if (ok) {
+    // The first two bytes say whether it's gzip (1f 8b), without dumping the lot
+    LOG_DEBUG("Body length: %u, starts %02x %02x", fetcher.bodyLength(),
+              fetcher.body()[0], fetcher.bodyLength() > 1 ? fetcher.body()[1] : 0);
+    lastFetchDoneAt = millis();
+    if (bootFirstFetchAt == 0) bootFirstFetchAt = lastFetchDoneAt;
+    CRASH_ENTER(PHASE_INFLATE);
+    PHASE_STAMP(inflateAt);
+    MEM_MARK(inflateMem);
+    decompressGzippedData(fetcher.body(), fetcher.bodyLength());
+    MEM_NOTE(PHASE_INFLATE, inflateMem);
+    PHASE_ADD(PHASE_INFLATE, inflateAt);
+  } else {
+    inflater.release();
+  }
+  fetcher.release();
 
-  while (!requestSuccess && retryCount < maxRetries) {
-    petWatchdog();
-    // Make sure we start with a fresh connection
-    client.stop();
-    delay(100);  // Give it a moment to clean up
-
-    #ifdef DEBUG_MODE
-    Serial.print("Connecting to: ");
-    Serial.print(server);
-    Serial.println(":443");
-    #endif
-
-    if (!client.connect(server, 443)) {
-      Serial.println("Connection failed! Check server name, WiFi, or SSL.");
-      retryCount++;
-      delay(1000);
-      continue;
-    }
+  if (!ok) {
+    // The cached address may take a connect and still not be the API
+    netCache.forgetAddress(server);
+  }
+  if (!ok && netCache.leaseInUse()) {
+    // Maybe the address is someone else's by now: rejoin with DHCP
+    LOG_WARN("Fetch failed on a reused lease, rejoining for DHCP");
+    netCache.forgetLease();
+    relink();
+  }
 
-    #ifdef DEBUG_MODE
-    Serial.println("Connected to server! Sending request...");
-    #endif
+  LOG_DEBUG("%s", CurrentTimeToString(currentTime));
+  removeOldArrivals();
+
+  LOG_INFO("Data length: %u", inflater.length());
+
+  uint32_t produced = 0;  // frame this cycle made, if any
+  if (inflater.length() > 0) {
+      CRASH_ENTER(PHASE_PARSE);
+      PHASE_STAMP(parseAt);
+      MEM_MARK(parseMem);
+      parseAndFormatBusArrivals(inflater.text(), inflater.length());
+      inflater.release();  // the arrivals are copied out
+      MEM_NOTE(PHASE_PARSE, parseMem);
+      PHASE_ADD(PHASE_PARSE, parseAt);
+      CRASH_ENTER(PHASE_AGGREGATE);
+      PHASE_STAMP(aggregateAt);
+      MEM_MARK(aggregateMem);
+      displayArrivals();
+      PHASE_ADD(PHASE_AGGREGATE, aggregateAt);
+      currentStopCodeIndex = (currentStopCodeIndex + 1) % (sizeof(stopCodes)/sizeof(stopCodes[0]));
+      updateDisplay();
+      MEM_NOTE(PHASE_AGGREGATE, aggregateMem);
+      produced = frameSequence;
+  } else {
+      LOG_WARN("No data or failed to fetch data");
+  }
 
-    String path = "/transit/StopMonitoring?api_key=" + 
-                 APIkey + "&agency=SF&stopCode=" + stopCode + "&format=json";
+  LOG_INFO("Worst loop pass: %lu us", worstLoopMicros);
+  worstLoopMicros = 0;
+
+  static uint32_t cycles = 0;
+  bool reportNow = ++cycles % PHASE_REPORT_CYCLES == 0;
+  (void)reportNow;
+#if PHASE_TIMING
+  phaseTimer.endCycle(produced);
+  if (reportNow) phaseTimer.report(Serial);
+#else
+  (void)produced;
+#endif
+#if MEM_STATS
+  memStats.printLine(Serial);
+  if (reportNow) memStats.report(Serial);
+#endif
+#if USE_CRASH_LOG && PHASE_TIMING
+  crashLog.noteTimings(phaseTimer);
+#endif
+#if USE_CRASH_LOG && MEM_STATS
+  crashLog.noteMemory(memStats);
+#endif
+  CRASH_ENTER(CrashLog::PHASE_IDLE);
+}
 
-    // Send HTTP request
-    String request = "GET " + path + " HTTP/1.1\r\n";
-    request += "Host: " + String(server) + "\r\n";
-    request += "User-Agent: " + User_Agent + "\r\n";
-    request += "Connection: close\r\n\r\n";
-    
-    // Send the complete request at once
-    client.print(request);
+void decompressGzippedData(const uint8_t *gzippedData, size_t gzippedDataSize) {
+  LOG_DEBUG("Attempting to decompress data of size: %u", gzippedDataSize);
 
-    // Wait a bit for the response to start coming in
-    delay(100);
+  switch (inflater.unpack(gzippedData, gzippedDataSize)) {
+    case GzipInflater::INFLATED:
+      LOG_DEBUG("Decompressed data: %s...", inflater.text());
+      break;
+    case GzipInflater::NO_MEMORY:
+      LOG_ERROR("Failed to allocate %u bytes for decompression", inflater.wanted());
+#if MEM_STATS
+      memStats.noteFailure(PHASE_INFLATE, inflater.wanted());
+#endif
+      break;
+    case GzipInflater::NOT_GZIP:
+      LOG_DEBUG("Invalid gzip data or couldn't determine uncompressed size");
+      break;
+    case GzipInflater::CORRUPT:
+      LOG_DEBUG("Decompression failed.");
+      break;
+  }
+}
 
-    // Read the response while the connection is alive
-    String response = "";
-    unsigned long timeout = millis();
-    
-    while (client.connected() && (millis() - timeout < 5000)) {
-      petWatchdog();
-      while (client.available()) {
-        char c = client.read();
-        response += c;
-        timeout = millis();  // Reset timeout when we receive data
-      }
-    }
+void parseAndFormatBusArrivals(const char* json, size_t length) {
+  StopCodeData& stop = stopCodeDataArray[currentStopCodeIndex];
+  StopMonitorParser::Result result = parser.parse(json, length, stop);
+  if (result == StopMonitorParser::NO_MEMORY) {
+    LOG_ERROR("Failed to allocate the JSON document");
+#if MEM_STATS
+    memStats.noteFailure(PHASE_PARSE, StopMonitorParser::DOCUMENT_BYTES);
+#endif
+    return;
+  }
+  if (result == StopMonitorParser::BAD_JSON) {
+    LOG_DEBUG("deserializeJson() failed: %s", parser.error());
+    return;
+  }
 
-    // Clean up the connection
-    client.stop();
-
-    if (response.length() > 0) {
-      #ifdef DEBUG_MODE
-      Serial.println("\nResponse received:");
-      Serial.println(response);
-      #endif
-      // Look for the end of headers (double newline)
-      int bodyStart = response.indexOf("\r\n\r\n");
-      if (bodyStart > 0) {
-        String body = response.substring(bodyStart + 4);
-        #ifdef DEBUG_MODE
-        Serial.println("\nBody length: " + String(body.length()));
-        #endif
-        // Convert to bytes for decompression
-        size_t bodyLen = body.length();
-        uint8_t* bodyBytes = (uint8_t*)malloc(bodyLen);
-        if (bodyBytes != nullptr) {
-          memcpy(bodyBytes, body.c_str(), bodyLen);
-          #ifdef DEBUG_MODE
-          printHexBuffer(bodyBytes, bodyLen);  // Print hex values
-          #endif
-          decompressGzippedData(bodyBytes, (size_t)bodyLen);  // Explicitly cast to size_t
-          free(bodyBytes);
-          requestSuccess = true;
-        } else {
-          #ifdef DEBUG_MODE
-          Serial.println("Failed to allocate memory for body");
-          #endif
-        }
-      }
-    } else {
-      #ifdef DEBUG_MODE
-      Serial.println("No response received");
-      #endif
-      retryCount++;
-    }
+  if (parser.serverTime() != 0) {
+    setTime(parser.serverTime());
+    currentTime = parser.serverTime();
+    netCache.noteServerTime(parser.serverTime());
   }
+  stop.fetchedAt = millis();
 
-  if (!requestSuccess) {
+#if USE_ARRIVAL_JOURNAL
+  journalStopArrivals(currentStopCodeIndex);
+#endif
+}
 
-    #ifdef DEBUG_MODE
-    Serial.println("Failed to get data after all retries");
-    #endif
-    globalUncompressedDataStr = "";
+#if USE_ARRIVAL_JOURNAL
+// Appends a stop's freshly parsed arrivals to the journal
+void journalStopArrivals(int stopCodeIndex) {
+  StopCodeData& stop = stopCodeDataArray[stopCodeIndex];
+  ArrivalJournal::Arrival entries[MAX_ARRIVALS];
+  for (int i = 0; i < stop.arrivalCount; i++) {
+    BusArrival& arrival = stop.arrivals[i];
+    entries[i].lineRef = arrival.lineRef;
+    entries[i].expected = arrival.expectedArrivalEpoch;
+    entries[i].destination = arrival.destinationDisplay;
+    entries[i].stopPoint = arrival.stopPointName;
+  }
+  if (!arrivalJournal.append(stop.stopCode, currentTime, entries, stop.arrivalCount)) {
+    LOG_WARN("Couldn't journal the arrivals");
   }
 }
 
-void decompressGzippedData(const uint8_t *gzippedData, size_t gzippedDataSize) {
-  #ifdef DEBUG_MODE
-  Serial.print("Attempting to decompress data of size: ");
-  Serial.println(gzippedDataSize);
-  #endif
-
-  // Find the start of the gzip data by looking for the gzip magic numbers
-  size_t dataStart = 0;
-  for (size_t i = 0; i < gzippedDataSize - 1; i++) {
-    if (gzippedData[i] == 0x1F && gzippedData[i + 1] == 0x8B) {
-      dataStart = i;
-      break;
+// ArrivalJournal::replay() visitor: puts a stop's journalled arrivals back
+void restoreStopArrivals(const char* stopCode, uint32_t serverTime,
+                         const ArrivalJournal::Arrival* arrivals, uint8_t count) {
+  for (int i = 0; i < sizeof(stopCodes)/sizeof(stopCodes[0]); i++) {
+    StopCodeData& stop = stopCodeDataArray[i];
+    if (strcmp(stop.stopCode, stopCode) != 0) continue;  // the journal may have stops no longer configured
+
+    stop.arrivalCount = min((int)count, MAX_ARRIVALS);
+    for (int j = 0; j < stop.arrivalCount; j++) {
+      BusArrival& arrival = stop.arrivals[j];
+      copyText(arrival.lineRef, sizeof(arrival.lineRef), arrivals[j].lineRef);
+      arrival.expectedArrivalEpoch = arrivals[j].expected;
+      copyText(arrival.destinationDisplay, sizeof(arrival.destinationDisplay), arrivals[j].destination);
+      copyText(arrival.stopPointName, sizeof(arrival.stopPointName), arrivals[j].stopPoint);
     }
-  }
 
-  // Get the actual gzipped data size
-  size_t actualGzipSize = gzippedDataSize - dataStart;
-  
-  // Use the getUncompressedLength function to determine the expected uncompressed size
-  uint32_t expectedUncompressedSize = getUncompressedLength(gzippedData + dataStart, actualGzipSize);
-  
-  if (expectedUncompressedSize == 0) {
-    #ifdef DEBUG_MODE
-    Serial.println("Invalid gzip data or couldn't determine uncompressed size");
-    #endif
+    Serial.print("Journal: stop ");
+    Serial.print(stopCode);
+    Serial.print(", ");
+    Serial.print(stop.arrivalCount);
+    Serial.print(" arrivals as of ");
+    Serial.println(CurrentTimeToString(serverTime));
     return;
   }
+}
+#endif
 
-  uint8_t *uncompressedData = (uint8_t *)malloc(expectedUncompressedSize);
-  if (uncompressedData == NULL) {
-    #ifdef DEBUG_MODE
-    Serial.println("Failed to allocate memory for decompression.");
-    #endif
-    return;
+void removeOldArrivals() {
+  for (int i = 0; i < sizeof(stopCodes) / sizeof(stopCodes[0]); i++) {
+    ArrivalBoard::dropPast(stopCodeDataArray[i], now());
   }
+}
 
-  // The gzip header is usually 10 bytes
-  const size_t gzipHeaderSize = 10;
-  const uint8_t *deflateData = gzippedData + dataStart + gzipHeaderSize;
-  size_t deflateDataSize = actualGzipSize - gzipHeaderSize - 8; // Subtract 8 bytes for the gzip footer
-
-  mz_ulong outBytes = expectedUncompressedSize;
-  int status = tinfl_decompress_mem_to_mem(uncompressedData, outBytes, deflateData, deflateDataSize, 0);
-
-  if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED) {
-    #ifdef DEBUG_MODE
-    Serial.println("Decompression failed.");
-    #endif
-  } 
-  else {
-    #ifdef DEBUG_MODE
-    Serial.println("Decompression successful.");
-    #endif
-    globalUncompressedDataStr = "";
-
-    // Convert uncompressed data to String
-    for (size_t i = 0; i < outBytes; ++i) {
-      globalUncompressedDataStr += (char)uncompressedData[i];
-    }
-    #ifdef DEBUG_MODE
-    Serial.println("Decompressed data:");
-    Serial.println(globalUncompressedDataStr);
-    #endif
+void displayArrivals() {
+  currentTime = now(); // Ensure we have the current time updated
 
+  for (int stopCodeIndex = 0; stopCodeIndex < sizeof(stopCodes) / sizeof(stopCodes[0]); stopCodeIndex++) {
+    // One stop's arrivals, merged per line like the board's rows
+    ArrivalBoard stopBoard;
+    uint8_t rows = stopBoard.layout(&stopCodeDataArray[stopCodeIndex], 1, currentTime, BOARD_MAX_ROWS);
+
+    // Now log the aggregated information
+    for (uint8_t i = 0; i < rows; i++) {
+      const BoardRow& row = stopBoard.row(i);
+      LOG_INFO("%s to %s in %s minutes at %s", row.lineRef, row.destination, row.times, row.stopPoint);
+    }
+  }
+}
 
+// Builds a FrameSnapshot from the arrival data and hands it to the renderer.
+// Runs on core0: the logos may come off the filesystem.
+void updateDisplay() {
+  PHASE_STAMP(aggregateAt);
+
+  FrameSnapshot& frame = pendingFrame;
+  frame.sequence = ++frameSequence;
+  frame.fetchedAt = lastFetchDoneAt;
+  frame.rowCount = board.layout(stopCodeDataArray, sizeof(stopCodes) / sizeof(stopCodes[0]),
+                                currentTime, FRAME_MAX_ROWS);
+  for (uint8_t i = 0; i < frame.rowCount; i++) {
+    FrameRow& row = frame.rows[i];
+    static_cast<BoardRow&>(row) = board.row(i);
+    row.logo = getTransitLogo(row.lineRef, frame.sequence);
   }
-  free(uncompressedData);
+  
+  PHASE_ADD(PHASE_AGGREGATE, aggregateAt);  // not the inline render or the flash save below
+  if (framePending) framesReplaced++;  // the last one never made it to core1
+  framePending = true;
+  submitPendingFrame();
+#if USE_WARM_BOOT
+  saveLastFrame(frame);
+#endif
 }
 
+// Hands pendingFrame to the renderer. With the render core the queue may be
+// full while core1 is still refreshing; loop() calls this again every pass,
+// and a newer updateDisplay() simply overwrites the pending frame.
+void submitPendingFrame() {
+  if (!framePending) return;
+#if USE_RENDER_CORE
+  if (renderQueue.push(pendingFrame)) {
+    framePending = false;
+    frameHandedOver = true;
+  }
+#else
+  framePending = false;
+  frameHandedOver = true;
+  CRASH_ENTER(PHASE_RENDER);
+  uint32_t renderStart = micros();
+  renderFrame(pendingFrame);
+  CRASH_ENTER(PHASE_UPLOAD);
+  uint32_t uploadStart = micros();
+  display.displayAsync();
+  uint32_t uploadedAt = micros();
+#if USE_ASSET_FS
+  logoStore.release(pendingFrame.sequence);  // uploaded: its logos may be reloaded now
+#endif
+  CRASH_ENTER(PHASE_BUSY);
+  display.waitUntilIdle();
+  frameOnGlass(pendingFrame.sequence, pendingFrame.fetchedAt,
+               uploadStart - renderStart, uploadedAt - uploadStart, uploadedAt);
+#endif
+}
 
-uint32_t getUncompressedLength(const uint8_t* data, size_t dataSize) {
-    if (dataSize < 4) return 0; // this isn't right, bail.
+// Draws a snapshot into the planes. The caller pushes them to the panel, then
+// releases the frame's logos: in band mode the display list still points
+// into the LogoStore slots until displayAsync() has replayed it. Runs on
+// core1 with the render core enabled, so: no String, no malloc, no Serial
+// (see loop1()).
+void renderFrame(const FrameSnapshot& frame) {
+  // Clear the display
+  display.clearDisplay();
+  
+  for (int i = 0; i < frame.rowCount; i++) {
+    const FrameRow& row = frame.rows[i];
+    
+    // Calculate vertical position (lines are stacked from top down)
+    int displayY = i * ROW_HEIGHT;
+    
+    // Logo and labels, pasted from the tile cache when the row hasn't changed
+#if USE_ROW_TILE_CACHE
+    rowTiles.draw(row, displayY);
+#else
+    paintRowLogo(row, displayY);
+    paintRowLabels(row, displayY);
+#endif
+    
+    // Draw arrival times in larger FreeSansBold24pt7b font, from the
+    // pre-rotated digit atlas (Scripts/fontatlas.py)
+    display.setSpanFont(&FreeSansBold24pt7bDigits);
+    display.setTextColor(MT_EPD::EPD_BLACK);  // a cached row skips paintRowLabels()
+    display.setCursor(150, displayY + 115);
+    display.printNative(DigitAtlas, row.times);
+    display.println();
+  }
+  display.setSpanFont(NULL);
+}
 
-    // The uncompressed size is stored in the last 4 bytes
-    // of the gzip stream in little-endian format
-    uint32_t uncompressedSize = data[dataSize - 4]
-        | (data[dataSize - 3] << 8)
-        | (data[dataSize - 2] << 16)
-        | (data[dataSize - 1] << 24);
+// Draws the line's logo for a row whose top is at y
+void paintRowLogo(const FrameRow& row, int16_t y) {
+  display.drawNativeBitmap(0, y, *row.logo, MT_EPD::EPD_BLACK);
+}
 
-    return uncompressedSize;
+// Draws a row's destination and stop lines in FreeSans12pt7b
+void paintRowLabels(const FrameRow& row, int16_t y) {
+  display.setSpanFont(&FreeSans12pt7bSpans);
+  display.setCursor(135, y + 25);
+  display.setTextColor(MT_EPD::EPD_BLACK);
+  display.print("To ");
+  display.println(row.destination);
+  
+  // Draw stop info
+  display.setCursor(135, y + 60);
+  display.print("From ");
+  display.println(row.stopPoint);
 }
 
-void parseAndFormatBusArrivals(const String& jsonData) {
-  // Clear existing data for the current stop code
-  stopCodeDataArray[currentStopCodeIndex].arrivalCount = 0;
+// Called once a frame's refresh has finished, from whichever core drives the
+// panel, with how long it took to draw and upload and when the upload ended.
+// Only plain stores: core0 picks the numbers up in reportFrameLatency().
+void frameOnGlass(uint32_t sequence, uint32_t fetchedAt,
+                  uint32_t renderTook, uint32_t uploadTook, uint32_t uploadedAt) {
+  busyUs = micros() - uploadedAt;
+  renderUs = renderTook;
+  uploadUs = uploadTook;
+  lastDisplayUpdate = millis();  // pet the display watchdog: a fresh frame was drawn
+  glassLatencyMs = lastDisplayUpdate - fetchedAt;
+  refreshes = refreshes + 1;     // one writer: whichever core drives the panel
+  framesOnGlass = sequence;
+}
 
-  // The first characters I'm getting are 0xEF 0xBB 0xBF, a byte order mark.
-  //I need to delete those before deserializing.
-  String cleanJsonData = jsonData.substring(3); 
+// Prints fetch-to-glass latency on core0 whenever a new frame has landed.
+void reportFrameLatency() {
+  static uint32_t reported = 0;
+  uint32_t landed = framesOnGlass;
+  if (landed == reported) return;
+  reported = landed;
 
-  DynamicJsonDocument doc(40000);
+  LOG_INFO("Frame %lu on glass %lu ms after fetch (render %lu ms, upload %lu ms, refresh %lu ms)",
+           landed, (uint32_t)glassLatencyMs, renderUs / 1000, uploadUs / 1000, busyUs / 1000);
 
-  DeserializationError error = deserializeJson(doc, cleanJsonData);
+#if PHASE_TIMING
+  phaseTimer.addToFrame(landed, PHASE_RENDER, renderUs);
+  phaseTimer.addToFrame(landed, PHASE_UPLOAD, uploadUs);
+  phaseTimer.addToFrame(landed, PHASE_BUSY, busyUs);
+#endif
 
-  if (error) {
-    #ifdef DEBUG_MODE
-    Serial.print(F("deserializeJson() failed: "));
-    Serial.println(error.f_str());
-    #endif
-    return;
+  if (!bootReported) {
+    bootReported = true;
+    Serial.print("Boot: splash at ");
+    Serial.print(bootSplashAt);
+    Serial.print(" ms, WiFi up at ");
+    Serial.print(bootLinkUpAt);
+    Serial.print(" ms, first fetch at ");
+    Serial.print(bootFirstFetchAt);
+    Serial.print(" ms, first arrivals on glass at ");
+    Serial.print(lastDisplayUpdate);
+    Serial.println(" ms");
   }
+}
 
-  // Extract the ResponseTimestamp from the JSON data
-  const char* responseTimestamp = doc["ServiceDelivery"]["ResponseTimestamp"];
-  if (responseTimestamp) {
-      // Convert ISO8601 to epoch
-      time_t serverTime = iso8601ToEpoch(String(responseTimestamp));
+#if USE_METRICS
+// Writes the /metrics page. Core0, from metricsServer.poll(); reads core1's
+// counters as plain loads.
+void collectMetrics(MetricsWriter& out) {
+  unsigned long now = millis();
 
-      //Serial.print(F("Server Time (epoch): "));
-      //Serial.println(serverTime);
+  pollLatency.write(out, "nextbus_poll_duration_seconds", "Fetch start to finish, retries included");
+  out.family("nextbus_fetch_failures_total", "counter", "Fetches that gave up");
+  out.value("nextbus_fetch_failures_total", fetchFailures);
 
-      setTime(serverTime);
-      currentTime = serverTime;
+  uint32_t lastHour = 0;
+  for (uint8_t i = 0; i < API_REQUESTS_PER_HOUR; i++) {
+    if (apiRequestAt[i] != 0 && now - apiRequestAt[i] < 3600000UL) lastHour++;
+  }
+  out.family("nextbus_api_requests_total", "counter", "HTTP requests sent to the 511 API");
+  out.value("nextbus_api_requests_total", apiRequests);
+  out.family("nextbus_api_requests_last_hour", "gauge", "Requests in the last hour, against the budget");
+  out.value("nextbus_api_requests_last_hour", lastHour);
+  out.family("nextbus_api_budget_per_hour", "gauge", "Requests the API key is allowed per hour");
+  out.value("nextbus_api_budget_per_hour", (uint32_t)API_REQUESTS_PER_HOUR);
+
+  out.family("nextbus_stop_data_age_seconds", "gauge", "Since each stop's last good fetch");
+  for (int i = 0; i < sizeof(stopCodes) / sizeof(stopCodes[0]); i++) {
+    if (stopCodeDataArray[i].fetchedAt == 0) continue;  // not fetched since boot
+    out.value("nextbus_stop_data_age_seconds", "stop", stopCodeDataArray[i].stopCode,
+              (now - stopCodeDataArray[i].fetchedAt) / 1000.0f);
   }
 
-  JsonArray arr = doc["ServiceDelivery"]["StopMonitoringDelivery"]["MonitoredStopVisit"];
-    int count = 0;
-    for(JsonObject obj : arr) {
-        if (count >= MAX_ARRIVALS) break; // Prevent overflow of arrivals array
+  out.family("nextbus_refreshes_total", "counter", "Frames that reached the glass");
+  out.value("nextbus_refreshes_total", (uint32_t)refreshes);
+  out.family("nextbus_refreshes_suppressed_total", "counter", "Frames dropped for a newer one before reaching the glass");
+  out.value("nextbus_refreshes_suppressed_total", (uint32_t)(framesReplaced + framesSkipped));
+  out.family("nextbus_glass_latency_seconds", "gauge", "Fetch finished to the last frame's refresh finished");
+  out.value("nextbus_glass_latency_seconds", glassLatencyMs / 1000.0f);
+
+#if MEM_STATS
+  const MemStats::Heap& heap = memStats.heap();  // as of the last fetch
+  out.family("nextbus_heap_used_bytes", "gauge", "Heap in use at the last sample");
+  out.value("nextbus_heap_used_bytes", heap.used);
+  out.family("nextbus_heap_used_peak_bytes", "gauge", "Most heap in use at any sample");
+  out.value("nextbus_heap_used_peak_bytes", heap.usedPeak);
+  out.family("nextbus_heap_arena_peak_bytes", "gauge", "Heap arena high-water mark");
+  out.value("nextbus_heap_arena_peak_bytes", heap.arenaPeak);
+  out.family("nextbus_heap_largest_free_bytes", "gauge", "Largest free block at the last sample");
+  out.value("nextbus_heap_largest_free_bytes", heap.largest);
+  out.family("nextbus_stack_peak_bytes", "gauge", "Stack high-water mark per core");
+  out.value("nextbus_stack_peak_bytes", "core", "0", (float)memStats.core0Stack().peak);
+  out.value("nextbus_stack_peak_bytes", "core", "1", (float)memStats.core1Stack().peak);
+#endif
 
-        String lineRef = obj["MonitoredVehicleJourney"]["LineRef"].as<String>();
-        String expectedArrivalTimeStr = obj["MonitoredVehicleJourney"]["MonitoredCall"]["ExpectedArrivalTime"].as<String>();
-        String destinationDisplay = obj["MonitoredVehicleJourney"]["MonitoredCall"]["DestinationDisplay"].as<String>();
-        String stopPointName = obj["MonitoredVehicleJourney"]["MonitoredCall"]["StopPointName"].as<String>();
+  out.family("nextbus_wifi_rssi_dbm", "gauge", "Signal strength of the access point");
+  out.value("nextbus_wifi_rssi_dbm", (int32_t)WiFi.RSSI());
+  out.family("nextbus_wifi_rejoins_total", "counter", "Rejoins after a dropped link or an old lease");
+  out.value("nextbus_wifi_rejoins_total", relinks);
 
-        // Store the arrival data
-        BusArrival& arrival = stopCodeDataArray[currentStopCodeIndex].arrivals[count];
-        arrival.lineRef = lineRef;
-        arrival.expectedArrivalTimeStr = expectedArrivalTimeStr;
-        arrival.destinationDisplay = destinationDisplay;
-        arrival.stopPointName = stopPointName;
+#if USE_CRASH_LOG
+  out.family("nextbus_resets_total", "counter", "Resets by cause, kept in flash");
+  for (uint8_t c = 0; c < CrashLog::CAUSE_COUNT; c++) {
+    out.value("nextbus_resets_total", "cause", CrashLog::name((CrashLog::Cause)c),
+              (float)crashLog.count((CrashLog::Cause)c));
+  }
+#endif
 
-        count++;
-    }
-    // Update the count of arrivals for the current stop code
-    stopCodeDataArray[currentStopCodeIndex].arrivalCount = count;
-}
+  out.family("nextbus_log_dropped_total", "counter", "Log records dropped on a full ring");
+  out.value("nextbus_log_dropped_total", Log::dropped());
 
-void removeOldArrivals() {
-    int i = 0;
-    while (i < arrivalCount) {
-        time_t expectedArrivalEpoch = iso8601ToEpoch(arrivals[i].expectedArrivalTimeStr);
-        if (expectedArrivalEpoch <= now()) {
-            // Shift all subsequent arrivals one position to the left
-            for (int j = i; j < arrivalCount - 1; j++) {
-                arrivals[j] = arrivals[j + 1];
-            }
-            arrivalCount--; // Decrease the count of arrivals
-        } else {
-            i++; // Only increase if if we didn't remove an arrival
-        }
-    }
+  out.family("nextbus_uptime_seconds", "gauge", "Since boot");
+  out.value("nextbus_uptime_seconds", (uint32_t)(now / 1000));
 }
 
-void displayArrivals() {
-  Serial.println();
-  currentTime = now(); // Ensure we have the current time updated
-
-  for (int stopCodeIndex = 0; stopCodeIndex < sizeof(stopCodes) / sizeof(stopCodes[0]); stopCodeIndex++) {
-    String lineRefs[100];
-    String destinations[100];
-    String stopPoints[100];
-    String minutesLists[100];
-    int uniqueLines = 0;
-
-    for (int arrivalIndex = 0; arrivalIndex < stopCodeDataArray[stopCodeIndex].arrivalCount; arrivalIndex++) {
-      BusArrival& arrival = stopCodeDataArray[stopCodeIndex].arrivals[arrivalIndex];
-      time_t expectedArrivalEpoch = iso8601ToEpoch(arrival.expectedArrivalTimeStr);
-      long minutesUntilArrival = (expectedArrivalEpoch - currentTime) / 60;
-
-      if (expectedArrivalEpoch <= currentTime) continue; // Skip past or invalid arrivals
-
-      // Find if this lineRef is already noted, else add it
-      int lineIndex = -1;
-      for (int i = 0; i < uniqueLines; i++) {
-        if (lineRefs[i] == arrival.lineRef && destinations[i] == arrival.destinationDisplay && stopPoints[i] == arrival.stopPointName) {
-          lineIndex = i;
-          break;
-        }
-      }
-
-      if (lineIndex == -1) { // New lineRef
-        lineIndex = uniqueLines++;
-        lineRefs[lineIndex] = arrival.lineRef;
-        destinations[lineIndex] = arrival.destinationDisplay;
-        stopPoints[lineIndex] = arrival.stopPointName;
-        minutesLists[lineIndex] = String(minutesUntilArrival);
-      } 
-      else { // Existing lineRef, append minutes
-        minutesLists[lineIndex] += ", " + String(minutesUntilArrival);
+#if !MT_EPD_BAND_MODE
+// /frame.png: the planes in the portrait view the frame is drawn in, as 2-bit
+// palette indices. Red wins over black, as on the glass.
+const uint8_t FRAME_PALETTE[3 * 3] = {
+  0xFF, 0xFF, 0xFF,   // white
+  0x00, 0x00, 0x00,   // black
+  0xFF, 0x00, 0x00    // red
+};
+const uint16_t FRAME_WIDTH = 480;   // logical, at setRotation(1)
+const uint16_t FRAME_HEIGHT = 800;
+
+// Under rotation 1 logical row y is physical column 799 - y and logical x is
+// the physical row, so every 8 rows come out of one byte column: read it
+// once and unpack the band. Core0, a band per few metricsServer.poll()s --
+// core1 may draw the next frame meanwhile, and a snapshot that spans a render
+// shows the top of one frame over the bottom of the other.
+void frameSnapshotRow(void* context, uint16_t y, uint8_t* row) {
+  static uint8_t bw[FRAME_WIDTH], red[FRAME_WIDTH];
+  static uint8_t band[8][FRAME_WIDTH / 4];
+
+  if (y % 8 == 0) {
+    display.readColumn(99 - y / 8, bw, red);
+    memset(band, 0, sizeof(band));
+    for (uint16_t x = 0; x < FRAME_WIDTH; x++) {
+      uint8_t shift = 6 - 2 * (x % 4);
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        // Bit b of the column byte is physical x 8 * column + 7 - b, row 8k + b
+        uint8_t mask = 1 << bit;
+        uint8_t index = (red[x] & mask) ? 2 : (bw[x] & mask) ? 0 : 1;
+        band[bit][x / 4] |= index << shift;
       }
     }
-
-    // Now print out the aggregated information
-    for (int i = 0; i < uniqueLines; i++) {
-      Serial.print(lineRefs[i] + " to ");
-      Serial.print(destinations[i] + " in ");
-      Serial.print(minutesLists[i] + " minutes at ");
-      Serial.println(stopPoints[i]);
-    }
   }
-  Serial.println(); // Extra line for readability
+  memcpy(row, band[y % 8], sizeof(band[0]));
 }
 
+bool beginFrameSnapshot(PngEncoder& png) {
+  return png.begin(FRAME_WIDTH, FRAME_HEIGHT, 2, FRAME_PALETTE, 3, frameSnapshotRow, NULL);
+}
+#endif
+#endif
 
-
-void collectActiveLines() {
-  // Mark all lines as inactive initially
-  for (int i = 0; i < lineInfoCount; i++) {
-    lineInfoArray[i].active = false;
-  }
-  
-  // Collect all current active lines from arrivals data
-  for (int stopCodeIndex = 0; stopCodeIndex < sizeof(stopCodes) / sizeof(stopCodes[0]); stopCodeIndex++) {
-    for (int arrivalIndex = 0; arrivalIndex < stopCodeDataArray[stopCodeIndex].arrivalCount; arrivalIndex++) {
-      BusArrival& arrival = stopCodeDataArray[stopCodeIndex].arrivals[arrivalIndex];
-      
-      // Check if arrival is in the future
-      time_t expectedArrivalEpoch = iso8601ToEpoch(arrival.expectedArrivalTimeStr);
-      if (expectedArrivalEpoch <= currentTime) continue;
-      
-      // Create a unique key for this line+destination+stop combination
-      String lineKey = arrival.lineRef + "|" + arrival.destinationDisplay + "|" + arrival.stopPointName;
-      
-      // Check if we already have this line in our array
-      bool lineFound = false;
-      for (int i = 0; i < lineInfoCount; i++) {
-        String existingKey = lineInfoArray[i].lineRef + "|" + lineInfoArray[i].destination + "|" + lineInfoArray[i].stopPoint;
-        if (existingKey == lineKey) {
-          // Found existing entry, mark as active
-          lineInfoArray[i].active = true;
-          lineFound = true;
-          break;
-        }
-      }
-      
-      // If not found and we have space, add it
-      if (!lineFound && lineInfoCount < 10) {
-        lineInfoArray[lineInfoCount].lineRef = arrival.lineRef;
-        lineInfoArray[lineInfoCount].destination = arrival.destinationDisplay;
-        lineInfoArray[lineInfoCount].stopPoint = arrival.stopPointName;
-        lineInfoArray[lineInfoCount].active = true;
-        lineInfoCount++;
-      }
-    }
+#if USE_WARM_BOOT
+// Draws the frame saved before the last reset into the planes, badged with
+// its age. Core0, during setup(); the caller refreshes the panel.
+bool restoreLastFrame() {
+  FrameSnapshot& frame = pendingFrame;  // unused until the first fetch
+  uint32_t asOf;
+  if (!frameStore.load(frame, asOf) || frame.rowCount == 0) return false;
+
+  // The last row's place goes to the badge
+  if (frame.rowCount > FRAME_MAX_ROWS - 1) frame.rowCount = FRAME_MAX_ROWS - 1;
+  frame.sequence = ++frameSequence;
+  for (int i = 0; i < frame.rowCount; i++) {
+    frame.rows[i].logo = getTransitLogo(frame.rows[i].lineRef, frame.sequence);
   }
+  renderFrame(frame);
+  drawAgeBadge(asOf);
+
+  Serial.print("Restored the last frame, as of ");
+  Serial.println(CurrentTimeToString(asOf));
+  return true;
 }
 
-void updateDisplay() {
-  // First collect all active lines
-  collectActiveLines();
-  
-  // Clear the display
-  display.clearDisplay();
-  
-  // Count how many active lines we have
-  int activeCount = 0;
-  for (int i = 0; i < lineInfoCount; i++) {
-    if (lineInfoArray[i].active) {
-      activeCount++;
-    }
-  }
-  
-  // Calculate how many lines we can display (max 6 due to screen height)
-  int displayCount = min(activeCount, 6);
-  
-  // Display active lines (they will naturally fill from top to bottom)
-  int displayedLines = 0;
-  
-  for (int i = 0; i < lineInfoCount && displayedLines < displayCount; i++) {
-    // Skip inactive lines
-    if (!lineInfoArray[i].active) continue;
-    
-    // Calculate vertical position (lines are stacked from top down)
-    int displayY = displayedLines * ROW_HEIGHT;
-    String lineRef = lineInfoArray[i].lineRef;
-    String destination = lineInfoArray[i].destination;
-    String stopPoint = lineInfoArray[i].stopPoint;
-    
-    // Collect arrival times for this specific line+destination+stop
-    String arrivalTimes = "";
-    
-    // Find all arrival times for this specific line+destination+stop
-    for (int stopCodeIndex = 0; stopCodeIndex < sizeof(stopCodes) / sizeof(stopCodes[0]); stopCodeIndex++) {
-      for (int arrivalIndex = 0; arrivalIndex < stopCodeDataArray[stopCodeIndex].arrivalCount; arrivalIndex++) {
-        BusArrival& arrival = stopCodeDataArray[stopCodeIndex].arrivals[arrivalIndex];
-        
-        // Check if this matches our line info
-        if (arrival.lineRef != lineRef || 
-            arrival.destinationDisplay != destination || 
-            arrival.stopPointName != stopPoint) {
-          continue;
-        }
-        
-        // Check if arrival is in the future
-        time_t expectedArrivalEpoch = iso8601ToEpoch(arrival.expectedArrivalTimeStr);
-        if (expectedArrivalEpoch <= currentTime) continue;
-        
-        // Calculate minutes until arrival
-        long minutesUntilArrival = (expectedArrivalEpoch - currentTime) / 60;
-        
-        // Add to arrival times list
-        if (arrivalTimes.length() > 0) {
-          arrivalTimes += ", ";
-        }
-        arrivalTimes += String(minutesUntilArrival);
-      }
-    }
-    
-    // Only display if we have arrival times
-    if (arrivalTimes.length() > 0) {
-      // Draw the line's logo
-      display.drawBitmap(0, displayY, getTransitLogo(lineRef), 130, 130, MT_EPD::EPD_BLACK);
-      
-      // Draw destination info with FreeSans12pt7b font
-      display.setFont(&FreeSans12pt7b);
-      display.setCursor(135, displayY + 25);
-      display.setTextColor(MT_EPD::EPD_BLACK);
-      display.println("To " + destination);
-      
-      // Draw stop info
-      display.setCursor(135, displayY + 60);
-      display.println("From " + stopPoint);
-      
-      // Draw arrival times in larger FreeSansBold24pt7b font
-      display.setFont(&FreeSansBold24pt7b);
-      display.setCursor(150, displayY + 115);
-      display.println(arrivalTimes);
-      
-      // Increment count of displayed lines
-      displayedLines++;
-    }
+// Keeps the newest frame in flash for restoreLastFrame(). Core0 only; saves
+// the first frame after boot, then one every LAST_FRAME_SAVE_MS.
+void saveLastFrame(const FrameSnapshot& frame) {
+  static bool saved = false;
+  static unsigned long lastSave = 0;
+  if (saved && millis() - lastSave < LAST_FRAME_SAVE_MS) return;
+
+  if (frameStore.save(frame, currentTime)) {  // currentTime: the server's clock at the last fetch
+    saved = true;
+    lastSave = millis();
   }
-  
-  // Update the e-paper display
-  display.display();
-  lastDisplayUpdate = millis();  // pet the display watchdog: a fresh frame was drawn
 }
 
-const uint8_t* getTransitLogo(String lineRef) {
+// Red rule and "As of <date> <time> UTC" along the bottom of the panel, below
+// the fifth row. We don't know the time yet at boot, only the frame's.
+void drawAgeBadge(uint32_t asOf) {
+  char text[32];
+  snprintf(text, sizeof(text), "As of %s %d, %02d:%02d UTC",
+           monthShortStr(month(asOf)), day(asOf), hour(asOf), minute(asOf));
+
+  int16_t y = (FRAME_MAX_ROWS - 1) * ROW_HEIGHT;
+  display.fillRect(0, y + 20, display.width(), 3, MT_EPD::EPD_RED);
+  display.setSpanFont(&FreeSans12pt7bSpans);
+  display.setTextColor(MT_EPD::EPD_RED);
+  display.setCursor(135, y + 60);
+  display.print(text);
+  display.setSpanFont(NULL);
+}
+#endif
 
-  /* These are the valid lines
-  L 30X FBUS 29 19 1X 23 24 25 27 714 90 28 14R 18 14 2 21
-  22 33 12 36 38R 5 30 44 45 58 35 37 38 31 48 39 49 43 55
-  54 1 57 56 5R 6 8 8BX KBUS F 9R 7 M 66 CA J K N 67 8AX
-  NBUS 15 91 LOWL 9 NOWL T TBUS 52 PH PM 28R
-  */
+#if !USE_ASSET_FS
+struct TransitLogo {
+  const char* lineRef;
+  const NativeBitmap* bitmap;  // panel-native, see Scripts/imagegen.py --native
+};
 
-  // Map line references to appropriate bitmap
-  if (lineRef == "L") return transit_logo_L;
-  else if (lineRef == "30X") return transit_logo_30;
-  else if (lineRef == "FBUS") return transit_logo_F;
-  else if (lineRef == "29") return transit_logo_29;
-  else if (lineRef == "19") return transit_logo_19;
-  else if (lineRef == "1X") return transit_logo_1X;
-  else if (lineRef == "23") return transit_logo_23;
-  else if (lineRef == "24") return transit_logo_24;
-  else if (lineRef == "25") return transit_logo_25;
-  else if (lineRef == "27") return transit_logo_27;
-  else if (lineRef == "714") return transit_logo_714;
-  else if (lineRef == "90") return transit_logo_90;
-  else if (lineRef == "28") return transit_logo_28;
-  else if (lineRef == "14R") return transit_logo_14R;
-  else if (lineRef == "18") return transit_logo_18;
-  else if (lineRef == "14") return transit_logo_14;
-  else if (lineRef == "2") return transit_logo_2;
-  else if (lineRef == "21") return transit_logo_21;
-  else if (lineRef == "22") return transit_logo_22;
-  else if (lineRef == "33") return transit_logo_33;
-  else if (lineRef == "12") return transit_logo_12;
-  else if (lineRef == "36") return transit_logo_36;
-  else if (lineRef == "38R") return transit_logo_38R;
-  else if (lineRef == "5") return transit_logo_5;
-  else if (lineRef == "30") return transit_logo_30;
-  else if (lineRef == "44") return transit_logo_44;
-  else if (lineRef == "45") return transit_logo_45;
-  else if (lineRef == "58") return transit_logo_58;
-  else if (lineRef == "35") return transit_logo_35;
-  else if (lineRef == "37") return transit_logo_37;
-  else if (lineRef == "38") return transit_logo_38;
-  else if (lineRef == "31") return transit_logo_31;
-  else if (lineRef == "48") return transit_logo_48;
-  else if (lineRef == "39") return transit_logo_39T;
-  else if (lineRef == "49") return transit_logo_49;
-  else if (lineRef == "43") return transit_logo_43;
-  else if (lineRef == "55") return transit_logo_55;
-  else if (lineRef == "54") return transit_logo_54;
-  else if (lineRef == "1") return transit_logo_1;
-  else if (lineRef == "57") return transit_logo_57;
-  else if (lineRef == "56") return transit_logo_56;
-  else if (lineRef == "5R") return transit_logo_5R;
-  else if (lineRef == "6") return transit_logo_6;
-  else if (lineRef == "8") return transit_logo_8;
-  else if (lineRef == "8BX") return transit_logo_8BX;
-  else if (lineRef == "KBUS") return transit_logo_KBUS;
-  else if (lineRef == "F") return transit_logo_F;
-  else if (lineRef == "9R") return transit_logo_9R;
-  else if (lineRef == "7") return transit_logo_7;
-  else if (lineRef == "M") return transit_logo_M;
-  else if (lineRef == "66") return transit_logo_66;
-  else if (lineRef == "CA") return transit_logo_CA;
-  else if (lineRef == "J") return transit_logo_J;
-  else if (lineRef == "K") return transit_logo_K;
-  else if (lineRef == "N") return transit_logo_N;
-  else if (lineRef == "67") return transit_logo_67;
-  else if (lineRef == "8AX") return transit_logo_8AX;
-  else if (lineRef == "NBUS") return transit_logo_NBUS;
-  else if (lineRef == "15") return transit_logo_15;
-  else if (lineRef == "91") return transit_logo_91;
-  else if (lineRef == "LOWL") return transit_logo_LOWL;
-  else if (lineRef == "9") return transit_logo_9;
-  else if (lineRef == "NOWL") return transit_logo_NOWL;
-  else if (lineRef == "T") return transit_logo_T;
-  else if (lineRef == "TBUS") return transit_logo_TBUS;
-  else if (lineRef == "52") return transit_logo_52;
-  else if (lineRef == "PH") return transit_logo_PH;
-  else if (lineRef == "PM") return transit_logo_PM;
-  else if (lineRef == "28R") return transit_logo_28R;
+/* These are the valid lines
+L 30X FBUS 29 19 1X 23 24 25 27 714 90 28 14R 18 14 2 21
+22 33 12 36 38R 5 30 44 45 58 35 37 38 31 48 39 49 43 55
+54 1 57 56 5R 6 8 8BX KBUS F 9R 7 M 66 CA J K N 67 8AX
+NBUS 15 91 LOWL 9 NOWL T TBUS 52 PH PM 28R
+*/
+// Map line references to appropriate bitmap
+const TransitLogo transitLogos[] = {
+  {"L", &transit_logo_L}, {"30X", &transit_logo_30}, {"FBUS", &transit_logo_F},
+  {"29", &transit_logo_29}, {"19", &transit_logo_19}, {"1X", &transit_logo_1X},
+  {"23", &transit_logo_23}, {"24", &transit_logo_24}, {"25", &transit_logo_25},
+  {"27", &transit_logo_27}, {"714", &transit_logo_714}, {"90", &transit_logo_90},
+  {"28", &transit_logo_28}, {"14R", &transit_logo_14R}, {"18", &transit_logo_18},
+  {"14", &transit_logo_14}, {"2", &transit_logo_2}, {"21", &transit_logo_21},
+  {"22", &transit_logo_22}, {"33", &transit_logo_33}, {"12", &transit_logo_12},
+  {"36", &transit_logo_36}, {"38R", &transit_logo_38R}, {"5", &transit_logo_5},
+  {"30", &transit_logo_30}, {"44", &transit_logo_44}, {"45", &transit_logo_45},
+  {"58", &transit_logo_58}, {"35", &transit_logo_35}, {"37", &transit_logo_37},
+  {"38", &transit_logo_38}, {"31", &transit_logo_31}, {"48", &transit_logo_48},
+  {"39", &transit_logo_39T}, {"49", &transit_logo_49}, {"43", &transit_logo_43},
+  {"55", &transit_logo_55}, {"54", &transit_logo_54}, {"1", &transit_logo_1},
+  {"57", &transit_logo_57}, {"56", &transit_logo_56}, {"5R", &transit_logo_5R},
+  {"6", &transit_logo_6}, {"8", &transit_logo_8}, {"8BX", &transit_logo_8BX},
+  {"KBUS", &transit_logo_KBUS}, {"F", &transit_logo_F}, {"9R", &transit_logo_9R},
+  {"7", &transit_logo_7}, {"M", &transit_logo_M}, {"66", &transit_logo_66},
+  {"CA", &transit_logo_CA}, {"J", &transit_logo_J}, {"K", &transit_logo_K},
+  {"N", &transit_logo_N}, {"67", &transit_logo_67}, {"8AX", &transit_logo_8AX},
+  {"NBUS", &transit_logo_NBUS}, {"15", &transit_logo_15}, {"91", &transit_logo_91},
+  {"LOWL", &transit_logo_LOWL}, {"9", &transit_logo_9}, {"NOWL", &transit_logo_NOWL},
+  {"T", &transit_logo_T}, {"TBUS", &transit_logo_TBUS}, {"52", &transit_logo_52},
+  {"PH", &transit_logo_PH}, {"PM", &transit_logo_PM}, {"28R", &transit_logo_28R},
+};
+
+#endif
+
+// Logo for a frame's row. Core0 only: the asset store may read the
+// filesystem. The bitmap stays valid until that frame has been drawn.
+const NativeBitmap* getTransitLogo(const char* lineRef, uint32_t sequence) {
+#if USE_ASSET_FS
+  const NativeBitmap* logo = logoStore.acquire(lineRef, sequence);
+  if (logo) return logo;
+#else
+  for (size_t i = 0; i < sizeof(transitLogos) / sizeof(transitLogos[0]); i++) {
+    if (strcmp(lineRef, transitLogos[i].lineRef) == 0) return transitLogos[i].bitmap;
+  }
+#endif
   
   // Default logo for unknown lines
-  return transit_logo_39T;  // Use a default logo/ the weird coit one
+  return &transit_logo_39T;  // Use a default logo/ the weird coit one
 }
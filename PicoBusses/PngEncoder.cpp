@@ -0,0 +1,155 @@
+#include "PngEncoder.h"
+#include <stdlib.h>
+#include <string.h>
+#include "miniz.h"
+
+static const uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+static const uint8_t COLOUR_TYPE_INDEXED = 3;
+static const uint8_t FILTER_NONE = 0;
+
+// zlib framing, as PNG wants, and a short match search: a framebuffer is
+// long runs of white, which any search finds
+static const int DEFLATE_FLAGS = TDEFL_WRITE_ZLIB_HEADER | 16;
+
+static void put32(uint8_t* out, uint32_t v) {
+    out[0] = v >> 24;
+    out[1] = v >> 16;
+    out[2] = v >> 8;
+    out[3] = v;
+}
+
+// Frames the len bytes already at out + 8 as a chunk of type
+static size_t chunk(uint8_t* out, const char* type, size_t len) {
+    put32(out, len);
+    memcpy(out + 4, type, 4);
+    put32(out + 8 + len, (uint32_t)mz_crc32(MZ_CRC32_INIT, out + 4, len + 4));
+    return len + 12;
+}
+
+PngEncoder::PngEncoder()
+    : _state(IDLE), _width(0), _height(0), _bitDepth(0), _palette(NULL), _colours(0),
+      _source(NULL), _context(NULL), _deflator(NULL), _row(NULL), _rowLen(0), _rowPos(0), _nextRow(0) {
+}
+
+PngEncoder::~PngEncoder() {
+    end();
+}
+
+bool PngEncoder::begin(uint16_t width, uint16_t height, uint8_t bitDepth,
+                       const uint8_t* palette, uint16_t colours,
+                       RowSource source, void* context) {
+    end();
+    if (width == 0 || height == 0 || source == NULL || palette == NULL) return false;
+    if (bitDepth != 1 && bitDepth != 2 && bitDepth != 4 && bitDepth != 8) return false;
+    if (colours == 0 || colours > (1u << bitDepth)) return false;
+
+    _rowLen = 1 + ((uint32_t)width * bitDepth + 7) / 8;
+    _deflator = malloc(sizeof(tdefl_compressor));
+    _row = (uint8_t*)malloc(_rowLen);
+    if (_deflator == NULL || _row == NULL) {
+        end();
+        return false;
+    }
+    if (tdefl_init((tdefl_compressor*)_deflator, NULL, NULL, DEFLATE_FLAGS) != TDEFL_STATUS_OKAY) {
+        end();
+        return false;
+    }
+
+    _width = width;
+    _height = height;
+    _bitDepth = bitDepth;
+    _palette = palette;
+    _colours = colours;
+    _source = source;
+    _context = context;
+    _rowPos = _rowLen;  // nothing pending: the first read fetches row 0
+    _nextRow = 0;
+    _state = HEADER;
+    return true;
+}
+
+void PngEncoder::end() {
+    free(_deflator);
+    free(_row);
+    _deflator = NULL;
+    _row = NULL;
+    _state = IDLE;
+}
+
+size_t PngEncoder::read(uint8_t* out, size_t max) {
+    if (max < READ_MIN) return 0;
+
+    switch (_state) {
+        case HEADER: {
+            size_t n = writeHeader(out);
+            _state = DATA;
+            return n;
+        }
+        case DATA:
+            return writeData(out, max);
+        case TRAILER: {
+            size_t n = chunk(out, "IEND", 0);
+            end();
+            return n;
+        }
+        default:
+            return 0;
+    }
+}
+
+// Signature, IHDR and PLTE; READ_MIN is sized to hold them
+size_t PngEncoder::writeHeader(uint8_t* out) {
+    memcpy(out, PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+    size_t n = sizeof(PNG_SIGNATURE);
+
+    uint8_t* ihdr = out + n + 8;
+    put32(ihdr, _width);
+    put32(ihdr + 4, _height);
+    ihdr[8] = _bitDepth;
+    ihdr[9] = COLOUR_TYPE_INDEXED;
+    ihdr[10] = 0;   // deflate
+    ihdr[11] = 0;   // adaptive filtering (every row says none)
+    ihdr[12] = 0;   // not interlaced
+    n += chunk(out + n, "IHDR", 13);
+
+    memcpy(out + n + 8, _palette, _colours * 3);
+    n += chunk(out + n, "PLTE", _colours * 3);
+    return n;
+}
+
+// One IDAT chunk of whatever up to ROWS_PER_READ more rows deflate to; moves
+// on to the trailer once the compressor has let go of everything
+size_t PngEncoder::writeData(uint8_t* out, size_t max) {
+    tdefl_compressor* deflator = (tdefl_compressor*)_deflator;
+    uint8_t* data = out + 8;
+    size_t room = max - 12;
+    size_t len = 0;
+    uint16_t rows = 0;
+    tdefl_status status = TDEFL_STATUS_OKAY;
+
+    while (len < room && status == TDEFL_STATUS_OKAY) {
+        if (_rowPos == _rowLen && _nextRow < _height) {
+            if (rows == ROWS_PER_READ) break;
+            _row[0] = FILTER_NONE;
+            _source(_context, _nextRow++, _row + 1);
+            _rowPos = 0;
+            rows++;
+        }
+
+        // Once every row is in, keep finishing until the stream is out
+        tdefl_flush flush = _nextRow == _height ? TDEFL_FINISH : TDEFL_NO_FLUSH;
+        size_t inSize = _rowLen - _rowPos;
+        size_t outSize = room - len;
+        status = tdefl_compress(deflator, _row + _rowPos, &inSize, data + len, &outSize, flush);
+        _rowPos += inSize;
+        len += outSize;
+    }
+
+    if (status == TDEFL_STATUS_DONE) {
+        _state = TRAILER;
+    } else if (status != TDEFL_STATUS_OKAY) {
+        end();  // can't happen with the arguments above; the image just stops
+        return 0;
+    }
+    return len > 0 ? chunk(out, "IDAT", len) : 0;
+}
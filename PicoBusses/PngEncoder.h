@@ -0,0 +1,80 @@
+#ifndef PNG_ENCODER_H
+#define PNG_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Streams an indexed (palette) PNG a slice at a time, deflating with miniz's
+// tdefl, so a whole image never has to sit in memory -- neither the pixels
+// nor the compressed file.
+//
+// The caller pulls: each read() asks the row source for at most
+// ROWS_PER_READ rows and hands back whatever PNG bytes that produced, as
+// whole chunks. Memory is the compressor (malloc'd by begin(), freed when the
+// image is done or by end()) plus one row. Nothing here is Arduino-specific,
+// so a host build (with miniz.c) can encode the same images for golden diffs.
+class PngEncoder {
+  public:
+    static const uint16_t ROWS_PER_READ = 16;
+    static const size_t   READ_MIN      = 1024;  // smallest buffer read() will fill (fits a 256-colour header)
+
+    // Fills row with image row y, packed at the bit depth, leftmost pixel in
+    // the high bits; y only ever goes up
+    typedef void (*RowSource)(void* context, uint16_t y, uint8_t* row);
+
+    PngEncoder();
+    ~PngEncoder();
+
+    /**
+    * Starts an image. Allocates the compressor; an image already under way
+    * is dropped.
+    * @param bitDepth 1, 2, 4 or 8 bits per palette index
+    * @param palette RGB triples, colours * 3 bytes; must outlive the image
+    * @param context Passed back to source
+    * @return false if the arguments don't make a PNG or there's no memory
+    */
+    bool begin(uint16_t width, uint16_t height, uint8_t bitDepth,
+               const uint8_t* palette, uint16_t colours,
+               RowSource source, void* context);
+
+    /**
+    * Encodes the next slice.
+    * @param out Destination, at least READ_MIN bytes
+    * @return Bytes written; 0 either means the compressor is holding
+    *         everything it got (call again) or, once done(), the end
+    */
+    size_t read(uint8_t* out, size_t max);
+
+    /**
+    * @return true once the last chunk has been read (or nothing was begun)
+    */
+    bool done() const { return _state == IDLE; }
+
+    /**
+    * Drops the image and frees the compressor.
+    */
+    void end();
+
+  private:
+    enum State : uint8_t { IDLE, HEADER, DATA, TRAILER };
+
+    State _state;
+    uint16_t _width;
+    uint16_t _height;
+    uint8_t _bitDepth;
+    const uint8_t* _palette;
+    uint16_t _colours;
+    RowSource _source;
+    void* _context;
+
+    void* _deflator;     // tdefl_compressor
+    uint8_t* _row;       // filter byte + packed row
+    size_t _rowLen;
+    size_t _rowPos;      // of _row handed to the compressor so far
+    uint16_t _nextRow;
+
+    size_t writeHeader(uint8_t* out);  // out holds READ_MIN bytes
+    size_t writeData(uint8_t* out, size_t max);
+};
+
+#endif
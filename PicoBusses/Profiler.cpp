@@ -0,0 +1,132 @@
+#include "Profiler.h"
+
+#if PROFILER
+#include <atomic>
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+
+static const uint8_t DUMP_HEADER_BYTES = 20;
+
+// One core's samples. That core's alarm interrupt is the only producer and
+// dump() on core0 the only consumer, with acquire/release indices like
+// SpscQueue.
+struct ProfileRing {
+    Profiler::Sample samples[PROFILER_SAMPLES];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    volatile uint32_t dropped;
+    volatile bool recording;
+    bool started;
+    uint8_t alarm;
+};
+static ProfileRing rings[2];
+
+static void put32(uint8_t* out, uint32_t v) {
+    out[0] = v;
+    out[1] = v >> 8;
+    out[2] = v >> 16;
+    out[3] = v >> 24;
+}
+
+// Takes one sample from the exception frame (r0-r3, r12, LR, PC, xPSR) and
+// re-arms this core's alarm
+extern "C" void profilerSample(const uint32_t* frame) {
+    uint8_t core = get_core_num() & 1;
+    ProfileRing& ring = rings[core];
+    timer_hw->intr = 1u << ring.alarm;
+    timer_hw->alarm[ring.alarm] = timer_hw->timerawl + Profiler::PERIOD_US;
+    if (!ring.recording) return;
+
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    uint32_t tail = ring.tail.load(std::memory_order_acquire);
+    if (head - tail >= PROFILER_SAMPLES) {
+        ring.dropped = ring.dropped + 1;  // one writer: this core's interrupt
+        return;
+    }
+    Profiler::Sample& sample = ring.samples[head % PROFILER_SAMPLES];
+    sample.pc = (frame[6] & ~1u) | core;
+    sample.lr = frame[5];
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+#if defined(__arm__)
+// The frame is on whichever stack the interrupted code was using (EXC_RETURN
+// bit 2). LR still holds EXC_RETURN when profilerSample() returns, so that
+// return is the exception return.
+extern "C" __attribute__((naked)) void profilerIrq() {
+    __asm volatile(
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "b profilerSample\n");
+}
+#endif
+
+bool Profiler::begin() {
+#if defined(__arm__)
+    ProfileRing& ring = rings[get_core_num() & 1];
+    if (ring.started) return true;
+    int alarm = hardware_alarm_claim_unused(false);
+    if (alarm < 0) return false;
+    ring.alarm = alarm;
+    ring.started = true;
+
+    // Highest priority, so the other handlers get sampled too
+    uint irq = hardware_alarm_get_irq_num(alarm);
+    irq_set_exclusive_handler(irq, profilerIrq);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    hw_set_bits(&timer_hw->inte, 1u << alarm);
+    irq_set_enabled(irq, true);  // on this core's NVIC only
+    timer_hw->alarm[alarm] = timer_hw->timerawl + PERIOD_US;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::resume() {
+    rings[get_core_num() & 1].recording = true;
+}
+
+void Profiler::pause() {
+    rings[get_core_num() & 1].recording = false;
+}
+
+size_t Profiler::dump(uint8_t* out, size_t max, bool start) {
+    static uint32_t left[2];  // of this dump, per core
+    size_t n = 0;
+
+    if (start) {
+        if (max < DUMP_HEADER_BYTES) return 0;
+        for (uint8_t core = 0; core < 2; core++) {
+            ProfileRing& ring = rings[core];
+            left[core] = ring.head.load(std::memory_order_acquire) - ring.tail.load(std::memory_order_relaxed);
+        }
+        memcpy(out, "NBPF", 4);
+        out[4] = (uint8_t)DUMP_VERSION;
+        out[5] = DUMP_VERSION >> 8;
+        out[6] = (uint8_t)PERIOD_US;
+        out[7] = PERIOD_US >> 8;
+        put32(out + 8, left[0] + left[1]);
+        put32(out + 12, rings[0].dropped);
+        put32(out + 16, rings[1].dropped);
+        n = DUMP_HEADER_BYTES;
+    }
+
+    for (uint8_t core = 0; core < 2; core++) {
+        ProfileRing& ring = rings[core];
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+        while (left[core] > 0 && n + sizeof(Sample) <= max) {
+            const Sample& sample = ring.samples[tail % PROFILER_SAMPLES];
+            put32(out + n, sample.pc);
+            put32(out + n + 4, sample.lr);
+            n += sizeof(Sample);
+            tail++;
+            left[core]--;
+        }
+        ring.tail.store(tail, std::memory_order_release);
+    }
+    return n;
+}
+#endif
@@ -0,0 +1,79 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+// Sampling PC profiler: which functions the time goes to, under real
+// payloads. PhaseTimer says which phase is slow; this says where inside it.
+//
+// Each core that calls begin() gets a hardware alarm of its own. The alarm's
+// interrupt fires every PERIOD_US and records the interrupted PC and LR from
+// the exception frame into that core's ring -- a handful of stores, no heap,
+// no lock, so core1 can be sampled too. Samples are only kept between
+// PROFILE_RESUME() and PROFILE_PAUSE(), which the sketch puts around the
+// work worth profiling (a fetch slice, inflate and parse on core0; render and
+// upload on core1), so an idle loop doesn't fill the rings. A full ring drops
+// samples, and counts them.
+//
+// dump() streams the samples out (MetricsServer serves them at /profile),
+// consuming them; Scripts/profsym.py symbolizes them against the sketch's
+// .elf into a flat profile and one level of callers. Code running with
+// interrupts off is sampled late, when they come back on.
+//
+// 1 builds the profiler in; 0 (the default) compiles PROFILE_RESUME() and
+// PROFILE_PAUSE() out. It costs PROFILER_SAMPLES * 8 bytes of RAM per core
+// and an interrupt per core every PERIOD_US. Arm Cortex-M only.
+#ifndef PROFILER
+#define PROFILER 0
+#endif
+
+#define PROFILER_SAMPLES 2048  // per core; raise it if the dump says samples were dropped
+
+class Profiler {
+  public:
+    static const uint32_t PERIOD_US = 997;  // ~1 kHz; prime so it doesn't beat with the 1 ms tick
+    static const uint16_t DUMP_VERSION = 1;
+
+    // One sample. PC's bit 0 is free (Thumb code is halfword aligned) and
+    // holds the core.
+    struct Sample {
+        uint32_t pc;
+        uint32_t lr;
+    };
+
+    /**
+    * Starts sampling this core, paused. From setup() on core0 and setup1()
+    * on core1.
+    * @return false if there's no alarm left, or this isn't an Arm core
+    */
+    static bool begin();
+
+    /**
+    * Keeps this core's samples from now on. Plain store; either core.
+    */
+    static void resume();
+
+    /**
+    * Stops keeping this core's samples. Plain store; either core.
+    */
+    static void pause();
+
+    /**
+    * Streams the samples recorded so far, and frees their room. A dump is
+    * "NBPF", u16 version, u16 period (us), u32 sample count, u32 dropped on
+    * core0 and core1 since boot, then the samples; little-endian. Core0.
+    * @param start true for the first slice of a dump
+    * @return Bytes written, at most max; 0 once the dump is complete
+    */
+    static size_t dump(uint8_t* out, size_t max, bool start);
+};
+
+#if PROFILER
+#define PROFILE_RESUME() Profiler::resume()
+#define PROFILE_PAUSE() Profiler::pause()
+#else
+#define PROFILE_RESUME() do {} while (0)
+#define PROFILE_PAUSE() do {} while (0)
+#endif
+
+#endif
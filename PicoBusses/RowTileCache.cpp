@@ -0,0 +1,77 @@
+#include "RowTileCache.h"
+
+RowTileCache::RowTileCache(MT_EPD& display, Painter paintLogo, Painter paintLabels)
+    : _display(display), _paintLogo(paintLogo), _paintLabels(paintLabels),
+      _clock(0), _hits(0), _misses(0) {
+    clear();
+}
+
+void RowTileCache::clear() {
+    for (uint8_t i = 0; i < ROW_TILE_SLOTS; i++) _slots[i].used = false;
+}
+
+void RowTileCache::draw(const FrameRow& row, int16_t y) {
+    _clock++;
+
+    Slot* slot = find(row);
+    if (slot) {
+        _hits++;
+    } else {
+        _misses++;
+        slot = victim();
+        if (!capture(*slot, row)) {
+            // Doesn't fit a tile (or no planes): draw it the long way
+            slot->used = false;
+            _paintLogo(row, y);
+            _paintLabels(row, y);
+            return;
+        }
+    }
+
+    slot->lastUsed = _clock;
+    _display.drawTile(slot->logo, y);
+    _display.drawTile(slot->labels, y);
+}
+
+RowTileCache::Slot* RowTileCache::find(const FrameRow& row) {
+    for (uint8_t i = 0; i < ROW_TILE_SLOTS; i++) {
+        Slot& slot = _slots[i];
+        if (slot.used && slot.logoBitmap == row.logo && strcmp(slot.lineRef, row.lineRef) == 0 &&
+            strcmp(slot.destination, row.destination) == 0 &&
+            strcmp(slot.stopPoint, row.stopPoint) == 0) {
+            return &slot;
+        }
+    }
+    return NULL;
+}
+
+RowTileCache::Slot* RowTileCache::victim() {
+    // An empty slot, else the least recently drawn one
+    Slot* oldest = &_slots[0];
+    for (uint8_t i = 0; i < ROW_TILE_SLOTS; i++) {
+        if (!_slots[i].used) return &_slots[i];
+        if (_clock - _slots[i].lastUsed > _clock - oldest->lastUsed) oldest = &_slots[i];
+    }
+    return oldest;
+}
+
+bool RowTileCache::capture(Slot& slot, const FrameRow& row) {
+    // The logo is a bitmap with a white background: every pixel counts.
+    // The labels are black text over whatever is already there.
+    if (!_display.beginTile(slot.logo, slot.logoData, sizeof(slot.logoData),
+                            0, 0, LOGO_SIZE, LOGO_SIZE, MT_EPD::TILE_COPY)) return false;
+    _paintLogo(row, 0);
+    if (!_display.endTile()) return false;
+
+    if (!_display.beginTile(slot.labels, slot.labelData, sizeof(slot.labelData),
+                            LABEL_X, 0, 480 - LABEL_X, LABEL_HEIGHT, MT_EPD::TILE_BLACK)) return false;
+    _paintLabels(row, 0);
+    if (!_display.endTile()) return false;
+
+    slot.logoBitmap = row.logo;
+    memcpy(slot.lineRef, row.lineRef, sizeof(slot.lineRef));
+    memcpy(slot.destination, row.destination, sizeof(slot.destination));
+    memcpy(slot.stopPoint, row.stopPoint, sizeof(slot.stopPoint));
+    slot.used = true;
+    return true;
+}
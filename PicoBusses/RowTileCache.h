@@ -0,0 +1,82 @@
+#ifndef ROW_TILE_CACHE_H
+#define ROW_TILE_CACHE_H
+
+#include <Arduino.h>
+#include "MT_EPD.h"
+#include "FrameQueue.h"
+
+#define ROW_TILE_SLOTS 6 // One panel of rows
+
+// Keeps the parts of an arrivals row that only change when the row itself
+// changes -- the line logo and the "To"/"From" labels -- as captured tiles,
+// keyed by (logo, line, destination, stop). A frame then pastes those tiles and
+// only draws the times fresh.
+//
+// Tiles are captured with the row at y = 0 and pasted wherever the row
+// lands, so a row that moves up or down the panel still hits. The painters
+// draw exactly what the sketch would draw without the cache; a row whose
+// drawing doesn't fit a tile (a label that wraps under the logo, say) is
+// painted straight into the planes every time. In band mode nothing can be
+// captured and every row goes to the painters.
+//
+// All storage is static (~36 KB for six slots): draw() runs on the render
+// core, which must stay off the heap.
+class RowTileCache {
+  public:
+    // Draws one part of a row with its top at y
+    typedef void (*Painter)(const FrameRow& row, int16_t y);
+
+    // Row layout the tiles are cut to, in logical pixels
+    static const int16_t LOGO_SIZE = 130;   // square logo at x = 0
+    static const int16_t LABEL_X = 130;     // labels run from here to the right edge
+    static const int16_t LABEL_HEIGHT = 72; // both label lines, descenders included
+
+    RowTileCache(MT_EPD& display, Painter paintLogo, Painter paintLabels);
+
+    /**
+    * Draws a row's logo and labels, from the cache when it has them.
+    * @param row Row to draw
+    * @param y Logical y of the top of the row
+    */
+    void draw(const FrameRow& row, int16_t y);
+
+    /**
+    * Forgets every cached row.
+    */
+    void clear();
+
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+
+  private:
+    // Worst-case plane bytes: a rect can straddle one more byte than it spans
+    static const uint16_t LOGO_BYTES = LOGO_SIZE * ((LOGO_SIZE + 14) / 8);
+    static const uint16_t LABEL_BYTES = (480 - LABEL_X) * ((LABEL_HEIGHT + 14) / 8);
+
+    struct Slot {
+        bool used;
+        uint32_t lastUsed;
+        const NativeBitmap* logoBitmap;
+        char lineRef[sizeof(FrameRow::lineRef)];
+        char destination[sizeof(FrameRow::destination)];
+        char stopPoint[sizeof(FrameRow::stopPoint)];
+        PlaneTile logo;
+        PlaneTile labels;
+        uint8_t logoData[LOGO_BYTES];
+        uint8_t labelData[LABEL_BYTES];
+    };
+
+    MT_EPD& _display;
+    Painter _paintLogo;
+    Painter _paintLabels;
+    Slot _slots[ROW_TILE_SLOTS];
+    uint32_t _clock;
+    uint32_t _hits;
+    uint32_t _misses;
+
+    Slot* find(const FrameRow& row);
+    Slot* victim();
+    bool capture(Slot& slot, const FrameRow& row);
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "StopMonitorParser.h"
+#include <ArduinoJson.h>
+
+StopMonitorParser::StopMonitorParser() : _serverTime(0), _error("") {
+}
+
+StopMonitorParser::Result StopMonitorParser::parse(const char* json, size_t length, StopCodeData& stop) {
+    stop.arrivalCount = 0;
+    _serverTime = 0;
+    _error = "";
+
+    // The feed starts with a UTF-8 byte order mark (EF BB BF), which the
+    // JSON parser won't take
+    if (length >= 3 && memcmp(json, "\xEF\xBB\xBF", 3) == 0) {
+        json += 3;
+        length -= 3;
+    }
+
+    DynamicJsonDocument doc(DOCUMENT_BYTES);
+    if (doc.capacity() == 0) return NO_MEMORY;
+
+    DeserializationError error = deserializeJson(doc, json, length);
+    if (error) {
+        _error = error.c_str();
+        return BAD_JSON;
+    }
+
+    JsonObject delivery = doc["ServiceDelivery"];
+    _serverTime = parseTime(delivery["ResponseTimestamp"] | "");
+
+    JsonArray visits = delivery["StopMonitoringDelivery"]["MonitoredStopVisit"];
+    int count = 0;
+    for (JsonObject visit : visits) {
+        if (count >= MAX_ARRIVALS) break;  // Prevent overflow of arrivals array
+        JsonObject journey = visit["MonitoredVehicleJourney"];
+        JsonObject call = journey["MonitoredCall"];
+
+        BusArrival& arrival = stop.arrivals[count++];
+        copyText(arrival.lineRef, sizeof(arrival.lineRef), journey["LineRef"] | "");
+        copyText(arrival.destinationDisplay, sizeof(arrival.destinationDisplay), call["DestinationDisplay"] | "");
+        copyText(arrival.stopPointName, sizeof(arrival.stopPointName), call["StopPointName"] | "");
+        arrival.expectedArrivalEpoch = parseTime(call["ExpectedArrivalTime"] | "");
+    }
+    stop.arrivalCount = count;
+    return PARSED;
+}
+
+// Digits of a fixed-width field, or -1 if one isn't a digit
+static int digits(const char* s, uint8_t n) {
+    int v = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        if (s[i] < '0' || s[i] > '9') return -1;
+        v = v * 10 + (s[i] - '0');
+    }
+    return v;
+}
+
+uint32_t StopMonitorParser::parseTime(const char* iso8601) {
+    // YYYY-MM-DDTHH:MM:SS, UTC; the zone suffix is always Z
+    if (strnlen(iso8601, 19) < 19) return 0;
+    int year = digits(iso8601, 4), month = digits(iso8601 + 5, 2), day = digits(iso8601 + 8, 2);
+    int hour = digits(iso8601 + 11, 2), minute = digits(iso8601 + 14, 2), second = digits(iso8601 + 17, 2);
+    if (year < 1970 || month < 1 || month > 12 || day < 1 || hour < 0 || minute < 0 || second < 0) return 0;
+
+    // Days since 1970-01-01 of the proleptic Gregorian date, counting years
+    // from March so the leap day comes last
+    int y = year - (month <= 2);
+    int era = y / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int32_t days = era * 146097 + dayOfEra - 719468;
+    return (uint32_t)days * 86400u + hour * 3600u + minute * 60u + second;
+}
@@ -0,0 +1,52 @@
+#ifndef STOP_MONITOR_PARSER_H
+#define STOP_MONITOR_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Arrivals.h"
+
+// Pulls one stop's arrivals and the server's clock out of a 511
+// StopMonitoring (SIRI) response, with ArduinoJson.
+//
+// Only the fields the display uses are kept: per MonitoredStopVisit its
+// LineRef, DestinationDisplay, StopPointName and ExpectedArrivalTime, the
+// time parsed to an epoch here once rather than on every redraw. The first
+// MAX_ARRIVALS visits are kept. The JSON document is allocated per parse and
+// freed before it returns. No Arduino calls: the host build parses with the
+// same code.
+class StopMonitorParser {
+  public:
+    enum Result : uint8_t { PARSED, NO_MEMORY, BAD_JSON };
+
+    static const size_t DOCUMENT_BYTES = 40000;  // ArduinoJson pool, per parse
+
+    StopMonitorParser();
+
+    /**
+    * Replaces stop's arrivals with the response's. stop ends up empty if the
+    * response doesn't parse. stop.fetchedAt is left to the caller.
+    * @param json The response, a leading UTF-8 byte order mark and all
+    * @param length Its length
+    * @param stop Where the arrivals go
+    * @return PARSED, or why not
+    */
+    Result parse(const char* json, size_t length, StopCodeData& stop);
+
+    // ResponseTimestamp of the last parse (UTC epoch), 0 if it had none
+    uint32_t serverTime() const { return _serverTime; }
+
+    // What the JSON parser said, after BAD_JSON
+    const char* error() const { return _error; }
+
+    /**
+    * @param iso8601 A time as the feed writes them, e.g. 2025-05-07T16:07:30Z
+    * @return UTC epoch, 0 if it isn't one
+    */
+    static uint32_t parseTime(const char* iso8601);
+
+  private:
+    uint32_t _serverTime;
+    const char* _error;
+};
+
+#endif
@@ -0,0 +1,221 @@
+// Generated by Scripts/assetpack.py from all_images.h, muni_bitmap.h -- do not edit
+// 69 bitmaps, 165760 bytes, linked in from assets.S
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "MT_EPD.h"
+
+extern "C" {
+extern const unsigned char transit_logo_1_bits[2210];
+extern const unsigned char transit_logo_12_bits[2210];
+extern const unsigned char transit_logo_14_bits[2210];
+extern const unsigned char transit_logo_14R_bits[2210];
+extern const unsigned char transit_logo_15_bits[2210];
+extern const unsigned char transit_logo_18_bits[2210];
+extern const unsigned char transit_logo_19_bits[2210];
+extern const unsigned char transit_logo_1X_bits[2210];
+extern const unsigned char transit_logo_2_bits[2210];
+extern const unsigned char transit_logo_21_bits[2210];
+extern const unsigned char transit_logo_22_bits[2210];
+extern const unsigned char transit_logo_23_bits[2210];
+extern const unsigned char transit_logo_24_bits[2210];
+extern const unsigned char transit_logo_25_bits[2210];
+extern const unsigned char transit_logo_27_bits[2210];
+extern const unsigned char transit_logo_28_bits[2210];
+extern const unsigned char transit_logo_28R_bits[2210];
+extern const unsigned char transit_logo_29_bits[2210];
+extern const unsigned char transit_logo_30_bits[2210];
+extern const unsigned char transit_logo_31_bits[2210];
+extern const unsigned char transit_logo_33_bits[2210];
+extern const unsigned char transit_logo_35_bits[2210];
+extern const unsigned char transit_logo_36_bits[2210];
+extern const unsigned char transit_logo_37_bits[2210];
+extern const unsigned char transit_logo_38_bits[2210];
+extern const unsigned char transit_logo_38R_bits[2210];
+extern const unsigned char transit_logo_39_bits[2210];
+extern const unsigned char transit_logo_39T_bits[2210];
+extern const unsigned char transit_logo_43_bits[2210];
+extern const unsigned char transit_logo_44_bits[2210];
+extern const unsigned char transit_logo_45_bits[2210];
+extern const unsigned char transit_logo_48_bits[2210];
+extern const unsigned char transit_logo_49_bits[2210];
+extern const unsigned char transit_logo_5_bits[2210];
+extern const unsigned char transit_logo_52_bits[2210];
+extern const unsigned char transit_logo_54_bits[2210];
+extern const unsigned char transit_logo_55_bits[2210];
+extern const unsigned char transit_logo_56_bits[2210];
+extern const unsigned char transit_logo_57_bits[2210];
+extern const unsigned char transit_logo_58_bits[2210];
+extern const unsigned char transit_logo_5R_bits[2210];
+extern const unsigned char transit_logo_6_bits[2210];
+extern const unsigned char transit_logo_66_bits[2210];
+extern const unsigned char transit_logo_67_bits[2210];
+extern const unsigned char transit_logo_7_bits[2210];
+extern const unsigned char transit_logo_714_bits[2210];
+extern const unsigned char transit_logo_8_bits[2210];
+extern const unsigned char transit_logo_8AX_bits[2210];
+extern const unsigned char transit_logo_8BX_bits[2210];
+extern const unsigned char transit_logo_9_bits[2210];
+extern const unsigned char transit_logo_90_bits[2210];
+extern const unsigned char transit_logo_91_bits[2210];
+extern const unsigned char transit_logo_9R_bits[2210];
+extern const unsigned char transit_logo_CA_bits[2210];
+extern const unsigned char transit_logo_F_bits[2210];
+extern const unsigned char transit_logo_J_bits[2210];
+extern const unsigned char transit_logo_K_bits[2210];
+extern const unsigned char transit_logo_KBUS_bits[2210];
+extern const unsigned char transit_logo_L_bits[2210];
+extern const unsigned char transit_logo_LOWL_bits[2210];
+extern const unsigned char transit_logo_M_bits[2210];
+extern const unsigned char transit_logo_N_bits[2210];
+extern const unsigned char transit_logo_NBUS_bits[2210];
+extern const unsigned char transit_logo_NOWL_bits[2210];
+extern const unsigned char transit_logo_PH_bits[2210];
+extern const unsigned char transit_logo_PM_bits[2210];
+extern const unsigned char transit_logo_T_bits[2210];
+extern const unsigned char transit_logo_TBUS_bits[2210];
+extern const unsigned char epd_bitmap_Muni_worm_logo[15480];
+}
+
+const NativeBitmap transit_logo_1 = {transit_logo_1_bits, 130, 130, 1};
+const NativeBitmap transit_logo_12 = {transit_logo_12_bits, 130, 130, 1};
+const NativeBitmap transit_logo_14 = {transit_logo_14_bits, 130, 130, 1};
+const NativeBitmap transit_logo_14R = {transit_logo_14R_bits, 130, 130, 1};
+const NativeBitmap transit_logo_15 = {transit_logo_15_bits, 130, 130, 1};
+const NativeBitmap transit_logo_18 = {transit_logo_18_bits, 130, 130, 1};
+const NativeBitmap transit_logo_19 = {transit_logo_19_bits, 130, 130, 1};
+const NativeBitmap transit_logo_1X = {transit_logo_1X_bits, 130, 130, 1};
+const NativeBitmap transit_logo_2 = {transit_logo_2_bits, 130, 130, 1};
+const NativeBitmap transit_logo_21 = {transit_logo_21_bits, 130, 130, 1};
+const NativeBitmap transit_logo_22 = {transit_logo_22_bits, 130, 130, 1};
+const NativeBitmap transit_logo_23 = {transit_logo_23_bits, 130, 130, 1};
+const NativeBitmap transit_logo_24 = {transit_logo_24_bits, 130, 130, 1};
+const NativeBitmap transit_logo_25 = {transit_logo_25_bits, 130, 130, 1};
+const NativeBitmap transit_logo_27 = {transit_logo_27_bits, 130, 130, 1};
+const NativeBitmap transit_logo_28 = {transit_logo_28_bits, 130, 130, 1};
+const NativeBitmap transit_logo_28R = {transit_logo_28R_bits, 130, 130, 1};
+const NativeBitmap transit_logo_29 = {transit_logo_29_bits, 130, 130, 1};
+const NativeBitmap transit_logo_30 = {transit_logo_30_bits, 130, 130, 1};
+const NativeBitmap transit_logo_31 = {transit_logo_31_bits, 130, 130, 1};
+const NativeBitmap transit_logo_33 = {transit_logo_33_bits, 130, 130, 1};
+const NativeBitmap transit_logo_35 = {transit_logo_35_bits, 130, 130, 1};
+const NativeBitmap transit_logo_36 = {transit_logo_36_bits, 130, 130, 1};
+const NativeBitmap transit_logo_37 = {transit_logo_37_bits, 130, 130, 1};
+const NativeBitmap transit_logo_38 = {transit_logo_38_bits, 130, 130, 1};
+const NativeBitmap transit_logo_38R = {transit_logo_38R_bits, 130, 130, 1};
+const NativeBitmap transit_logo_39 = {transit_logo_39_bits, 130, 130, 1};
+const NativeBitmap transit_logo_39T = {transit_logo_39T_bits, 130, 130, 1};
+const NativeBitmap transit_logo_43 = {transit_logo_43_bits, 130, 130, 1};
+const NativeBitmap transit_logo_44 = {transit_logo_44_bits, 130, 130, 1};
+const NativeBitmap transit_logo_45 = {transit_logo_45_bits, 130, 130, 1};
+const NativeBitmap transit_logo_48 = {transit_logo_48_bits, 130, 130, 1};
+const NativeBitmap transit_logo_49 = {transit_logo_49_bits, 130, 130, 1};
+const NativeBitmap transit_logo_5 = {transit_logo_5_bits, 130, 130, 1};
+const NativeBitmap transit_logo_52 = {transit_logo_52_bits, 130, 130, 1};
+const NativeBitmap transit_logo_54 = {transit_logo_54_bits, 130, 130, 1};
+const NativeBitmap transit_logo_55 = {transit_logo_55_bits, 130, 130, 1};
+const NativeBitmap transit_logo_56 = {transit_logo_56_bits, 130, 130, 1};
+const NativeBitmap transit_logo_57 = {transit_logo_57_bits, 130, 130, 1};
+const NativeBitmap transit_logo_58 = {transit_logo_58_bits, 130, 130, 1};
+const NativeBitmap transit_logo_5R = {transit_logo_5R_bits, 130, 130, 1};
+const NativeBitmap transit_logo_6 = {transit_logo_6_bits, 130, 130, 1};
+const NativeBitmap transit_logo_66 = {transit_logo_66_bits, 130, 130, 1};
+const NativeBitmap transit_logo_67 = {transit_logo_67_bits, 130, 130, 1};
+const NativeBitmap transit_logo_7 = {transit_logo_7_bits, 130, 130, 1};
+const NativeBitmap transit_logo_714 = {transit_logo_714_bits, 130, 130, 1};
+const NativeBitmap transit_logo_8 = {transit_logo_8_bits, 130, 130, 1};
+const NativeBitmap transit_logo_8AX = {transit_logo_8AX_bits, 130, 130, 1};
+const NativeBitmap transit_logo_8BX = {transit_logo_8BX_bits, 130, 130, 1};
+const NativeBitmap transit_logo_9 = {transit_logo_9_bits, 130, 130, 1};
+const NativeBitmap transit_logo_90 = {transit_logo_90_bits, 130, 130, 1};
+const NativeBitmap transit_logo_91 = {transit_logo_91_bits, 130, 130, 1};
+const NativeBitmap transit_logo_9R = {transit_logo_9R_bits, 130, 130, 1};
+const NativeBitmap transit_logo_CA = {transit_logo_CA_bits, 130, 130, 1};
+const NativeBitmap transit_logo_F = {transit_logo_F_bits, 130, 130, 1};
+const NativeBitmap transit_logo_J = {transit_logo_J_bits, 130, 130, 1};
+const NativeBitmap transit_logo_K = {transit_logo_K_bits, 130, 130, 1};
+const NativeBitmap transit_logo_KBUS = {transit_logo_KBUS_bits, 130, 130, 1};
+const NativeBitmap transit_logo_L = {transit_logo_L_bits, 130, 130, 1};
+const NativeBitmap transit_logo_LOWL = {transit_logo_LOWL_bits, 130, 130, 1};
+const NativeBitmap transit_logo_M = {transit_logo_M_bits, 130, 130, 1};
+const NativeBitmap transit_logo_N = {transit_logo_N_bits, 130, 130, 1};
+const NativeBitmap transit_logo_NBUS = {transit_logo_NBUS_bits, 130, 130, 1};
+const NativeBitmap transit_logo_NOWL = {transit_logo_NOWL_bits, 130, 130, 1};
+const NativeBitmap transit_logo_PH = {transit_logo_PH_bits, 130, 130, 1};
+const NativeBitmap transit_logo_PM = {transit_logo_PM_bits, 130, 130, 1};
+const NativeBitmap transit_logo_T = {transit_logo_T_bits, 130, 130, 1};
+const NativeBitmap transit_logo_TBUS = {transit_logo_TBUS_bits, 130, 130, 1};
+
+const int transit_logo_allArray_LEN = 68;
+const NativeBitmap* const transit_logo_allArray[68] = {
+	&transit_logo_1,
+	&transit_logo_12,
+	&transit_logo_14,
+	&transit_logo_14R,
+	&transit_logo_15,
+	&transit_logo_18,
+	&transit_logo_19,
+	&transit_logo_1X,
+	&transit_logo_2,
+	&transit_logo_21,
+	&transit_logo_22,
+	&transit_logo_23,
+	&transit_logo_24,
+	&transit_logo_25,
+	&transit_logo_27,
+	&transit_logo_28,
+	&transit_logo_28R,
+	&transit_logo_29,
+	&transit_logo_30,
+	&transit_logo_31,
+	&transit_logo_33,
+	&transit_logo_35,
+	&transit_logo_36,
+	&transit_logo_37,
+	&transit_logo_38,
+	&transit_logo_38R,
+	&transit_logo_39,
+	&transit_logo_39T,
+	&transit_logo_43,
+	&transit_logo_44,
+	&transit_logo_45,
+	&transit_logo_48,
+	&transit_logo_49,
+	&transit_logo_5,
+	&transit_logo_52,
+	&transit_logo_54,
+	&transit_logo_55,
+	&transit_logo_56,
+	&transit_logo_57,
+	&transit_logo_58,
+	&transit_logo_5R,
+	&transit_logo_6,
+	&transit_logo_66,
+	&transit_logo_67,
+	&transit_logo_7,
+	&transit_logo_714,
+	&transit_logo_8,
+	&transit_logo_8AX,
+	&transit_logo_8BX,
+	&transit_logo_9,
+	&transit_logo_90,
+	&transit_logo_91,
+	&transit_logo_9R,
+	&transit_logo_CA,
+	&transit_logo_F,
+	&transit_logo_J,
+	&transit_logo_K,
+	&transit_logo_KBUS,
+	&transit_logo_L,
+	&transit_logo_LOWL,
+	&transit_logo_M,
+	&transit_logo_N,
+	&transit_logo_NBUS,
+	&transit_logo_NOWL,
+	&transit_logo_PH,
+	&transit_logo_PM,
+	&transit_logo_T,
+	&transit_logo_TBUS,
+};
+
+#endif
@@ -4,4 +4,10 @@ const char* password = "YOUR_WIFI_PASSWORD";
 
 // API key for 511.org
 // Sign up at https://511.org/open-data/token
-String APIkey = "YOUR_API_KEY";
\ No newline at end of file
+String APIkey = "YOUR_API_KEY";
+
+// Fetch from Scripts/mock511.py on your own machine instead of api.511.org,
+// trusting its test CA: run "python mock511.py --make-ca=<this address>"
+// first, which writes trust_anchors_mock.h
+//#define MOCK_API_HOST "192.168.1.20"
+//#define MOCK_API_PORT 8443
@@ -0,0 +1,101 @@
+// Generated by Scripts/fontatlas.py from FreeSansBold24pt7b.h -- do not edit
+// '0123456789, ' pre-rotated for rotation 1, 1129 bytes
+#ifndef DIGITATLAS_H
+#define DIGITATLAS_H
+
+#include "MT_EPD.h"
+#include "Fonts/FreeSansBold24pt7bDigits.h"
+
+const uint8_t DigitAtlasBitmaps[] PROGMEM = {
+	0x00, 0x1F, 0xFF, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xF0, 0x00, 0x07, 0xFF, 0xFF, 0xFC, 0x00, 0x1F,
+	0xFF, 0xFF, 0xFF, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0x80, 0x3F, 0xFF, 0xFF, 0xFF, 0x80, 0x7F, 0xFF,
+	0xFF, 0xFF, 0xC0, 0x7F, 0xE0, 0x00, 0xFF, 0xC0, 0xFF, 0x00, 0x00, 0x1F, 0xE0, 0xFE, 0x00, 0x00,
+	0x0F, 0xE0, 0xFC, 0x00, 0x00, 0x07, 0xE0, 0xFC, 0x00, 0x00, 0x07, 0xE0, 0xFC, 0x00, 0x00, 0x07,
+	0xE0, 0xFC, 0x00, 0x00, 0x07, 0xE0, 0xFE, 0x00, 0x00, 0x0F, 0xE0, 0xFF, 0x00, 0x00, 0x1F, 0xE0,
+	0x7F, 0xE0, 0x00, 0xFF, 0xC0, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x3F, 0xFF, 0xFF, 0xFF, 0x80, 0x3F,
+	0xFF, 0xFF, 0xFF, 0x80, 0x1F, 0xFF, 0xFF, 0xFF, 0x00, 0x07, 0xFF, 0xFF, 0xFC, 0x00, 0x01, 0xFF,
+	0xFF, 0xF0, 0x00, 0x00, 0x1F, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x01,
+	0xE0, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x01, 0xF0,
+	0x00, 0x00, 0x00, 0x01, 0xF0, 0x00, 0x00, 0x00, 0x01, 0xF0, 0x00, 0xFF, 0xFF, 0xFF, 0xF8, 0x00,
+	0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00,
+	0x03, 0xE0, 0x00, 0xF0, 0x00, 0x03, 0xF8, 0x00, 0xFE, 0x00, 0x03, 0xFC, 0x00, 0xFF, 0x80, 0x03,
+	0xFE, 0x00, 0xFF, 0xC0, 0x03, 0xFF, 0x00, 0xFF, 0xE0, 0x03, 0xFF, 0x80, 0xFF, 0xF0, 0x03, 0xFF,
+	0x80, 0xFF, 0xF8, 0x00, 0x3F, 0xC0, 0xFF, 0xF8, 0x00, 0x1F, 0xC0, 0xFD, 0xFC, 0x00, 0x0F, 0xC0,
+	0xFC, 0xFE, 0x00, 0x0F, 0xC0, 0xFC, 0x7F, 0x00, 0x0F, 0xC0, 0xFC, 0x3F, 0x00, 0x0F, 0xC0, 0xFC,
+	0x1F, 0x80, 0x0F, 0xC0, 0xFC, 0x0F, 0xC0, 0x1F, 0xC0, 0xFC, 0x0F, 0xF0, 0x7F, 0x80, 0xFC, 0x07,
+	0xFF, 0xFF, 0x80, 0xFC, 0x03, 0xFF, 0xFF, 0x80, 0xFC, 0x03, 0xFF, 0xFF, 0x00, 0xFC, 0x01, 0xFF,
+	0xFE, 0x00, 0xFC, 0x00, 0xFF, 0xFC, 0x00, 0xFC, 0x00, 0x7F, 0xF8, 0x00, 0xFC, 0x00, 0x1F, 0xE0,
+	0x00, 0x01, 0xC0, 0x00, 0xF0, 0x00, 0x0F, 0xC0, 0x00, 0xFE, 0x00, 0x1F, 0xC0, 0x00, 0xFF, 0x00,
+	0x3F, 0xC0, 0x00, 0xFF, 0x80, 0x3F, 0xC0, 0x00, 0xFF, 0x80, 0x7F, 0xC0, 0x00, 0xFF, 0xC0, 0x7F,
+	0xC0, 0x00, 0xFF, 0xC0, 0xFF, 0x00, 0x00, 0x1F, 0xE0, 0xFE, 0x00, 0x00, 0x0F, 0xE0, 0xFC, 0x00,
+	0x00, 0x07, 0xE0, 0xFC, 0x00, 0xF0, 0x07, 0xE0, 0xFC, 0x00, 0xF0, 0x07, 0xE0, 0xFC, 0x00, 0xF0,
+	0x07, 0xE0, 0xFC, 0x01, 0xF8, 0x0F, 0xE0, 0xFE, 0x01, 0xFC, 0x1F, 0xE0, 0x7F, 0x87, 0xFF, 0xFF,
+	0xC0, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x3F, 0xFF, 0xDF, 0xFF, 0x80,
+	0x1F, 0xFF, 0x8F, 0xFF, 0x00, 0x0F, 0xFF, 0x87, 0xFE, 0x00, 0x07, 0xFF, 0x01, 0xF8, 0x00, 0x01,
+	0xFC, 0x00, 0x00, 0x00, 0x01, 0xFC, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x01, 0xFF,
+	0x80, 0x00, 0x00, 0x01, 0xFF, 0xE0, 0x00, 0x00, 0x01, 0xF9, 0xF8, 0x00, 0x00, 0x01, 0xF8, 0xFE,
+	0x00, 0x00, 0x01, 0xF8, 0x3F, 0x00, 0x00, 0x01, 0xF8, 0x0F, 0xC0, 0x00, 0x01, 0xF8, 0x07, 0xF0,
+	0x00, 0x01, 0xF8, 0x01, 0xF8, 0x00, 0x01, 0xF8, 0x00, 0xFE, 0x00, 0x01, 0xF8, 0x00, 0x3F, 0x80,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x80, 0x01, 0xF8, 0x00, 0x00, 0x00, 0x01, 0xF8, 0x00, 0x00, 0x00, 0x01, 0xF8, 0x00,
+	0x00, 0x00, 0x07, 0x80, 0x60, 0x00, 0x00, 0x0F, 0x80, 0x7F, 0x00, 0x00, 0x1F, 0x80, 0x7F, 0xFC,
+	0x00, 0x3F, 0x80, 0x7F, 0xFF, 0xC0, 0x7F, 0x80, 0x7F, 0xFF, 0xC0, 0x7F, 0x80, 0x7F, 0xFF, 0xC0,
+	0x7F, 0x00, 0x7C, 0x7F, 0xC0, 0xFE, 0x00, 0x3E, 0x0F, 0xC0, 0xFC, 0x00, 0x3E, 0x0F, 0xC0, 0xFC,
+	0x00, 0x3F, 0x0F, 0xC0, 0xFC, 0x00, 0x3F, 0x0F, 0xC0, 0xFC, 0x00, 0x3F, 0x0F, 0xC0, 0xFC, 0x00,
+	0x3F, 0x0F, 0xC0, 0xFE, 0x00, 0x7F, 0x0F, 0xC0, 0x7F, 0x00, 0xFF, 0x0F, 0xC0, 0x7F, 0x81, 0xFE,
+	0x0F, 0xC0, 0x7F, 0xFF, 0xFE, 0x0F, 0xC0, 0x3F, 0xFF, 0xFE, 0x0F, 0xC0, 0x1F, 0xFF, 0xFC, 0x0F,
+	0xC0, 0x1F, 0xFF, 0xF8, 0x0F, 0xC0, 0x0F, 0xFF, 0xF0, 0x0F, 0xC0, 0x03, 0xFF, 0xC0, 0x0F, 0xC0,
+	0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xF0, 0x00, 0x07,
+	0xFF, 0xFF, 0xFC, 0x00, 0x1F, 0xFF, 0xFF, 0xFE, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0x00, 0x3F, 0xFF,
+	0xFF, 0xFF, 0x80, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x7F, 0x81, 0xF8, 0xFF, 0xC0, 0xFE, 0x00, 0x7C,
+	0x1F, 0xE0, 0xFE, 0x00, 0x7C, 0x0F, 0xE0, 0xFC, 0x00, 0x3E, 0x07, 0xE0, 0xFC, 0x00, 0x3E, 0x07,
+	0xE0, 0xFC, 0x00, 0x3E, 0x07, 0xE0, 0xFE, 0x00, 0x3E, 0x07, 0xE0, 0xFE, 0x00, 0x7E, 0x0F, 0xE0,
+	0x7F, 0x81, 0xFE, 0x1F, 0xE0, 0x7F, 0xFF, 0xFC, 0x1F, 0xC0, 0x7F, 0xFF, 0xFC, 0x1F, 0xC0, 0x3F,
+	0xFF, 0xF8, 0x1F, 0x80, 0x1F, 0xFF, 0xF8, 0x1F, 0x80, 0x0F, 0xFF, 0xF0, 0x1E, 0x00, 0x03, 0xFF,
+	0xC0, 0x1C, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x00, 0x00,
+	0x1F, 0x80, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x1F,
+	0x80, 0xF0, 0x00, 0x00, 0x1F, 0x80, 0xFF, 0x00, 0x00, 0x1F, 0x80, 0xFF, 0xF0, 0x00, 0x1F, 0x80,
+	0xFF, 0xFC, 0x00, 0x1F, 0x80, 0xFF, 0xFF, 0x80, 0x1F, 0x80, 0xFF, 0xFF, 0xC0, 0x1F, 0x80, 0xFF,
+	0xFF, 0xF0, 0x1F, 0x80, 0x07, 0xFF, 0xFC, 0x1F, 0x80, 0x00, 0x3F, 0xFE, 0x1F, 0x80, 0x00, 0x07,
+	0xFF, 0x9F, 0x80, 0x00, 0x01, 0xFF, 0xDF, 0x80, 0x00, 0x00, 0x3F, 0xFF, 0x80, 0x00, 0x00, 0x1F,
+	0xFF, 0x80, 0x00, 0x00, 0x07, 0xFF, 0x80, 0x00, 0x00, 0x01, 0xFF, 0x80, 0x00, 0x00, 0x00, 0xFF,
+	0x80, 0x00, 0x00, 0x00, 0x3F, 0x80, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x01, 0xFC, 0x00, 0x00, 0x00,
+	0x07, 0xFF, 0x01, 0xF8, 0x00, 0x0F, 0xFF, 0x87, 0xFE, 0x00, 0x1F, 0xFF, 0xC7, 0xFF, 0x00, 0x3F,
+	0xFF, 0xEF, 0xFF, 0x80, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x7F, 0x83,
+	0xFE, 0x1F, 0xC0, 0xFE, 0x00, 0xFC, 0x0F, 0xE0, 0xFC, 0x00, 0xF8, 0x07, 0xE0, 0xFC, 0x00, 0x78,
+	0x07, 0xE0, 0xFC, 0x00, 0x78, 0x07, 0xE0, 0xFC, 0x00, 0x78, 0x07, 0xE0, 0xFC, 0x00, 0x78, 0x07,
+	0xE0, 0xFE, 0x00, 0xFC, 0x0F, 0xE0, 0xFE, 0x00, 0xFC, 0x0F, 0xC0, 0x7F, 0x83, 0xFF, 0x3F, 0xC0,
+	0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x3F, 0xFF, 0xEF, 0xFF, 0x80, 0x3F, 0xFF, 0xEF, 0xFF, 0x00, 0x1F,
+	0xFF, 0xC7, 0xFE, 0x00, 0x0F, 0xFF, 0x81, 0xF8, 0x00, 0x07, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFC,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xE0, 0x00, 0x07, 0x00, 0xFF, 0xF8, 0x00, 0x1F, 0x01, 0xFF,
+	0xFE, 0x00, 0x3F, 0x03, 0xFF, 0xFF, 0x00, 0x3F, 0x07, 0xFF, 0xFF, 0x80, 0x7F, 0x0F, 0xFF, 0xFF,
+	0x80, 0x7F, 0x0F, 0xFF, 0xFF, 0xC0, 0xFF, 0x1F, 0xF0, 0x3F, 0xC0, 0xFE, 0x1F, 0xC0, 0x0F, 0xE0,
+	0xFC, 0x1F, 0xC0, 0x0F, 0xE0, 0xFC, 0x1F, 0x80, 0x07, 0xE0, 0xFC, 0x1F, 0x80, 0x07, 0xE0, 0xFC,
+	0x1F, 0x80, 0x07, 0xE0, 0xFC, 0x1F, 0x80, 0x07, 0xE0, 0xFE, 0x0F, 0xC0, 0x0F, 0xE0, 0x7F, 0x07,
+	0xE0, 0x1F, 0xE0, 0x7F, 0xC3, 0xF0, 0x3F, 0xC0, 0x3F, 0xFF, 0xFF, 0xFF, 0xC0, 0x3F, 0xFF, 0xFF,
+	0xFF, 0x80, 0x1F, 0xFF, 0xFF, 0xFF, 0x00, 0x0F, 0xFF, 0xFF, 0xFE, 0x00, 0x03, 0xFF, 0xFF, 0xFC,
+	0x00, 0x00, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x0F, 0xFF, 0x00, 0x00, 0xE0, 0xFE, 0xE0, 0xFE, 0xE0,
+	0xFE, 0x78, 0xFE, 0x7F, 0xFE, 0x3F, 0xFE, 0x0F, 0xFE
+};
+
+const NativeGlyph DigitAtlasGlyphs[] PROGMEM = {
+	{0, 24, 35, 26, 1, -33},  // '0'
+	{120, 14, 33, 26, 4, -32},  // '1'
+	{190, 23, 34, 26, 2, -33},  // '2'
+	{305, 23, 35, 26, 2, -33},  // '3'
+	{420, 22, 33, 26, 2, -32},  // '4'
+	{530, 23, 34, 26, 2, -32},  // '5'
+	{645, 23, 35, 26, 2, -33},  // '6'
+	{760, 23, 33, 26, 1, -32},  // '7'
+	{875, 24, 35, 26, 1, -33},  // '8'
+	{995, 24, 35, 26, 1, -33},  // '9'
+	{1115, 7, 15, 12, 2, -6},  // ','
+	{1129, 0, 0, 13, 0, 1},  // ' '
+};
+
+const NativeFont DigitAtlas = {
+	DigitAtlasBitmaps, DigitAtlasGlyphs, "0123456789, ", &FreeSansBold24pt7bDigits};
+
+#endif
@@ -0,0 +1,173 @@
+"""
+Pack the sketch's bitmaps into one assembler blob plus a small index header.
+
+The C-array headers (transit_bitmap.h alone is 900 KB of hex) used to be
+#included by PicoBusses.ino, so every edit to the sketch re-parsed them.
+assets.S holds the same bytes as .byte directives in its own translation
+unit -- the Arduino build compiles it once and reuses the object until the
+assets change -- and assets.h only declares the symbols.
+
+Inputs are headers as imagegen.py writes them: plain
+`const unsigned char NAME [] PROGMEM = {...};` arrays, and NativeBitmaps
+(imagegen.py --native) wrapping a NAME_bits array.
+
+With --pak the transit logos also go into data/logos.pak for the sketch's
+LittleFS asset store (LogoStore.h), which the firmware loads logos from on
+demand. Layout, little-endian:
+    "NBLP", u16 version, u16 count
+    count x { char name[8], u32 offset, u16 width, u16 height, u8 rotation, u8 reserved[3] }
+    logo data at each offset, NativeBitmap rows
+Names are line refs. --aliases names a file of "lineRef logo" lines for
+lines whose logo is stored under another name.
+"""
+
+import re
+import struct
+import sys
+from pathlib import Path
+
+PAK_MAGIC = b"NBLP"
+PAK_VERSION = 1
+PAK_NAME_LEN = 8
+
+ARRAY = re.compile(r"const unsigned char (\w+)\s*\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", re.S)
+NATIVE = re.compile(r"const NativeBitmap (\w+) = \{(\w+), (\d+), (\d+), (\d+)\};")
+
+def parse_assets(header_path):
+    """Pull the byte arrays and NativeBitmap definitions out of a generated header"""
+    text = Path(header_path).read_text()
+    arrays = [(name, bytes(int(b, 16) for b in re.findall(r"0x[0-9A-Fa-f]{2}", body)))
+              for name, body in ARRAY.findall(text)]
+    natives = [(name, bits, int(w), int(h), int(rot)) for name, bits, w, h, rot in NATIVE.findall(text)]
+    return arrays, natives
+
+def assembler_source(arrays):
+    """A global, word-aligned label per array, each in its own .rodata section"""
+    out = ["/* Generated by Scripts/assetpack.py -- do not edit */",
+           ""]
+    for name, data in arrays:
+        # A section each, so --gc-sections drops the ones nothing uses
+        out.append(f'    .section .rodata.assets.{name}, "a"')
+        out.append("    .balign 4")
+        out.append(f"    .global {name}")
+        out.append(f"    .type {name}, %object")
+        out.append(f"{name}:")
+        for i in range(0, len(data), 32):
+            out.append("    .byte " + ",".join(f"0x{b:02X}" for b in data[i:i+32]))
+        out.append(f"    .size {name}, {len(data)}")
+    out.append("")
+    return "\n".join(out)
+
+def read_aliases(path):
+    """(lineRef, logo) pairs from an aliases file; # starts a comment"""
+    aliases = []
+    for line in Path(path).read_text().splitlines():
+        fields = line.split("#", 1)[0].split()
+        if len(fields) == 2:
+            aliases.append((fields[0], fields[1]))
+    return aliases
+
+def logo_pak(arrays, natives, aliases):
+    """The transit logos as a logos.pak image (see the top of this file)"""
+    data = dict(arrays)
+    logos = {}
+    for name, bits, width, height, rotation in natives:
+        if name.startswith("transit_logo_"):
+            logos[name[len("transit_logo_"):]] = (data[bits], width, height, rotation)
+
+    # Every logo under its own name, then the aliases (which may replace one)
+    entries = {name: name for name in logos}
+    for line_ref, logo in aliases:
+        if logo not in logos:
+            raise SystemExit(f"Alias {line_ref} -> {logo}: no such logo")
+        entries[line_ref] = logo
+    for name in entries:
+        if len(name) >= PAK_NAME_LEN:
+            raise SystemExit(f"Name too long for the pak index: {name}")
+
+    header_size = 8 + 20 * len(entries)
+    offsets = {}
+    blob = b""
+    for logo in sorted(set(entries.values())):
+        offsets[logo] = header_size + len(blob)
+        blob += logos[logo][0]
+        blob += b"\0" * (-len(blob) % 4)
+
+    pak = PAK_MAGIC + struct.pack("<HH", PAK_VERSION, len(entries))
+    for name in sorted(entries):
+        logo = entries[name]
+        _, width, height, rotation = logos[logo]
+        pak += struct.pack("<8sIHHB3x", name.encode(), offsets[logo], width, height, rotation)
+    return pak + blob, len(entries), len(offsets)
+
+def index_header(arrays, natives, sources):
+    """extern declarations for every array, plus the NativeBitmaps over them"""
+    total = sum(len(data) for _, data in arrays)
+    out = ["// Generated by Scripts/assetpack.py from " + ", ".join(sources) + " -- do not edit",
+           f"// {len(arrays)} bitmaps, {total} bytes, linked in from assets.S",
+           "#ifndef ASSETS_H",
+           "#define ASSETS_H",
+           "",
+           '#include "MT_EPD.h"',
+           "",
+           'extern "C" {']
+    for name, data in arrays:
+        out.append(f"extern const unsigned char {name}[{len(data)}];")
+    out.append("}")
+
+    if natives:
+        out.append("")
+        for name, bits, width, height, rotation in natives:
+            out.append(f"const NativeBitmap {name} = {{{bits}, {width}, {height}, {rotation}}};")
+
+        logos = [name for name, *_ in natives if name.startswith("transit_logo_")]
+        if logos:
+            out.append("")
+            out.append(f"const int transit_logo_allArray_LEN = {len(logos)};")
+            out.append(f"const NativeBitmap* const transit_logo_allArray[{len(logos)}] = {{")
+            for name in logos:
+                out.append(f"\t&{name},")
+            out.append("};")
+
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    return "\n".join(out)
+
+def pack_assets(output_dir, headers, pak=False, aliases_path=None):
+    arrays = []
+    natives = []
+    for header in headers:
+        a, n = parse_assets(header)
+        arrays.extend(a)
+        natives.extend(n)
+
+    names = [name for name, _ in arrays]
+    duplicates = sorted(set(n for n in names if names.count(n) > 1))
+    if duplicates:
+        raise SystemExit(f"Duplicate asset names: {', '.join(duplicates)}")
+
+    output_dir = Path(output_dir)
+    (output_dir / "assets.S").write_text(assembler_source(arrays))
+    (output_dir / "assets.h").write_text(index_header(arrays, natives, [Path(h).name for h in headers]))
+    print(f"Packed {len(arrays)} arrays ({sum(len(d) for _, d in arrays)} bytes) -> "
+          f"{output_dir / 'assets.S'}, {output_dir / 'assets.h'}")
+
+    if pak:
+        aliases = read_aliases(aliases_path) if aliases_path else []
+        image, names, logos = logo_pak(arrays, natives, aliases)
+        (output_dir / "data").mkdir(exist_ok=True)
+        (output_dir / "data" / "logos.pak").write_bytes(image)
+        print(f"Packed {logos} logos under {names} names ({len(image)} bytes) -> {output_dir / 'data' / 'logos.pak'}")
+
+if __name__ == "__main__":
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    pak = "--pak" in sys.argv
+    aliases_path = next((a.split("=", 1)[1] for a in sys.argv if a.startswith("--aliases=")), None)
+    if len(args) > 1:
+        pack_assets(args[0], args[1:], pak, aliases_path)
+    else:
+        print("Usage: python assetpack.py <sketch folder> <generated header> [header...] [--pak [--aliases=<file>]]")
+        print("  e.g. python imagegen.py ../Graphics/Transit_Graphics /tmp/logos --native")
+        print("       python assetpack.py ../PicoBusses /tmp/logos/all_images.h ../Graphics/muni_bitmap.h \\")
+        print("           --pak --aliases=../Graphics/Transit_Graphics/aliases.txt")
@@ -0,0 +1,123 @@
+"""
+Build a payload corpus for the host benchmark (Bench/bench.cpp) out of the
+responses stopmonitor.py archived.
+
+The archive keeps each reply parsed, so the bytes the display would have
+received are rebuilt the way the 511 API sends them: UTF-8 with a byte order
+mark, gzipped. Next to those go synthetic replies for the two busiest stops,
+13124 and 13144, with far more visits than any archived reply: visits cloned
+from the archive, spread over the next hour and dealt out across the Market
+Street lines, so a stop has many lines and many times per line.
+
+    python benchcorpus.py [--archive=stop_16633_raw.jsonl] [--out=bench_corpus]
+                          [--limit=N] [--visits=N]
+
+Then:
+    build/nextbus_bench bench_corpus
+"""
+
+import copy
+import gzip
+import json
+import sys
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+
+BUSY_STOPS = ("13124", "13144")
+MARKET_LINES = ["F", "2", "5", "5R", "6", "7", "9", "9R", "14", "14R", "21",
+                "31", "38", "38R", "J", "K", "L", "M", "N", "T", "KBUS", "NOWL"]
+
+def iso(t):
+    return t.strftime("%Y-%m-%dT%H:%M:%SZ")
+
+def body(payload):
+    """A reply as it comes off the wire: BOM, compact JSON, gzip"""
+    text = json.dumps(payload, ensure_ascii=False, separators=(",", ":"))
+    return gzip.compress(b"\xef\xbb\xbf" + text.encode("utf-8"), mtime=0)
+
+def visits_of(payload):
+    delivery = payload["ServiceDelivery"]["StopMonitoringDelivery"]
+    if isinstance(delivery, list):
+        delivery = delivery[0]
+    return delivery.get("MonitoredStopVisit", [])
+
+def busy_stop(template, stop_code, count):
+    """A reply for stop_code with count visits, cloned from template's"""
+    payload = copy.deepcopy(template)
+    sample = visits_of(template)
+    now = datetime.strptime(payload["ServiceDelivery"]["ResponseTimestamp"],
+                            "%Y-%m-%dT%H:%M:%SZ").replace(tzinfo=timezone.utc)
+    visits = []
+    for i in range(count):
+        visit = copy.deepcopy(sample[i % len(sample)])
+        line = MARKET_LINES[i % len(MARKET_LINES)]
+        due = now + timedelta(seconds=60 + i * 3600 // count)
+        journey = visit["MonitoredVehicleJourney"]
+        journey["LineRef"] = line
+        journey["PublishedLineName"] = line
+        journey["VehicleRef"] = str(1000 + i * 7)
+        journey.get("FramedVehicleJourneyRef", {})["DatedVehicleJourneyRef"] = "%d_M31" % (11700000 + i * 13)
+        journey["VehicleLocation"] = {"Longitude": "%.6f" % (-122.42 + i * 1e-4),
+                                      "Latitude": "%.7f" % (37.77 + i * 3e-5)}
+        visit["MonitoringRef"] = stop_code
+        call = journey["MonitoredCall"]
+        call["StopPointRef"] = stop_code
+        call["StopPointName"] = "Market St stop %s" % stop_code
+        call["DestinationDisplay"] = ("Outbound %s" if i % 2 else "Inbound %s") % line
+        call["AimedArrivalTime"] = iso(due)
+        call["ExpectedArrivalTime"] = iso(due)
+        visits.append(visit)
+
+    delivery = payload["ServiceDelivery"]["StopMonitoringDelivery"]
+    if isinstance(delivery, list):
+        delivery = delivery[0]
+    delivery["MonitoredStopVisit"] = visits
+    return payload
+
+def main(argv):
+    archive = Path(__file__).with_name("stop_16633_raw.jsonl")
+    out = Path("bench_corpus")
+    limit = None
+    visits = 200
+    for arg in argv[1:]:
+        if arg.startswith("--archive="):
+            archive = Path(arg.split("=", 1)[1])
+        elif arg.startswith("--out="):
+            out = Path(arg.split("=", 1)[1])
+        elif arg.startswith("--limit="):
+            limit = int(arg.split("=", 1)[1])
+        elif arg.startswith("--visits="):
+            visits = int(arg.split("=", 1)[1])
+        else:
+            print("Usage: benchcorpus.py [--archive=FILE] [--out=DIR] [--limit=N] [--visits=N]")
+            return 1
+
+    out.mkdir(parents=True, exist_ok=True)
+    written = 0
+    largest = None
+    with archive.open(encoding="utf-8") as fh:
+        for n, line in enumerate(fh):
+            if limit is not None and written >= limit:
+                break
+            try:
+                payload = json.loads(line)["payload"]
+                visits_of(payload)
+            except (ValueError, KeyError, IndexError, TypeError):
+                continue  # a reply the archive couldn't decode
+            (out / ("16633_%04d.json.gz" % n)).write_bytes(body(payload))
+            written += 1
+            if largest is None or len(visits_of(payload)) > len(visits_of(largest)):
+                largest = payload
+
+    if largest is None or not visits_of(largest):
+        print("%s: no replies with visits" % archive)
+        return 1
+    for stop_code in BUSY_STOPS:
+        (out / ("%s_busy.json.gz" % stop_code)).write_bytes(body(busy_stop(largest, stop_code, visits)))
+
+    print("%d archived replies and %d busy stops (%d visits each) in %s"
+          % (written, len(BUSY_STOPS), visits, out))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
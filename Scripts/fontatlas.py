@@ -0,0 +1,114 @@
+import re
+import sys
+from pathlib import Path
+
+# Characters the arrival-times line can contain
+ATLAS_CHARS = "0123456789, "
+
+def parse_gfx_font(header_path):
+    """Pull the bitmap bytes, glyph table and yAdvance out of an Adafruit GFX font header"""
+    text = Path(header_path).read_text()
+    # Glyph comments quote the character itself, '{' and '}' included
+    text = re.sub(r"//[^\n]*", "", text)
+
+    bitmap_block = re.search(r"Bitmaps\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", text, re.S).group(1)
+    bitmap = [int(b, 16) for b in re.findall(r"0x[0-9A-Fa-f]{2}", bitmap_block)]
+
+    glyph_block = re.search(r"Glyphs\[\]\s*PROGMEM\s*=\s*\{(.*?)\};", text, re.S).group(1)
+    glyphs = []
+    for entry in re.findall(r"\{([^}]*)\}", glyph_block):
+        offset, width, height, x_advance, x_offset, y_offset = [int(v) for v in entry.split(",")]
+        glyphs.append((offset, width, height, x_advance, x_offset, y_offset))
+
+    font_block = re.search(r"const GFXfont (\w+) PROGMEM\s*=\s*\{(.*?)\};", text, re.S)
+    font_name = font_block.group(1)
+    first, last, y_advance = [int(v, 0) for v in font_block.group(2).split(",")[-3:]]
+
+    return font_name, bitmap, glyphs, first, y_advance
+
+def glyph_pixels(bitmap, offset, width, height):
+    """Unpack a GFX glyph (rows packed back to back, MSB first) into a 2D list"""
+    pixels = []
+    bit = 0
+    for y in range(height):
+        row = []
+        for x in range(width):
+            byte = bitmap[offset + (bit >> 3)]
+            row.append(1 if byte & (0x80 >> (bit & 7)) else 0)
+            bit += 1
+        pixels.append(row)
+    return pixels
+
+def rotate_glyph(pixels, width, height):
+    """
+    Re-pack a glyph for the panel's native layout under rotation 1.
+    Each output row is one physical row = one logical column of the glyph.
+    Bit k of that row is physical x (bottom of glyph) + k, i.e. logical row
+    height - 1 - k, so the row can be shifted straight into the plane.
+    """
+    row_bytes = (height + 7) // 8
+    out = []
+    for x in range(width):
+        row = [0] * row_bytes
+        for k in range(height):
+            if pixels[height - 1 - k][x]:
+                row[k >> 3] |= 0x80 >> (k & 7)
+        out.extend(row)
+    return out
+
+def generate_atlas(header_path, output_path, name, source_header=None, source_name=None):
+    """
+    source_header/source_name: the font the atlas stands in for at runtime,
+    e.g. a span font from fontcompile.py. Defaults to the GFX font itself.
+    """
+    font_name, bitmap, glyphs, first, y_advance = parse_gfx_font(header_path)
+    if source_header is None:
+        source_header = "Fonts/" + Path(header_path).name
+        source_name = font_name
+
+    atlas_bytes = []
+    atlas_glyphs = []
+    for c in ATLAS_CHARS:
+        offset, width, height, x_advance, x_offset, y_offset = glyphs[ord(c) - first]
+        pixels = glyph_pixels(bitmap, offset, width, height)
+        atlas_glyphs.append((len(atlas_bytes), width, height, x_advance, x_offset, y_offset, c))
+        atlas_bytes.extend(rotate_glyph(pixels, width, height))
+
+    code = "// Generated by Scripts/fontatlas.py from " + Path(header_path).name + " -- do not edit\n"
+    code += f"// '{ATLAS_CHARS}' pre-rotated for rotation 1, {len(atlas_bytes)} bytes\n"
+    code += f"#ifndef {name.upper()}_H\n#define {name.upper()}_H\n\n"
+    code += '#include "MT_EPD.h"\n'
+    code += f'#include "{source_header}"\n\n'
+
+    code += f"const uint8_t {name}Bitmaps[] PROGMEM = {{\n"
+    for i in range(0, len(atlas_bytes), 16):
+        line = "\t" + ", ".join(f"0x{b:02X}" for b in atlas_bytes[i:i+16])
+        if i + 16 < len(atlas_bytes):
+            line += ","
+        code += line + "\n"
+    code += "};\n\n"
+
+    code += f"const NativeGlyph {name}Glyphs[] PROGMEM = {{\n"
+    for offset, width, height, x_advance, x_offset, y_offset, c in atlas_glyphs:
+        code += f"\t{{{offset}, {width}, {height}, {x_advance}, {x_offset}, {y_offset}}},  // '{c}'\n"
+    code += "};\n\n"
+
+    code += f"const NativeFont {name} = {{\n"
+    code += f"\t{name}Bitmaps, {name}Glyphs, \"{ATLAS_CHARS}\", &{source_name}}};\n\n"
+    code += "#endif\n"
+
+    Path(output_path).write_text(code)
+    print(f"Wrote {len(ATLAS_CHARS)} glyphs, {len(atlas_bytes)} bytes to {output_path}")
+
+if __name__ == "__main__":
+    if len(sys.argv) > 2:
+        header_path = sys.argv[1]
+        output_path = sys.argv[2]
+        name = sys.argv[3] if len(sys.argv) > 3 else "DigitAtlas"
+        source_header = sys.argv[4] if len(sys.argv) > 5 else None
+        source_name = sys.argv[5] if len(sys.argv) > 5 else None
+        generate_atlas(header_path, output_path, name, source_header, source_name)
+    else:
+        print("Usage: python fontatlas.py <gfx font header> <output header> [name] [source include] [source font]")
+        print("  e.g. python fontatlas.py ../PicoBusses/Fonts/FreeSansBold24pt7b.h ../PicoBusses/digit_atlas.h DigitAtlas \\")
+        print("           Fonts/FreeSansBold24pt7bDigits.h FreeSansBold24pt7bDigits")
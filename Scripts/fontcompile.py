@@ -0,0 +1,111 @@
+import sys
+from pathlib import Path
+
+from fontatlas import parse_gfx_font, glyph_pixels
+
+PRINTABLE_ASCII = "".join(chr(c) for c in range(0x20, 0x7F))
+
+def column_spans(pixels, width, height):
+    """
+    Encode a glyph column by column as runs of set pixels.
+    Columns are what the panel stores as rows under rotation 1, so each run
+    becomes one contiguous fill in the frame buffer.
+
+    Per column: a run count n (< 0x80) followed by n (start row, length)
+    pairs, or 0x80 | k meaning "the previous column, k more times" --
+    vertical strokes make runs of identical columns common.
+    """
+    columns = []
+    for x in range(width):
+        runs = []
+        y = 0
+        while y < height:
+            if pixels[y][x]:
+                start = y
+                while y < height and pixels[y][x]:
+                    y += 1
+                runs.append((start, y - start))
+            else:
+                y += 1
+        columns.append(runs)
+
+    out = []
+    previous = None
+    repeats = 0
+    for runs in columns:
+        if runs == previous and repeats < 0x7F:
+            repeats += 1
+            continue
+        if repeats:
+            out.append(0x80 | repeats)
+            repeats = 0
+        out.append(len(runs))
+        for start, length in runs:
+            out.extend((start, length))
+        previous = runs
+    if repeats:
+        out.append(0x80 | repeats)
+    return out
+
+def compile_font(header_path, output_path, name, chars):
+    font_name, bitmap, glyphs, first, y_advance = parse_gfx_font(header_path)
+
+    wanted = sorted(set(chars))
+    lo, hi = ord(wanted[0]), ord(wanted[-1])
+
+    spans = []
+    span_glyphs = []
+    source_bytes = 0
+    for code in range(lo, hi + 1):
+        c = chr(code)
+        if c not in wanted:
+            # Not in the subset: draws nothing and doesn't advance, like a
+            # character outside a GFX font's range
+            span_glyphs.append((len(spans), 0, 0, 0, 0, 0, c))
+            continue
+        offset, width, height, x_advance, x_offset, y_offset = glyphs[code - first]
+        source_bytes += (width * height + 7) // 8
+        pixels = glyph_pixels(bitmap, offset, width, height)
+        span_glyphs.append((len(spans), width, height, x_advance, x_offset, y_offset, c))
+        spans.extend(column_spans(pixels, width, height))
+
+    gfx_total = len(bitmap) + 7 * len(glyphs)
+    span_total = len(spans) + 7 * len(span_glyphs)
+
+    code = "// Generated by Scripts/fontcompile.py from " + Path(header_path).name + " -- do not edit\n"
+    code += f"// {len(wanted)} glyphs, column spans: {span_total} bytes (GFX font: {gfx_total} bytes)\n"
+    code += "#pragma once\n"
+    code += '#include "../MT_EPD.h"\n\n'
+
+    code += f"const uint8_t {name}Spans[] PROGMEM = {{\n"
+    for i in range(0, len(spans), 16):
+        line = "    " + ", ".join(f"0x{b:02X}" for b in spans[i:i+16])
+        if i + 16 < len(spans):
+            line += ","
+        code += line + "\n"
+    code += "};\n\n"
+
+    code += f"const SpanGlyph {name}Glyphs[] PROGMEM = {{\n"
+    for offset, width, height, x_advance, x_offset, y_offset, c in span_glyphs:
+        shown = {"\\": "backslash", "'": "quote"}.get(c, c)
+        code += f"    {{{offset}, {width}, {height}, {x_advance}, {x_offset}, {y_offset}}},  // 0x{ord(c):02X} '{shown}'\n"
+    code += "};\n\n"
+
+    code += f"const SpanFont {name} PROGMEM = {{\n"
+    code += f"    {name}Spans, {name}Glyphs, 0x{lo:02X}, 0x{hi:02X}, {y_advance}}};\n"
+
+    Path(output_path).write_text(code)
+    print(f"{font_name}: {len(wanted)} glyphs, {span_total} bytes (was {gfx_total}, "
+          f"{source_bytes} of it bitmaps for these glyphs) -> {output_path}")
+
+if __name__ == "__main__":
+    if len(sys.argv) > 3:
+        header_path = sys.argv[1]
+        output_path = sys.argv[2]
+        name = sys.argv[3]
+        chars = sys.argv[4] if len(sys.argv) > 4 else PRINTABLE_ASCII
+        compile_font(header_path, output_path, name, chars)
+    else:
+        print("Usage: python fontcompile.py <gfx font header> <output header> <name> [characters]")
+        print("  e.g. python fontcompile.py ../PicoBusses/Fonts/FreeSans12pt7b.h ../PicoBusses/Fonts/FreeSans12pt7bSpans.h FreeSans12pt7bSpans")
+        print('       python fontcompile.py ../PicoBusses/Fonts/FreeSansBold24pt7b.h ../PicoBusses/Fonts/FreeSansBold24pt7bDigits.h FreeSansBold24pt7bDigits "0123456789, "')
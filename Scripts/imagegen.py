@@ -1,9 +1,16 @@
+import hashlib
+import json
 import os
+import re
 import sys
+from concurrent.futures import ProcessPoolExecutor
 from PIL import Image, ImageOps
 import numpy as np
 from pathlib import Path
 
+CANVAS_SIZE = (130, 130)
+CACHE_FILE = "imagegen_cache.json"
+
 def process_image(image_path, canvas_size=(140, 140), invert=True):
     """Process image according to specifications"""
     try:
@@ -70,6 +77,40 @@ def image_to_horizontal_bytes(img):
     
     return byte_array
 
+def native_pixel_order(width, height, rotation):
+    """
+    Logical pixels in the order the panel stores them with setRotation(rotation)
+    (800x480, MSB first along physical x). Returns the physical rows, each a
+    list of logical (x, y) per bit. Rows and bits both run in increasing
+    physical order; MT_EPD::drawNativeBitmap() uses the same mapping.
+    """
+    if rotation == 0:    # physical = logical
+        return [[(x, y) for x in range(width)] for y in range(height)]
+    if rotation == 1:    # logical column -> physical row, physical x = 799 - logical y
+        return [[(x, height - 1 - k) for k in range(height)] for x in range(width)]
+    if rotation == 2:    # both flipped
+        return [[(width - 1 - k, height - 1 - r) for k in range(width)] for r in range(height)]
+    if rotation == 3:    # logical column -> physical row from the bottom, physical x = logical y
+        return [[(width - 1 - r, k) for k in range(height)] for r in range(width)]
+    raise ValueError(f"rotation must be 0-3, not {rotation}")
+
+def pixels_to_native_bytes(pixel, width, height, rotation):
+    """Pack a pixel(x, y) -> 0/1 function into panel-native rows for a rotation"""
+    byte_array = []
+    for row in native_pixel_order(width, height, rotation):
+        for byte_x in range(0, len(row), 8):
+            byte_val = 0
+            for bit, (x, y) in enumerate(row[byte_x:byte_x + 8]):
+                if pixel(x, y):
+                    byte_val |= 0x80 >> bit
+            byte_array.append(byte_val)
+    return byte_array
+
+def image_to_native_bytes(img, rotation):
+    """Convert 1-bit image to panel-native rows for setRotation(rotation)"""
+    width, height = img.size
+    return pixels_to_native_bytes(lambda x, y: img.getpixel((x, y)) == 0, width, height, rotation)
+
 def generate_arduino_code(byte_array, width, height, name):
     """Generate Arduino code from byte array"""
     width_bytes = (width + 7) // 8
@@ -88,22 +129,78 @@ def generate_arduino_code(byte_array, width, height, name):
     code += "};\n"
     return code
 
-def process_folder(folder_path, output_folder=None):
-    """Process all images in a folder"""
+def generate_native_code(byte_array, width, height, name, rotation):
+    """Generate a NativeBitmap (see MT_EPD.h) from panel-native rows"""
+    code = f"// '{name}', {width}x{height}px, panel-native for rotation {rotation}\n"
+    code += f"const unsigned char transit_logo_{name}_bits [] PROGMEM = {{\n"
+    for i in range(0, len(byte_array), 16):
+        line = "\t" + ", ".join(f"0x{b:02X}" for b in byte_array[i:i+16])
+        if i + 16 < len(byte_array):
+            line += ","
+        code += line + "\n"
+    code += "};\n"
+    code += f"const NativeBitmap transit_logo_{name} = {{transit_logo_{name}_bits, {width}, {height}, {rotation}}};\n"
+    return code
+
+def native_header(all_code, names, total_bytes):
+    """Wrap generated NativeBitmaps into a standalone header (what assetpack.py packs)"""
+    code = "#ifndef TRANSIT_BITMAP_H\n#define TRANSIT_BITMAP_H\n\n"
+    code += "// Generated by Scripts/imagegen.py -- do not edit\n"
+    code += '#include "MT_EPD.h"\n\n'
+    code += all_code
+    code += f"\n// Array of all bitmaps for convenience. (Total bytes used to store images in PROGMEM = {total_bytes})\n"
+    code += f"const int transit_logo_allArray_LEN = {len(names)};\n"
+    code += f"const NativeBitmap* transit_logo_allArray[{len(names)}] = {{\n"
+    for name in names:
+        code += f"\t&transit_logo_{name},\n"
+    code += "};\n\n#endif\n"
+    return code
+
+def file_digest(path, rotation):
+    """Identifies one image's output: the file contents plus the settings that shape it"""
+    h = hashlib.sha1(Path(path).read_bytes())
+    h.update(f"{CANVAS_SIZE} rotation={rotation}".encode())
+    return h.hexdigest()
+
+def convert_image(img_path, output_folder, rotation):
+    """Convert one image and write its .h and preview. Runs in a worker process."""
+    img_name = img_path.stem.replace(" ", "_").replace("-", "_")
+    processed_img = process_image(img_path, canvas_size=CANVAS_SIZE, invert=False)
+    if not processed_img:
+        return img_name, None, 0
+
+    width, height = processed_img.size
+    if rotation is None:
+        byte_array = image_to_horizontal_bytes(processed_img)
+        code = generate_arduino_code(byte_array, width, height, img_name)
+    else:
+        byte_array = image_to_native_bytes(processed_img, rotation)
+        code = generate_native_code(byte_array, width, height, img_name, rotation)
+
+    # Save individual code file, and the processed image for verification
+    with open(os.path.join(output_folder, f"{img_name}.h"), "w") as f:
+        f.write(code)
+    processed_img.save(os.path.join(output_folder, f"{img_name}_processed.png"))
+    return img_name, code, len(byte_array)
+
+def process_folder(folder_path, output_folder=None, rotation=None, jobs=None):
+    """
+    Process all images in a folder. With a rotation, the bitmaps come out
+    panel-native for that setRotation(), ready for assetpack.py. Only images whose file or settings changed since the
+    last run are converted again (see CACHE_FILE), spread over jobs processes.
+    """
     if output_folder is None:
         output_folder = os.path.join(folder_path, "arduino_output")
     
     # Create output folder if it doesn't exist
     os.makedirs(output_folder, exist_ok=True)
     
-    # Combined output for all images
-    all_code = ""
-    
     # Find all image files in the folder
     image_extensions = ['.png', '.jpg', '.jpeg', '.bmp', '.gif']
     image_files = []
     for ext in image_extensions:
         image_files.extend(list(Path(folder_path).glob(f"*{ext}")))
+    image_files.sort()
     
     if not image_files:
         print(f"No image files found in {folder_path}")
@@ -111,48 +208,77 @@ def process_folder(folder_path, output_folder=None):
     
     print(f"Found {len(image_files)} image files")
     
-    # Store all bitmap names for array creation at the end
-    all_bitmap_names = []
+    # What the last run produced, by image name
+    cache_path = os.path.join(output_folder, CACHE_FILE)
+    try:
+        with open(cache_path) as f:
+            cache = json.load(f)
+    except (OSError, ValueError):
+        cache = {}
     
-    # Process each image
+    digests = {}
+    stale = []
     for img_path in image_files:
         img_name = img_path.stem.replace(" ", "_").replace("-", "_")
-        all_bitmap_names.append(img_name)
-        processed_img = process_image(img_path, canvas_size=(130, 130), invert=False)
-        
-        if processed_img:
-            width, height = processed_img.size
-            byte_array = image_to_horizontal_bytes(processed_img)
-            
-            # Generate Arduino code
-            code = generate_arduino_code(byte_array, width, height, img_name)
-            
-            # Save individual code file
-            with open(os.path.join(output_folder, f"{img_name}.h"), "w") as f:
-                f.write(code)
-            
-            # Add to combined code
-            all_code += code + "\n"
-            
-            print(f"Processed: {img_path.name}")
-            
-            # Optionally save the processed image for verification
-            processed_img.save(os.path.join(output_folder, f"{img_name}_processed.png"))
+        digests[img_name] = file_digest(img_path, rotation)
+        entry = cache.get(img_name)
+        if (entry and entry["digest"] == digests[img_name] and
+                os.path.exists(os.path.join(output_folder, f"{img_name}.h"))):
+            continue
+        stale.append(img_path)
     
-    # Add array of all bitmaps
-    total_bytes = sum(len(image_to_horizontal_bytes(process_image(img, canvas_size=(130, 130), invert=False))) 
-                       for img in image_files if process_image(img, canvas_size=(130, 130), invert=False))
+    print(f"{len(image_files) - len(stale)} unchanged, converting {len(stale)}")
     
-    array_code = f"\n// Array of all bitmaps for convenience. (Total bytes used to store images in PROGMEM = {total_bytes})\n"
-    array_code += f"const int transit_logo_allArray_LEN = {len(all_bitmap_names)};\n"
-    array_code += "const unsigned char* transit_logo_allArray[" + str(len(all_bitmap_names)) + "] = {\n"
+    # Convert the changed images in parallel
+    results = {}
+    if stale:
+        with ProcessPoolExecutor(max_workers=jobs) as pool:
+            futures = [pool.submit(convert_image, img_path, output_folder, rotation) for img_path in stale]
+            for img_path, future in zip(stale, futures):
+                img_name, code, size = future.result()
+                if code is None:
+                    cache.pop(img_name, None)
+                    continue
+                results[img_name] = (code, size)
+                cache[img_name] = {"digest": digests[img_name], "bytes": size}
+                print(f"Processed: {img_path.name}")
     
-    for name in all_bitmap_names:
-        array_code += f"\ttransit_logo_{name},\n"
+    # Combined output for all images, in file order; unchanged ones come from their .h
+    all_code = ""
+    all_bitmap_names = []
+    total_bytes = 0
+    for img_name in digests:
+        if img_name in results:
+            code, size = results[img_name]
+        elif img_name in cache:
+            with open(os.path.join(output_folder, f"{img_name}.h")) as f:
+                code = f.read()
+            size = cache[img_name]["bytes"]
+        else:
+            continue  # failed to convert
+        all_bitmap_names.append(img_name)
+        all_code += code + "\n"
+        total_bytes += size
     
-    array_code += "};"
+    # Forget images that are gone
+    cache = {name: entry for name, entry in cache.items() if name in digests}
+    with open(cache_path, "w") as f:
+        json.dump(cache, f, indent=1, sort_keys=True)
     
-    all_code += array_code
+    if rotation is not None:
+        all_code = native_header(all_code, all_bitmap_names, total_bytes)
+    else:
+        # Add array of all bitmaps
+        array_code = f"\n// Array of all bitmaps for convenience. (Total bytes used to store images in PROGMEM = {total_bytes})\n"
+        array_code += f"const int transit_logo_allArray_LEN = {len(all_bitmap_names)};\n"
+        array_code += "const unsigned char* transit_logo_allArray[" + str(len(all_bitmap_names)) + "] = {\n"
+        
+        for name in all_bitmap_names:
+            array_code += f"\ttransit_logo_{name},\n"
+        
+        array_code += "};"
+        
+        all_code += array_code
     
     # Save combined code
     with open(os.path.join(output_folder, "all_images.h"), "w") as f:
@@ -160,10 +286,55 @@ def process_folder(folder_path, output_folder=None):
     
     print(f"Done! Output saved to {output_folder}")
 
+def repack_header(header_path, output_path, rotation):
+    """
+    Re-pack an existing horizontal-byte transit_bitmap.h as panel-native
+    NativeBitmaps, for when the source images aren't at hand.
+    """
+    text = Path(header_path).read_text()
+    pattern = re.compile(r"// '(\w+)', (\d+)x(\d+)px\s*\nconst unsigned char transit_logo_(\w+) \[\] PROGMEM = \{(.*?)\};", re.S)
+    
+    all_code = ""
+    names = []
+    total_bytes = 0
+    for label, width, height, name, body in pattern.findall(text):
+        width, height = int(width), int(height)
+        data = [int(b, 16) for b in re.findall(r"0x[0-9A-Fa-f]{2}", body)]
+        width_bytes = (width + 7) // 8
+        pixel = lambda x, y: data[y * width_bytes + x // 8] & (0x80 >> (x % 8))
+        byte_array = pixels_to_native_bytes(pixel, width, height, rotation)
+        all_code += generate_native_code(byte_array, width, height, name, rotation) + "\n"
+        names.append(name)
+        total_bytes += len(byte_array)
+    
+    Path(output_path).write_text(native_header(all_code, names, total_bytes))
+    print(f"Re-packed {len(names)} bitmaps ({total_bytes} bytes) -> {output_path}")
+
+def parse_options(args):
+    """Split --native[=rotation] and --jobs=N off the positional arguments"""
+    rotation = None
+    jobs = None
+    positional = []
+    for arg in args:
+        if arg == "--native":
+            rotation = 1  # what the sketch runs at
+        elif arg.startswith("--native="):
+            rotation = int(arg.split("=", 1)[1])
+        elif arg.startswith("--jobs="):
+            jobs = int(arg.split("=", 1)[1])
+        else:
+            positional.append(arg)
+    return positional, rotation, jobs
+
 if __name__ == "__main__":
-    if len(sys.argv) > 1:
-        folder_path = sys.argv[1]
-        output_folder = sys.argv[2] if len(sys.argv) > 2 else None
-        process_folder(folder_path, output_folder)
+    args, rotation, jobs = parse_options(sys.argv[1:])
+    if len(args) == 3 and args[0] == "--repack":
+        repack_header(args[1], args[2], 1 if rotation is None else rotation)
+    elif len(args) > 0:
+        folder_path = args[0]
+        output_folder = args[1] if len(args) > 1 else None
+        process_folder(folder_path, output_folder, rotation, jobs)
     else:
-        print("Usage: python image_converter.py <folder_path> [output_folder]")
\ No newline at end of file
+        print("Usage: python imagegen.py <folder_path> [output_folder] [--native[=rotation]] [--jobs=N]")
+        print("       python imagegen.py --repack <transit_bitmap.h> <output header> [--native=rotation]")
+        print("  --native emits panel-native NativeBitmaps for setRotation(1) (or the one given)")
@@ -0,0 +1,190 @@
+"""
+Turn the sketch's serial output back into text.
+
+The running loop logs through Log.h, which sends binary records instead of
+text, mixed in with the plain text that setup and the reports still print.
+This passes the text through and decodes the records. Frames, little-endian,
+each starting with 0x1E (ASCII RS):
+    'R' u8 core, u8 level, u32 ms, u32 format, u8 argBytes, args
+    'D' u32 format, u16 length, text        the text of a format string
+    'X' u8 core, u32 count                  records dropped on a full ring
+An argument is a tag and its value: 'i' i32, 'u' u32, 'f' f32, or 's' u8
+length followed by the text.
+
+The device sends a format string's text ahead of its first use and again
+every minute. If the decoder attaches in between, --elf=<sketch .elf> lets it
+look the strings up in the firmware image instead. The Arduino IDE leaves the
+.elf in its build folder; "Export Compiled Binary" copies it next to the sketch.
+
+The input can be a capture file, a serial port (e.g. /dev/ttyACM0; USB CDC
+ignores the baud rate), or - for stdin.
+"""
+
+import re
+import struct
+import sys
+
+SYNC = 0x1E
+LEVELS = ["DEBUG", "INFO", "WARN", "ERROR"]
+
+# A C conversion: flags, width, precision, length modifier, conversion
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*|\*)(\.\d+)?(hh|h|ll|l|z|j|t|L)?([diouxXeEfgGcsp%])")
+
+class ElfStrings:
+    """Reads NUL-terminated strings out of a 32-bit little-endian ELF's loaded sections"""
+
+    def __init__(self, path):
+        data = open(path, "rb").read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise SystemExit(f"{path}: not a 32-bit little-endian ELF")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, kind, _, addr, offset, size = struct.unpack_from("<IIIIII", data, shoff + i * shentsize)
+            if kind == 1 and addr != 0:  # SHT_PROGBITS, loaded
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, address):
+        for addr, body in self.sections:
+            if addr <= address < addr + len(body):
+                start = address - addr
+                end = body.find(b"\0", start)
+                return body[start:end if end >= 0 else len(body)].decode("utf-8", "replace")
+        return None
+
+def render(format, args):
+    """printf, as far as Log.h's argument types go"""
+    out = []
+    pos = 0
+    queue = list(args)
+    for m in CONVERSION.finditer(format):
+        out.append(format[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if not queue:
+            out.append("<?>")  # cut off: the record was full
+            continue
+        value = queue.pop(0)
+        spec = "%" + flags + ("" if width == "*" else width) + (precision or "")
+        if conv in "diu":
+            out.append((spec + "d") % int(value))
+        elif conv in "oxX":
+            out.append((spec + conv) % (int(value) & 0xFFFFFFFF))
+        elif conv in "eEfgG":
+            out.append((spec + conv) % float(value))
+        elif conv == "c":
+            out.append((spec + "c") % chr(int(value) & 0xFF))
+        elif conv == "p":
+            out.append("0x%08x" % (int(value) & 0xFFFFFFFF))
+        else:
+            out.append((spec + "s") % value)
+    out.append(format[pos:])
+    return "".join(out)
+
+def parse_args(body):
+    args = []
+    i = 0
+    while i < len(body):
+        tag = chr(body[i])
+        if tag == "s":
+            n = body[i + 1]
+            args.append(body[i + 2:i + 2 + n].decode("utf-8", "replace"))
+            i += 2 + n
+        elif tag in "iuf":
+            args.append(struct.unpack_from({"i": "<i", "u": "<I", "f": "<f"}[tag], body, i + 1)[0])
+            i += 5
+        else:
+            break  # not a tag we know: show what we have
+    return args
+
+class Decoder:
+    def __init__(self, out, elf=None):
+        self.out = out
+        self.elf = elf
+        self.formats = {}
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        self.buffer += data
+        while self.buffer:
+            sync = self.buffer.find(SYNC)
+            if sync != 0:
+                text = self.buffer if sync < 0 else self.buffer[:sync]
+                self.out.write(text.decode("utf-8", "replace"))
+                del self.buffer[:len(text)]
+                continue
+            used = self.frame()
+            if used == 0:
+                break  # the rest of the frame hasn't arrived
+            del self.buffer[:used]
+        self.out.flush()
+
+    def frame(self):
+        """Decodes the frame at the start of the buffer; bytes used, 0 if incomplete"""
+        b = self.buffer
+        if len(b) < 2:
+            return 0
+        kind = chr(b[1])
+        if kind == "D":
+            if len(b) < 8:
+                return 0
+            address, length = struct.unpack_from("<IH", b, 2)
+            if len(b) < 8 + length:
+                return 0
+            self.formats[address] = b[8:8 + length].decode("utf-8", "replace")
+            return 8 + length
+        if kind == "X":
+            if len(b) < 7:
+                return 0
+            core, count = struct.unpack_from("<BI", b, 2)
+            self.out.write(f"[core{core}: {count} log records dropped, ring full]\n")
+            return 7
+        if kind == "R":
+            if len(b) < 13:
+                return 0
+            core, level, ms, address, arg_bytes = struct.unpack_from("<BBIIB", b, 2)
+            if len(b) < 13 + arg_bytes:
+                return 0
+            args = parse_args(b[13:13 + arg_bytes])
+            format = self.formats.get(address)
+            if format is None and self.elf:
+                format = self.elf.string(address)
+            if format is None:
+                text = f"<format 0x{address:08x}> " + " ".join(str(a) for a in args)
+            else:
+                text = render(format, args)
+            name = LEVELS[level] if level < len(LEVELS) else str(level)
+            self.out.write(f"[{ms // 1000:6d}.{ms % 1000:03d} c{core} {name:<5}] {text}\n")
+            return 13 + arg_bytes
+        # A stray RS in the text: pass it on
+        self.out.write(chr(SYNC))
+        return 1
+
+def decode(path, elf_path=None):
+    elf = ElfStrings(elf_path) if elf_path else None
+    decoder = Decoder(sys.stdout, elf)
+    source = sys.stdin.buffer if path == "-" else open(path, "rb", buffering=0)
+    if path != "-" and source.isatty():
+        import tty
+        tty.setraw(source.fileno())  # the frames are binary: no line discipline
+    while True:
+        data = source.read(4096)
+        if not data:
+            break
+        decoder.feed(data)
+
+if __name__ == "__main__":
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    elf_path = next((a.split("=", 1)[1] for a in sys.argv if a.startswith("--elf=")), None)
+    if len(args) == 1:
+        try:
+            decode(args[0], elf_path)
+        except KeyboardInterrupt:
+            pass
+    else:
+        print("Usage: python logdecode.py <capture file | serial port | -> [--elf=<sketch .elf>]")
+        print("  e.g. python logdecode.py /dev/ttyACM0 --elf=build/PicoBusses.ino.elf")
@@ -0,0 +1,470 @@
+"""
+A stand-in for the 511 StopMonitoring API on your own machine, over TLS,
+that can misbehave on demand. The sketch fetches from it instead of
+api.511.org when config.h defines MOCK_API_HOST (see config.template.h),
+so the fetch path can be exercised and timed without the live API and its
+60 requests an hour.
+
+Once, make a test CA and a server certificate for the address the display
+will connect to (openssl on PATH), which also writes the CA's trust anchor
+for the sketch to PicoBusses/trust_anchors_mock.h:
+    python mock511.py --make-ca=192.168.1.20
+
+Then serve:
+    python mock511.py [--port=8443] [--corpus=bench_corpus] [--faults=LIST]
+                      [--delay=8] [--chunk=64] [--gap=0.25]
+
+Replies are the recorded ones, gzipped with their byte order mark as the
+API sends them: a directory from benchcorpus.py, or stopmonitor.py's .jsonl
+archive (the default). A request for stopCode=N gets the next N_* file if
+the corpus has any, else the next reply of all, round and round.
+
+Faults, one per request. --faults=ok,slow,429 cycles through a list; a
+fault typed on stdin is queued ahead of it for the next request.
+    ok        the reply, with Content-Length
+    slow      the reply, after --delay seconds with nothing sent
+    trickle   the reply in --chunk byte pieces, --gap seconds apart
+    chunked   the reply with Transfer-Encoding: chunked, --chunk byte chunks
+    close     the reply with neither, ended by closing the connection
+    truncate  Content-Length for all of it, then half, then a close
+    reset     the request read, then a TCP reset, nothing sent
+    429, 5xx  that status (any three digits), with a short error body
+"""
+
+import itertools
+import json
+import os
+import re
+import shutil
+import socket
+import socketserver
+import ssl
+import struct
+import subprocess
+import sys
+import threading
+import time
+from pathlib import Path
+
+from benchcorpus import body as wire_body
+
+HERE = Path(__file__).resolve().parent
+HEADER = HERE.parent / "PicoBusses" / "trust_anchors_mock.h"
+NAMED = ("ok", "slow", "trickle", "chunked", "close", "truncate", "reset")
+REASONS = {429: "Too Many Requests", 500: "Internal Server Error", 502: "Bad Gateway",
+           503: "Service Unavailable", 504: "Gateway Timeout"}
+
+# ── the test CA ─────────────────────────────────────────────────────────────
+
+OPENSSL_CONF = """\
+[ ca ]
+default_ca = mock
+
+[ mock ]
+dir = {dir}
+database = $dir/index.txt
+serial = $dir/serial
+new_certs_dir = $dir/issued
+default_md = sha256
+policy = anything
+unique_subject = no
+copy_extensions = none
+
+[ anything ]
+commonName = supplied
+
+[ req ]
+distinguished_name = dn
+prompt = no
+
+[ dn ]
+CN = unused
+
+[ v3_ca ]
+basicConstraints = critical, CA:TRUE
+keyUsage = critical, keyCertSign, cRLSign
+subjectKeyIdentifier = hash
+
+[ v3_server ]
+basicConstraints = CA:FALSE
+keyUsage = critical, digitalSignature, keyEncipherment
+extendedKeyUsage = serverAuth
+subjectKeyIdentifier = hash
+authorityKeyIdentifier = keyid
+subjectAltName = {names}
+"""
+
+# Valid from well before any build: the sketch may check against its build
+# date rather than a real clock
+NOT_BEFORE = "20200101000000Z"
+NOT_AFTER = "20450101000000Z"
+
+def openssl(*args, conf=None):
+    command = ["openssl"] + list(args)
+    if conf is not None:
+        command += ["-config", str(conf)]
+    result = subprocess.run(command, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise SystemExit("openssl %s failed:\n%s" % (args[0], result.stderr))
+
+def make_ca(host, certs, header):
+    if shutil.which("openssl") is None:
+        print("--make-ca needs openssl on PATH")
+        return 1
+    certs.mkdir(parents=True, exist_ok=True)
+    (certs / "issued").mkdir(exist_ok=True)
+    (certs / "index.txt").write_text("")
+    (certs / "serial").write_text("1000\n")
+
+    # BearSSL matches the host against DNS names only, so an address goes
+    # in as one too (and as an IP entry, for curl)
+    names = "DNS:" + host
+    if re.fullmatch(r"[0-9.]+|[0-9a-fA-F:]+", host):
+        names += ", IP:" + host
+    conf = certs / "openssl.cnf"
+    conf.write_text(OPENSSL_CONF.format(dir=certs.resolve(), names=names))
+
+    dated = ["-batch", "-notext", "-startdate", NOT_BEFORE, "-enddate", NOT_AFTER]
+    openssl("genrsa", "-out", str(certs / "ca.key"), "2048")
+    openssl("req", "-new", "-key", str(certs / "ca.key"), "-out", str(certs / "ca.csr"),
+            "-subj", "/CN=NextBusPico mock 511 CA", conf=conf)
+    openssl("ca", "-selfsign", "-keyfile", str(certs / "ca.key"), "-in", str(certs / "ca.csr"),
+            "-out", str(certs / "ca.crt"), "-extensions", "v3_ca", *dated, conf=conf)
+    openssl("genrsa", "-out", str(certs / "server.key"), "2048")
+    openssl("req", "-new", "-key", str(certs / "server.key"), "-out", str(certs / "server.csr"),
+            "-subj", "/CN=" + host, conf=conf)
+    openssl("ca", "-cert", str(certs / "ca.crt"), "-keyfile", str(certs / "ca.key"),
+            "-in", str(certs / "server.csr"), "-out", str(certs / "server.crt"),
+            "-extensions", "v3_server", *dated, conf=conf)
+
+    header.write_text(trust_anchor_header(certs / "ca.crt", host))
+    print("CA and a certificate for %s in %s" % (host, certs))
+    print("Trust anchor in %s; set MOCK_API_HOST \"%s\" in config.h" % (header, host))
+    return 0
+
+def der_item(data, at):
+    """(tag, start of contents, end) of the DER item at at"""
+    tag, length = data[at], data[at + 1]
+    at += 2
+    if length & 0x80:
+        n = length & 0x7F
+        length = int.from_bytes(data[at:at + n], "big")
+        at += n
+    return tag, at, at + length
+
+def der_children(data, start, end):
+    children = []
+    while start < end:
+        item = der_item(data, start)
+        children.append((start,) + item)
+        start = item[2]
+    return children
+
+def trust_anchor(pem_path):
+    """A certificate's subject DN (DER) and RSA modulus and exponent"""
+    cert = ssl.PEM_cert_to_DER_cert(pem_path.read_text())
+    _, start, end = der_item(cert, 0)
+    _, start, end = der_item(cert, start)  # tbsCertificate
+    fields = der_children(cert, start, end)
+    if fields[0][1] == 0xA0:  # [0] version
+        fields = fields[1:]
+    # serial, signature, issuer, validity, subject, subjectPublicKeyInfo
+    subject = cert[fields[4][0]:fields[4][3]]
+    spki = der_children(cert, fields[5][2], fields[5][3])
+    bits = cert[spki[1][2] + 1:spki[1][3]]  # past the unused-bits byte
+    _, start, end = der_item(bits, 0)
+    modulus, exponent = [bits[c[2]:c[3]].lstrip(b"\0") for c in der_children(bits, start, end)]
+    return subject, modulus, exponent
+
+def c_array(name, data):
+    lines = ["static const unsigned char %s[] = {" % name]
+    for i in range(0, len(data), 12):
+        lines.append("    " + " ".join("0x%02x," % b for b in data[i:i + 12]))
+    lines.append("};")
+    return "\n".join(lines)
+
+def trust_anchor_header(pem_path, host):
+    subject, modulus, exponent = trust_anchor(pem_path)
+    return """\
+#ifndef _MOCK_CERTIFICATES_H_
+#define _MOCK_CERTIFICATES_H_
+
+#ifdef __cplusplus
+extern "C"
+{{
+#endif
+
+/* This file is generated by Scripts/mock511.py --make-ca.  Do not change it manually.
+ * Certificates are BearSSL br_x509_trust_anchor format.  Included certs:
+ *
+ * Index:    0
+ * Label:    NextBusPico mock 511 CA
+ * Domain(s): {host}
+ */
+
+#define TAs_NUM 1
+
+{dn}
+
+{n}
+
+{e}
+
+static const br_x509_trust_anchor TAs[] = {{
+    {{
+        {{ (unsigned char *)TA_DN0, sizeof TA_DN0 }},
+        BR_X509_TA_CA,
+        {{
+            BR_KEYTYPE_RSA,
+            {{ .rsa = {{
+                (unsigned char *)TA_RSA_N0, sizeof TA_RSA_N0,
+                (unsigned char *)TA_RSA_E0, sizeof TA_RSA_E0,
+            }} }}
+        }}
+    }},
+}};
+
+#ifdef __cplusplus
+}} /* extern "C" */
+#endif
+
+#endif /* ifndef _MOCK_CERTIFICATES_H_ */
+""".format(host=host, dn=c_array("TA_DN0", subject), n=c_array("TA_RSA_N0", modulus),
+           e=c_array("TA_RSA_E0", exponent))
+
+# ── the corpus ──────────────────────────────────────────────────────────────
+
+def load_corpus(path):
+    """(name, wire bytes) of every reply in a benchcorpus.py directory or an archive"""
+    if path.is_dir():
+        return [(p.name, p.read_bytes()) for p in sorted(path.iterdir()) if p.is_file()]
+    replies = []
+    with path.open(encoding="utf-8") as fh:
+        for n, line in enumerate(fh):
+            try:
+                replies.append(("%s:%d" % (path.name, n + 1), wire_body(json.loads(line)["payload"])))
+            except (ValueError, KeyError):
+                continue
+    return replies
+
+class Corpus:
+    def __init__(self, replies):
+        self._all = itertools.cycle(replies)
+        self._by_stop = {}
+        for name, data in replies:
+            stop = name.split("_", 1)[0]
+            if stop.isdigit():
+                self._by_stop.setdefault(stop, []).append((name, data))
+        self._by_stop = {stop: itertools.cycle(r) for stop, r in self._by_stop.items()}
+        self._lock = threading.Lock()
+
+    def next(self, stop_code):
+        with self._lock:
+            return next(self._by_stop.get(stop_code, self._all))
+
+# ── faults ──────────────────────────────────────────────────────────────────
+
+def valid_fault(name):
+    return name in NAMED or re.fullmatch(r"[1-5][0-9][0-9]", name) is not None
+
+class Faults:
+    """The fault for each request: queued ones first, then the cycle"""
+
+    def __init__(self, cycle):
+        self._cycle = itertools.cycle(cycle)
+        self._queued = []
+        self._lock = threading.Lock()
+
+    def queue(self, name):
+        with self._lock:
+            self._queued.append(name)
+
+    def next(self):
+        with self._lock:
+            return self._queued.pop(0) if self._queued else next(self._cycle)
+
+# ── the server ──────────────────────────────────────────────────────────────
+
+class Handler(socketserver.BaseRequestHandler):
+    def handle(self):
+        server = self.server
+        started = time.monotonic()
+        try:
+            conn = server.tls.wrap_socket(self.request, server_side=True)
+        except (ssl.SSLError, OSError) as error:
+            server.log(self.client_address, "-", "-", "handshake failed: %s" % error)
+            return
+        conn.settimeout(30)
+
+        request = b""
+        try:
+            while b"\r\n\r\n" not in request and len(request) < 16384:
+                data = conn.recv(4096)
+                if not data:
+                    break
+                request += data
+        except (OSError, ssl.SSLError):
+            pass
+        line = request.split(b"\r\n", 1)[0].decode("latin-1")
+        match = re.search(r"[?&]stopCode=([^&\s]+)", line)
+        stop_code = match.group(1) if match else ""
+        path = re.sub(r"api_key=[^&\s]*", "api_key=...", line)
+
+        fault = server.faults.next()
+        name, data = server.corpus.next(stop_code)
+        try:
+            sent = self.reply(conn, fault, data)
+            note = "%d bytes" % sent
+            if not fault[0].isdigit() and fault != "reset":
+                note += " of " + name
+        except (OSError, ssl.SSLError) as error:
+            note = "client went away: %s" % error
+        server.log(self.client_address, path, fault, "%s, %.2f s" % (note, time.monotonic() - started))
+
+    def reply(self, conn, fault, data):
+        server = self.server
+        if fault == "reset":
+            # SO_LINGER 0: close() sends RST, and no TLS close_notify first
+            conn.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+            os.close(conn.detach())
+            return 0
+        if fault[0].isdigit():
+            status = int(fault)
+            text = b'{"error":"mock %d"}' % status
+            head = ["HTTP/1.1 %d %s" % (status, REASONS.get(status, "Mock")),
+                    "Content-Type: application/json", "Content-Length: %d" % len(text)]
+            if status == 429:
+                head.append("Retry-After: 60")
+            conn.sendall(header_bytes(head) + text)
+            return len(text)
+
+        head = ["HTTP/1.1 200 OK", "Content-Type: application/json; charset=utf-8",
+                "Content-Encoding: gzip"]
+        if fault == "chunked":
+            head.append("Transfer-Encoding: chunked")
+        elif fault != "close":
+            head.append("Content-Length: %d" % len(data))
+        if fault == "slow":
+            time.sleep(server.delay)
+        conn.sendall(header_bytes(head))
+
+        if fault == "truncate":
+            conn.sendall(data[:len(data) // 2])
+            conn.close()
+            return len(data) // 2
+        if fault == "chunked":
+            for i in range(0, len(data), server.chunk):
+                piece = data[i:i + server.chunk]
+                conn.sendall(b"%x\r\n%s\r\n" % (len(piece), piece))
+            conn.sendall(b"0\r\n\r\n")
+        elif fault == "trickle":
+            for i in range(0, len(data), server.chunk):
+                conn.sendall(data[i:i + server.chunk])
+                time.sleep(server.gap)
+        else:
+            conn.sendall(data)
+        try:
+            conn.unwrap()
+        except (OSError, ssl.SSLError):
+            pass
+        return len(data)
+
+def header_bytes(lines):
+    lines = lines + ["Date: " + time.strftime("%a, %d %b %Y %H:%M:%S GMT", time.gmtime()),
+                     "Connection: close"]
+    return ("\r\n".join(lines) + "\r\n\r\n").encode("latin-1")
+
+class MockServer(socketserver.ThreadingMixIn, socketserver.TCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+    def __init__(self, port, tls, corpus, faults, delay, chunk, gap):
+        super().__init__(("", port), Handler)
+        self.tls, self.corpus, self.faults = tls, corpus, faults
+        self.delay, self.chunk, self.gap = delay, chunk, gap
+        self._lock = threading.Lock()
+
+    def log(self, client, path, fault, note):
+        with self._lock:
+            print("%s %-15s %-9s %s  %s" % (time.strftime("%H:%M:%S"), client[0], fault, path, note),
+                  flush=True)
+
+def usage():
+    print("Usage: mock511.py --make-ca=HOST [--certs=DIR] [--header=FILE]")
+    print("       mock511.py [--port=8443] [--certs=DIR] [--corpus=DIR|FILE.jsonl] [--faults=LIST]")
+    print("                  [--delay=SECONDS] [--chunk=BYTES] [--gap=SECONDS]")
+    print("  faults: %s, or a status such as 429 or 503" % ", ".join(NAMED))
+    return 1
+
+def main(argv):
+    certs = HERE / "mock_certs"
+    header = HEADER
+    make_host = None
+    port = 8443
+    corpus_path = HERE / "stop_16633_raw.jsonl"
+    cycle = ["ok"]
+    delay, chunk, gap = 8.0, 64, 0.25
+    for arg in argv[1:]:
+        key, _, value = arg.partition("=")
+        if key == "--make-ca" and value:
+            make_host = value
+        elif key == "--certs":
+            certs = Path(value)
+        elif key == "--header":
+            header = Path(value)
+        elif key == "--port":
+            port = int(value)
+        elif key == "--corpus":
+            corpus_path = Path(value)
+        elif key == "--faults":
+            cycle = [f.strip() for f in value.split(",") if f.strip()]
+        elif key == "--delay":
+            delay = float(value)
+        elif key == "--chunk":
+            chunk = max(1, int(value))
+        elif key == "--gap":
+            gap = float(value)
+        else:
+            return usage()
+    if make_host is not None:
+        return make_ca(make_host, certs, header)
+
+    bad = [f for f in cycle if not valid_fault(f)]
+    if bad or not cycle:
+        print("Unknown fault: %s" % ", ".join(bad))
+        return usage()
+    if not (certs / "server.crt").exists():
+        print("No certificate in %s; run with --make-ca=HOST first" % certs)
+        return 1
+    replies = load_corpus(corpus_path)
+    if not replies:
+        print("No replies in %s" % corpus_path)
+        return 1
+
+    tls = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    tls.load_cert_chain(certs / "server.crt", certs / "server.key")
+    faults = Faults(cycle)
+    server = MockServer(port, tls, Corpus(replies), faults, delay, chunk, gap)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    print("Serving %d replies on port %d, faults %s; type a fault to queue it" %
+          (len(replies), port, ",".join(cycle)), flush=True)
+
+    try:
+        for line in sys.stdin:
+            name = line.strip()
+            if not name:
+                continue
+            if valid_fault(name):
+                faults.queue(name)
+                print("queued %s" % name, flush=True)
+            else:
+                print("faults: %s, or a status such as 429 or 503" % ", ".join(NAMED), flush=True)
+        while True:  # stdin closed; serve until interrupted
+            time.sleep(3600)
+    except KeyboardInterrupt:
+        pass
+    server.shutdown()
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,179 @@
+"""
+Turn the sketch's profiler samples into a profile.
+
+Build with PROFILER set to 1 in Profiler.h, run the display through a few
+fetches, then fetch the samples (each fetch takes them, so append):
+    curl -s http://<display>:9100/profile >> profile.bin
+
+A dump is "NBPF", u16 version, u16 period (us), u32 sample count, u32 dropped
+on core0 and core1, then the samples: u32 PC (bit 0 is the core) and u32 LR,
+little-endian. Several dumps may be concatenated.
+
+This looks every PC and LR up in the function symbols of the sketch's .elf
+(the Arduino IDE leaves it in its build folder; "Export Compiled Binary"
+copies it next to the sketch) and prints:
+  - a flat profile: samples per function, per core;
+  - callers: for the hottest functions, where the LR pointed. That's the
+    caller for a leaf that hasn't pushed LR yet, and an earlier call site in
+    the function itself once it has, so it's one level and a hint, not a
+    call graph;
+  - the hottest addresses inside the hottest functions, as func+0xNN, and
+    with --lines the source line of each (arm-none-eabi-addr2line on PATH).
+"""
+
+import bisect
+import shutil
+import struct
+import subprocess
+import sys
+from collections import Counter, defaultdict
+
+MAGIC = b"NBPF"
+HEADER = struct.Struct("<4sHHIII")
+SAMPLE = struct.Struct("<II")
+
+class ElfFunctions:
+    """Function symbols of a 32-bit little-endian ELF, by address"""
+
+    def __init__(self, path):
+        data = open(path, "rb").read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise SystemExit(f"{path}: not a 32-bit little-endian ELF")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+        functions = {}
+        for _, kind, _, _, offset, size, link, _, _, entsize in sections:
+            if kind != 2:  # SHT_SYMTAB
+                continue
+            strings = sections[link]
+            for at in range(offset, offset + size, entsize):
+                name, value, length, info, _, _ = struct.unpack_from("<IIIBBH", data, at)
+                if info & 0xF != 2 or value == 0:  # STT_FUNC
+                    continue
+                start = strings[4] + name
+                text = data[start:data.index(b"\0", start)].decode("ascii", "replace")
+                functions[value & ~1] = (max(length, 2), text)  # Thumb bit off
+        self.starts = sorted(functions)
+        self.functions = [functions[a] for a in self.starts]
+
+    def find(self, address):
+        """(start, name) of the function holding address, or None"""
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i < 0:
+            return None
+        length, name = self.functions[i]
+        start = self.starts[i]
+        return (start, name) if address < start + length else None
+
+def demangle(names):
+    """C++ names, readable, if c++filt is around"""
+    tool = shutil.which("arm-none-eabi-c++filt") or shutil.which("c++filt")
+    names = sorted(set(names))
+    if not tool or not names:
+        return {n: n for n in names}
+    out = subprocess.run([tool], input="\n".join(names), capture_output=True, text=True).stdout.split("\n")
+    return {n: (out[i] if i < len(out) and out[i] else n) for i, n in enumerate(names)}
+
+def read_dumps(paths):
+    """(samples, period_us, dropped per core) over every dump in every file"""
+    samples = []
+    period = 0
+    dropped = [0, 0]
+    for path in paths:
+        data = open(path, "rb").read()
+        at = 0
+        while at + HEADER.size <= len(data):
+            magic, version, period, count, drop0, drop1 = HEADER.unpack_from(data, at)
+            if magic != MAGIC or version != 1:
+                raise SystemExit(f"{path}: no dump at byte {at}")
+            at += HEADER.size
+            count = min(count, (len(data) - at) // SAMPLE.size)  # a cut-off fetch
+            samples += [SAMPLE.unpack_from(data, at + i * SAMPLE.size) for i in range(count)]
+            at += count * SAMPLE.size
+            dropped = [max(dropped[0], drop0), max(dropped[1], drop1)]  # since boot
+    return samples, period, dropped
+
+def source_lines(elf_path, addresses):
+    tool = shutil.which("arm-none-eabi-addr2line")
+    if not tool or not addresses:
+        return {}
+    out = subprocess.run([tool, "-e", elf_path] + ["0x%x" % a for a in addresses],
+                         capture_output=True, text=True).stdout.split("\n")
+    return dict(zip(addresses, out))
+
+def profile(elf_path, paths, top, lines):
+    elf = ElfFunctions(elf_path)
+    samples, period, dropped = read_dumps(paths)
+    if not samples:
+        raise SystemExit("No samples: was the profiled work run since the last fetch?")
+
+    def function(address):
+        found = elf.find(address)
+        return found if found else (address, "0x%08x" % address)
+
+    self_counts = Counter()
+    per_core = defaultdict(lambda: [0, 0])
+    callers = defaultdict(Counter)
+    pcs = defaultdict(Counter)
+    starts = {}
+    for pc, lr in samples:
+        core = pc & 1
+        pc &= ~1
+        start, name = function(pc)
+        self_counts[name] += 1
+        starts[name] = start
+        per_core[name][core] += 1
+        pcs[name][pc - start] += 1
+        if lr & 0xFFFFFFF0 == 0xFFFFFFF0:
+            callers[name][("<exception return>", None)] += 1  # a handler's first instructions
+        else:
+            at = (lr & ~1) - 2  # the call, not the return address
+            caller_start, caller = function(at)
+            callers[name][(caller, at - caller_start if caller == name else None)] += 1
+
+    names = demangle(list(self_counts) + [c for counts in callers.values() for c, _ in counts])
+    total = len(samples)
+    cores = [sum(1 for pc, _ in samples if pc & 1 == c) for c in (0, 1)]
+    print(f"{total} samples, one per {period} us per core while recording: "
+          f"core0 {cores[0]} (~{cores[0] * period / 1e6:.2f} s), core1 {cores[1]} (~{cores[1] * period / 1e6:.2f} s)")
+    if dropped[0] or dropped[1]:
+        print(f"dropped on a full ring since boot: core0 {dropped[0]}, core1 {dropped[1]}"
+              " -- fetch more often, or raise PROFILER_SAMPLES")
+
+    print()
+    print("Flat profile")
+    print(f"{'self':>7} {'%':>6} {'core0':>6} {'core1':>6}  function")
+    hot = self_counts.most_common(top)
+    for name, count in hot:
+        core0, core1 = per_core[name]
+        print(f"{count:7d} {100.0 * count / total:5.1f}% {core0:6d} {core1:6d}  {names[name]}")
+
+    print()
+    print("Callers (from LR)")
+    for name, count in hot[:min(top, 10)]:
+        print(f"{names[name]}  ({count})")
+        for (caller, offset), n in callers[name].most_common(5):
+            where = names.get(caller, caller) if offset is None else "itself, +0x%x" % offset
+            print(f"    {n:7d} {100.0 * n / count:5.1f}%  {where}")
+
+    print()
+    print("Hottest addresses")
+    rows = []
+    for name, count in hot[:min(top, 10)]:
+        for offset, n in pcs[name].most_common(3):
+            rows.append((starts[name] + offset, n, "%s+0x%x" % (names[name], offset)))
+    where = source_lines(elf_path, [a for a, _, _ in rows]) if lines else {}
+    for address, n, label in rows:
+        line = f"  {where[address]}" if address in where else ""
+        print(f"{n:7d} 0x{address:08x} {label}{line}")
+
+if __name__ == "__main__":
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    top = next((int(a.split("=", 1)[1]) for a in sys.argv if a.startswith("--top=")), 25)
+    if len(args) >= 2:
+        profile(args[0], args[1:], top, "--lines" in sys.argv)
+    else:
+        print("Usage: python profsym.py <sketch .elf> <profile.bin> [more dumps...] [--top=N] [--lines]")
+        print("  e.g. curl -s http://nextbus.local:9100/profile >> profile.bin")
+        print("       python profsym.py build/PicoBusses.ino.elf profile.bin --top=30")
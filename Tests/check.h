@@ -0,0 +1,43 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+#include <cstring>
+
+// Just enough of a test harness for the host tests: CHECK() prints the
+// failed expectation and counts it, and the test's main() returns
+// checkFailures() so ctest sees it.
+
+inline int& checkFailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool checkReport(bool ok, const char* file, int line, const char* what) {
+    if (!ok) {
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, what);
+        checkFailureCount()++;
+    }
+    return ok;
+}
+
+inline bool checkStrings(const char* a, const char* b, const char* file, int line, const char* what) {
+    bool ok = strcmp(a, b) == 0;
+    if (!ok) fprintf(stderr, "%s:%d: \"%s\" != \"%s\"\n", file, line, a, b);
+    return checkReport(ok, file, line, what);
+}
+
+#define CHECK(expr) checkReport((expr), __FILE__, __LINE__, #expr)
+#define CHECK_STR(a, b) checkStrings((a), (b), __FILE__, __LINE__, #a " == " #b)
+
+// 0 if every CHECK passed, for main() to return
+inline int checkFailures() {
+    if (checkFailureCount() == 0) {
+        printf("all checks passed\n");
+        return 0;
+    }
+    fprintf(stderr, "%d checks failed\n", checkFailureCount());
+    return 1;
+}
+
+#endif
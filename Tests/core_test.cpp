@@ -0,0 +1,293 @@
+// Unit tests for the portable core (see CMakeLists.txt): GzipInflater's
+// member framing and inflate, StopMonitorParser's times and fields, and
+// ArrivalBoard's rows. Gzip members are built here with miniz's compressor,
+// so every optional header field can be exercised without recorded bodies.
+//
+//   ctest --test-dir build     (or build/nextbus_core_test)
+
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "GzipInflater.h"
+#include "StopMonitorParser.h"
+#include "ArrivalBoard.h"
+#include "miniz.h"
+
+static const uint8_t FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10;
+
+static const char TEXT[] =
+    "{\"ServiceDelivery\":{\"ResponseTimestamp\":\"2025-05-07T16:07:30Z\","
+    "\"StopMonitoringDelivery\":{\"MonitoredStopVisit\":[]}}}";
+
+static void append(std::vector<uint8_t>& out, const void* data, size_t length) {
+    size_t at = out.size();
+    out.resize(at + length);
+    memcpy(out.data() + at, data, length);
+}
+
+// A gzip member of text, with the optional header fields flags asks for
+static std::vector<uint8_t> gzipMember(const std::string& text, uint8_t flags) {
+    std::vector<uint8_t> out = {0x1F, 0x8B, 8, flags, 0, 0, 0, 0, 0, 3};
+    if (flags & FEXTRA) {
+        const uint8_t extra[] = {5, 0, 'A', 'P', 1, 0, 7};  // XLEN 5: one subfield, SI1 SI2 LEN data
+        append(out, extra, sizeof(extra));
+    }
+    if (flags & FNAME) {
+        const char name[] = "stopmonitoring.json";
+        append(out, name, sizeof(name));
+    }
+    if (flags & FCOMMENT) {
+        const char comment[] = "from the 511 API";
+        append(out, comment, sizeof(comment));
+    }
+    if (flags & FHCRC) {
+        uint32_t crc = (uint32_t)mz_crc32(MZ_CRC32_INIT, out.data(), out.size());
+        out.push_back(crc & 0xFF);
+        out.push_back((crc >> 8) & 0xFF);
+    }
+
+    size_t streamLength = 0;
+    void* stream = tdefl_compress_mem_to_heap(text.data(), text.size(), &streamLength, TDEFL_DEFAULT_MAX_PROBES);
+    append(out, stream, streamLength);
+    free(stream);
+
+    uint32_t crc = (uint32_t)mz_crc32(MZ_CRC32_INIT, (const uint8_t*)text.data(), text.size());
+    uint32_t size = (uint32_t)text.size();
+    for (int i = 0; i < 4; i++) out.push_back((crc >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 4; i++) out.push_back((size >> (8 * i)) & 0xFF);
+    return out;
+}
+
+static void testGzipHeaders() {
+    const uint8_t cases[] = {0, FEXTRA, FNAME, FCOMMENT, FHCRC, FEXTRA | FNAME | FCOMMENT | FHCRC};
+    for (uint8_t flags : cases) {
+        std::vector<uint8_t> body = gzipMember(TEXT, flags);
+        GzipInflater inflater;
+        if (!CHECK(inflater.unpack(body.data(), body.size()) == GzipInflater::INFLATED)) {
+            fprintf(stderr, "  with header flags %02x\n", flags);
+            continue;
+        }
+        CHECK(inflater.length() == sizeof(TEXT) - 1);
+        CHECK_STR(inflater.text(), TEXT);
+
+        GzipInflater::Member member;
+        CHECK(GzipInflater::frame(body.data(), body.size(), member));
+        CHECK(member.size == sizeof(TEXT) - 1);
+        CHECK(member.stream + member.streamLength == body.data() + body.size() - 8);
+    }
+}
+
+static void testGzipFraming() {
+    // The member may come after other bytes
+    std::vector<uint8_t> body = {'\r', '\n'};
+    std::vector<uint8_t> member = gzipMember(TEXT, FNAME);
+    body.insert(body.end(), member.begin(), member.end());
+    GzipInflater inflater;
+    CHECK(inflater.unpack(body.data(), body.size()) == GzipInflater::INFLATED);
+    CHECK_STR(inflater.text(), TEXT);
+
+    inflater.release();
+    CHECK(inflater.text() == NULL);
+    CHECK(inflater.length() == 0);
+}
+
+static void testGzipTruncated() {
+    // Every cut short of the whole member fails cleanly: no text, no overrun
+    std::vector<uint8_t> body = gzipMember(TEXT, FEXTRA | FNAME | FCOMMENT | FHCRC);
+    GzipInflater inflater;
+    for (size_t length = 0; length < body.size(); length++) {
+        std::vector<uint8_t> cut(body.begin(), body.begin() + length);  // exactly length bytes, for ASan
+        GzipInflater::Result result = inflater.unpack(cut.data(), cut.size());
+        if (!CHECK(result != GzipInflater::INFLATED)) fprintf(stderr, "  cut to %zu bytes\n", length);
+        CHECK(inflater.text() == NULL);
+    }
+
+    // A header whose name runs to the end of the body
+    std::vector<uint8_t> unterminated = {0x1F, 0x8B, 8, FNAME, 0, 0, 0, 0, 0, 3};
+    unterminated.insert(unterminated.end(), 20, 'x');
+    CHECK(inflater.unpack(unterminated.data(), unterminated.size()) == GzipInflater::NOT_GZIP);
+
+    // ISIZE larger than the stream inflates to
+    body = gzipMember(TEXT, 0);
+    body[body.size() - 4]++;
+    CHECK(inflater.unpack(body.data(), body.size()) == GzipInflater::CORRUPT);
+}
+
+static void testNotGzip() {
+    GzipInflater inflater;
+    GzipInflater::Member member;
+    CHECK(inflater.unpack((const uint8_t*)TEXT, sizeof(TEXT) - 1) == GzipInflater::NOT_GZIP);
+    CHECK(!GzipInflater::frame((const uint8_t*)TEXT, sizeof(TEXT) - 1, member));
+    CHECK(inflater.unpack(NULL, 0) == GzipInflater::NOT_GZIP);
+
+    // The magic, but not deflate
+    std::vector<uint8_t> body = gzipMember(TEXT, 0);
+    body[2] = 7;
+    CHECK(inflater.unpack(body.data(), body.size()) == GzipInflater::NOT_GZIP);
+
+    // A lone magic byte at the end
+    const uint8_t tail[] = {'{', '}', 0x1F};
+    CHECK(inflater.unpack(tail, sizeof(tail)) == GzipInflater::NOT_GZIP);
+}
+
+static void testParseTime() {
+    // Every few hours over uint32's range past 1970, leap days included,
+    // against the C library
+    for (uint64_t t = 0; t <= 0xFFFFFFFFull; t += 3 * 3600 + 1234) {
+        time_t when = (time_t)t;
+        struct tm utc;
+        gmtime_r(&when, &utc);
+        char text[32];
+        strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        if (!CHECK(StopMonitorParser::parseTime(text) == (uint32_t)timegm(&utc))) {
+            fprintf(stderr, "  %s\n", text);
+            break;
+        }
+    }
+    CHECK(StopMonitorParser::parseTime("2000-02-29T23:59:59Z") == 951868799u);
+    CHECK(StopMonitorParser::parseTime("2100-03-01T00:00:00Z") == 4107542400u);
+    CHECK(StopMonitorParser::parseTime("1970-01-01T00:00:00Z") == 0);
+
+    CHECK(StopMonitorParser::parseTime("") == 0);
+    CHECK(StopMonitorParser::parseTime("2025-05-07") == 0);
+    CHECK(StopMonitorParser::parseTime("2025-13-07T16:07:30Z") == 0);
+    CHECK(StopMonitorParser::parseTime("2025-05-00T16:07:30Z") == 0);
+    CHECK(StopMonitorParser::parseTime("1969-12-31T23:59:59Z") == 0);
+    CHECK(StopMonitorParser::parseTime("2025-05-07T1x:07:30Z") == 0);
+}
+
+static void testParse() {
+    const char json[] =
+        "\xEF\xBB\xBF{\"ServiceDelivery\":{\"ResponseTimestamp\":\"2025-05-07T16:07:30Z\","
+        "\"StopMonitoringDelivery\":{\"MonitoredStopVisit\":["
+        "{\"MonitoredVehicleJourney\":{\"LineRef\":\"48\",\"MonitoredCall\":{"
+        "\"DestinationDisplay\":\"Third + 20th\",\"StopPointName\":\"24th St & Castro St\","
+        "\"ExpectedArrivalTime\":\"2025-05-07T16:10:30Z\"}}},"
+        "{\"MonitoredVehicleJourney\":{\"LineRef\":\"A very long line ref\",\"MonitoredCall\":{}}}"
+        "]}}}";
+    StopMonitorParser parser;
+    static StopCodeData stop;
+    CHECK(parser.parse(json, sizeof(json) - 1, stop) == StopMonitorParser::PARSED);
+    CHECK(parser.serverTime() == 1746634050u);
+    CHECK(stop.arrivalCount == 2);
+    CHECK_STR(stop.arrivals[0].lineRef, "48");
+    CHECK_STR(stop.arrivals[0].destinationDisplay, "Third + 20th");
+    CHECK_STR(stop.arrivals[0].stopPointName, "24th St & Castro St");
+    CHECK(stop.arrivals[0].expectedArrivalEpoch == 1746634050u + 180);
+    CHECK_STR(stop.arrivals[1].lineRef, "A very ");  // cut to the field
+    CHECK(stop.arrivals[1].expectedArrivalEpoch == 0);
+
+    CHECK(parser.parse("{\"ServiceDelivery\":", 19, stop) == StopMonitorParser::BAD_JSON);
+    CHECK(stop.arrivalCount == 0);
+}
+
+static const uint32_t NOW = 1746634050u;
+
+static void addArrival(StopCodeData& stop, const char* line, const char* destination, const char* stopPoint,
+                       uint32_t at) {
+    BusArrival& arrival = stop.arrivals[stop.arrivalCount++];
+    copyText(arrival.lineRef, sizeof(arrival.lineRef), line);
+    copyText(arrival.destinationDisplay, sizeof(arrival.destinationDisplay), destination);
+    copyText(arrival.stopPointName, sizeof(arrival.stopPointName), stopPoint);
+    arrival.expectedArrivalEpoch = at;
+}
+
+static void testBoardLayout() {
+    static StopCodeData stops[2];
+    stops[0].arrivalCount = stops[1].arrivalCount = 0;
+    addArrival(stops[0], "48", "Third + 20th", "24th & Castro", NOW + 3 * 60);
+    addArrival(stops[0], "24", "Jackson", "24th & Castro", NOW + 5 * 60 + 59);
+    addArrival(stops[0], "48", "Third + 20th", "24th & Castro", NOW + 14 * 60);
+    addArrival(stops[0], "48", "Third + 20th", "24th & Castro", NOW);  // due now: gone
+    addArrival(stops[1], "48", "Third + 20th", "24th & Castro", NOW + 27 * 60);  // merges into row 0
+    addArrival(stops[1], "48", "West Portal", "24th & Castro", NOW + 9 * 60);     // another row
+
+    ArrivalBoard board;
+    CHECK(board.layout(stops, 2, NOW, BOARD_MAX_ROWS) == 3);
+    CHECK_STR(board.row(0).lineRef, "48");
+    CHECK_STR(board.row(0).destination, "Third + 20th");
+    CHECK_STR(board.row(0).stopPoint, "24th & Castro");
+    CHECK_STR(board.row(0).times, "3, 14, 27");
+    CHECK_STR(board.row(1).lineRef, "24");
+    CHECK_STR(board.row(1).times, "5");
+    CHECK_STR(board.row(2).destination, "West Portal");
+    CHECK_STR(board.row(2).times, "9");
+
+    CHECK(board.layout(stops, 2, NOW, 2) == 2);
+
+    // Past every 24: its row goes, the others move up but keep their order
+    CHECK(board.layout(stops, 2, NOW + 6 * 60, BOARD_MAX_ROWS) == 2);
+    CHECK_STR(board.row(0).times, "8, 21");
+    CHECK_STR(board.row(1).destination, "West Portal");
+
+    // A 24 due again takes its old slot back, ahead of the later lines
+    addArrival(stops[1], "24", "Jackson", "24th & Castro", NOW + 30 * 60);
+    CHECK(board.layout(stops, 2, NOW + 6 * 60, BOARD_MAX_ROWS) == 3);
+    CHECK_STR(board.row(1).lineRef, "24");
+    CHECK_STR(board.row(1).times, "24");
+}
+
+static void testBoardLineLimit() {
+    // Lines past BOARD_MAX_LINES aren't remembered; rows stop at maxRows
+    static StopCodeData stop;
+    stop.arrivalCount = 0;
+    for (int i = 0; i < BOARD_MAX_LINES + 3; i++) {
+        char line[8];
+        snprintf(line, sizeof(line), "%d", i);
+        addArrival(stop, line, "Downtown", "Market St", NOW + 60 * (i + 1));
+    }
+    ArrivalBoard board;
+    CHECK(board.layout(&stop, 1, NOW, 99) == BOARD_MAX_ROWS);
+    CHECK_STR(board.row(BOARD_MAX_ROWS - 1).lineRef, "5");
+
+    // Once the first eight lines are past, only the two remembered ones are
+    // left: the lines that didn't fit still get no row
+    ArrivalBoard::dropPast(stop, NOW + 60 * (BOARD_MAX_LINES - 2));
+    CHECK(board.layout(&stop, 1, NOW, BOARD_MAX_ROWS) == 2);
+    CHECK_STR(board.row(1).lineRef, "9");
+}
+
+static void testDropPast() {
+    static StopCodeData stop;
+    stop.arrivalCount = 0;
+    addArrival(stop, "1", "a", "x", NOW - 60);
+    addArrival(stop, "2", "b", "x", NOW + 60);
+    addArrival(stop, "3", "c", "x", NOW);
+    addArrival(stop, "4", "d", "x", NOW + 120);
+    ArrivalBoard::dropPast(stop, NOW);
+    CHECK(stop.arrivalCount == 2);
+    CHECK_STR(stop.arrivals[0].lineRef, "2");
+    CHECK_STR(stop.arrivals[1].lineRef, "4");
+
+    ArrivalBoard::dropPast(stop, NOW + 1000);
+    CHECK(stop.arrivalCount == 0);
+}
+
+static void testAppendMinutes() {
+    char times[8] = "";
+    ArrivalBoard::appendMinutes(times, sizeof(times), 3);
+    CHECK_STR(times, "3");
+    ArrivalBoard::appendMinutes(times, sizeof(times), 14);
+    CHECK_STR(times, "3, 14");
+    ArrivalBoard::appendMinutes(times, sizeof(times), 127);
+    CHECK_STR(times, "3, 14, ");  // cut to fit, still terminated
+    ArrivalBoard::appendMinutes(times, sizeof(times), 5);
+    CHECK_STR(times, "3, 14, ");
+}
+
+int main() {
+    testGzipHeaders();
+    testGzipFraming();
+    testGzipTruncated();
+    testNotGzip();
+    testParseTime();
+    testParse();
+    testBoardLayout();
+    testBoardLineLimit();
+    testDropPast();
+    testAppendMinutes();
+    return checkFailures();
+}
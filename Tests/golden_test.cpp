@@ -0,0 +1,147 @@
+// Band mode must send the panel exactly what the plane path sends. This
+// draws a frame for every reply in a stopmonitor.py archive through
+// Bench/panel.cpp -- the boot splash first, a badged frame now and then --
+// uploads each one to the counting SPI, and writes a line per frame: the
+// bytes sent and the checksum of everything sent so far. CMakeLists.txt
+// builds it twice, against MT_EPD_BAND_MODE 0 and 1; the plane build writes
+// the lines, and the band build checks its own against them.
+//
+//   nextbus_golden_plane archive.jsonl --write=golden.txt
+//   nextbus_golden_band archive.jsonl --expect=golden.txt
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "StopMonitorParser.h"
+#include "ArrivalBoard.h"
+#include "panel.h"
+
+static const int BADGE_EVERY = 7;  // frames
+
+// The reply in an archive line, {"polled_utc": ..., "payload": {...}}, as
+// the text the parser takes
+static bool payloadOf(const std::string& line, std::string& json) {
+    static const char KEY[] = "\"payload\": ";
+    size_t start = line.find(KEY);
+    size_t end = line.rfind('}');
+    if (start == std::string::npos || end == std::string::npos || end <= start) return false;
+    start += sizeof(KEY) - 1;
+    json.assign(line, start, end - start);
+    return true;
+}
+
+static std::string uploadLine(int frame, const char* what) {
+    uint64_t sent = panelUpload();
+    char text[96];
+    snprintf(text, sizeof(text), "%d %s %llu %08x", frame, what, (unsigned long long)sent, panelSum());
+    return text;
+}
+
+int main(int argc, char** argv) {
+    const char* archive = NULL;
+    const char* writePath = NULL;
+    const char* expectPath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--write=", 8) == 0) writePath = argv[i] + 8;
+        else if (strncmp(argv[i], "--expect=", 9) == 0) expectPath = argv[i] + 9;
+        else archive = argv[i];
+    }
+    if (archive == NULL || (writePath == NULL) == (expectPath == NULL)) {
+        printf("Usage: nextbus_golden archive.jsonl --write=FILE | --expect=FILE\n");
+        return 2;
+    }
+
+    std::ifstream in(archive);
+    if (!in) {
+        fprintf(stderr, "%s: can't read\n", archive);
+        return 2;
+    }
+    FILE* out = NULL;
+    std::ifstream expected;
+    if (writePath != NULL) {
+        out = fopen(writePath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "%s: can't write\n", writePath);
+            return 2;
+        }
+    } else {
+        expected.open(expectPath);
+        if (!expected) {
+            fprintf(stderr, "%s: can't read\n", expectPath);
+            return 2;
+        }
+    }
+
+    // One line per upload, written or checked
+    int frames = 0;
+    auto note = [&](const std::string& got) {
+        frames++;
+        if (out != NULL) {
+            fprintf(out, "%s\n", got.c_str());
+            return true;
+        }
+        std::string want;
+        if (!std::getline(expected, want)) {
+            fprintf(stderr, "%s: no line for %s\n", expectPath, got.c_str());
+            return false;
+        }
+        if (got != want) {
+            fprintf(stderr, "upload differs: got %s, expected %s\n", got.c_str(), want.c_str());
+            return false;
+        }
+        return true;
+    };
+
+    panelBegin();
+    panelSplash();
+    bool same = note(uploadLine(0, "splash"));
+
+    StopMonitorParser parser;
+    static StopCodeData stop;
+    copyText(stop.stopCode, sizeof(stop.stopCode), "golden");
+    ArrivalBoard board;
+    std::string line, json;
+    for (int n = 1; same && std::getline(in, line); n++) {
+        if (!payloadOf(line, json)) continue;
+        if (parser.parse(json.data(), json.size(), stop) != StopMonitorParser::PARSED) continue;
+
+        uint8_t count = board.layout(&stop, 1, parser.serverTime(), BOARD_MAX_ROWS);
+        BoardRow rows[BOARD_MAX_ROWS];
+        for (uint8_t i = 0; i < count; i++) rows[i] = board.row(i);
+        panelRender(rows, count, frames > 1);  // the tile cache carries over, as on the device
+        if (n % BADGE_EVERY == 0) panelBadge("As of May 7, 16:02 UTC");
+
+        char what[32];
+        snprintf(what, sizeof(what), "line%d/%urows", n, count);
+        same = note(uploadLine(n, what));
+    }
+
+    // A full panel, with a destination long enough to wrap under the logo
+    // (no tile for that row)
+    if (same) {
+        BoardRow rows[BOARD_MAX_ROWS];
+        const char* const lines[BOARD_MAX_ROWS] = {"F", "14R", "38", "J", "KBUS", "N"};
+        for (uint8_t i = 0; i < BOARD_MAX_ROWS; i++) {
+            copyText(rows[i].lineRef, sizeof(rows[i].lineRef), lines[i]);
+            copyText(rows[i].destination, sizeof(rows[i].destination),
+                     i == 2 ? "Fisherman's Wharf via Market St and Embarcadero" : "Downtown");
+            copyText(rows[i].stopPoint, sizeof(rows[i].stopPoint), "Market St & Van Ness Ave");
+            copyText(rows[i].times, sizeof(rows[i].times), "1, 12, 23, 34, 45, 56");
+        }
+        panelRender(rows, BOARD_MAX_ROWS, true);
+        same = note(uploadLine(frames, "full"));
+    }
+
+    if (out != NULL) {
+        fclose(out);
+        printf("%d uploads written to %s\n", frames, writePath);
+        return frames > 1 ? 0 : 1;
+    }
+    if (same && std::getline(expected, line)) {
+        fprintf(stderr, "%s: more uploads than this build made (%d)\n", expectPath, frames);
+        same = false;
+    }
+    if (same) printf("%d uploads match %s\n", frames, expectPath);
+    return same ? 0 : 1;
+}
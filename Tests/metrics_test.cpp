@@ -0,0 +1,298 @@
+// MetricsServer against the scripted socket in Bench/host/WiFi.h: what's
+// served before and after begin(), the /metrics text and its histogram,
+// Content-Length, 404s, and that no write is larger than the socket has room
+// for or than WRITE_SLICE. /frame.png is decoded again here -- chunk CRCs,
+// zlib stream and rows -- and checked pixel for pixel against its source.
+// /profile is streamed from a stand-in for Profiler::dump().
+//
+//   ctest --test-dir build     (or build/nextbus_metrics_test)
+
+#include <cstdlib>
+#include <string>
+#include "check.h"
+#include "MetricsServer.h"
+#include "miniz.h"
+
+static LatencyHistogram latency;
+static int filler = 0;  // extra lines per scrape, to overflow the body
+
+static void collect(MetricsWriter& out) {
+    latency.write(out, "nextbus_poll_duration_seconds", "Fetch start to finish");
+    out.family("nextbus_wifi_rssi_dbm", "gauge", "Signal strength");
+    out.value("nextbus_wifi_rssi_dbm", (int32_t)-61);
+    out.family("nextbus_stop_data_age_seconds", "gauge", "Age of each stop's arrivals");
+    out.value("nextbus_stop_data_age_seconds", "stop", "13565", 12.5f);
+    for (int i = 0; i < filler; i++) out.value("nextbus_test_filler_with_a_long_name", (uint32_t)i);
+}
+
+// Sends request and polls until the server hangs up
+static std::string scrape(MetricsServer& server, const char* request) {
+    hostNet.connect(request);
+    for (int i = 0; i < 1000 && (hostNet.pending || hostNet.open); i++) server.poll();
+    CHECK(!hostNet.pending && !hostNet.open);
+    return hostNet.response;
+}
+
+static bool startsWith(const std::string& text, const char* start) {
+    return text.compare(0, strlen(start), start) == 0;
+}
+
+static bool contains(const std::string& text, const char* part) {
+    bool found = text.find(part) != std::string::npos;
+    if (!found) fprintf(stderr, "  no \"%s\" in the response\n", part);
+    return found;
+}
+
+// The response's body, checked against its Content-Length
+static std::string bodyOf(const std::string& response) {
+    size_t head = response.find("\r\n\r\n");
+    size_t length = response.find("Content-Length: ");
+    if (!CHECK(head != std::string::npos && length != std::string::npos && length < head)) return "";
+    std::string body = response.substr(head + 4);
+    CHECK(body.size() == (size_t)atol(response.c_str() + length + 16));
+    return body;
+}
+
+static void testBeforeBegin(MetricsServer& server) {
+    hostNet.connect("GET /metrics HTTP/1.1\r\n\r\n");
+    for (int i = 0; i < 100; i++) server.poll();
+    CHECK(hostNet.pending);  // never accepted
+    CHECK(hostNet.response.empty());
+    CHECK(server.scrapes() == 0);
+}
+
+static void testMetrics(MetricsServer& server) {
+    std::string response = scrape(server, "GET /metrics HTTP/1.1\r\nHost: pico\r\nAccept: */*\r\n\r\n");
+    CHECK(startsWith(response, "HTTP/1.1 200 OK\r\n"));
+    CHECK(contains(response, "Content-Type: text/plain; version=0.0.4\r\n"));
+    std::string body = bodyOf(response);
+
+    // 180 and 250 ms in the first bucket (le is inclusive), 1500 in the 2 s
+    // one, 40000 only in +Inf
+    CHECK(contains(body, "# TYPE nextbus_poll_duration_seconds histogram\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_bucket{le=\"0.25\"} 2.000\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_bucket{le=\"1.00\"} 2.000\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_bucket{le=\"2.00\"} 3.000\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_bucket{le=\"32.00\"} 3.000\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_bucket{le=\"+Inf\"} 4.000\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_sum 41.930\n"));
+    CHECK(contains(body, "nextbus_poll_duration_seconds_count 4\n"));
+    CHECK(contains(body, "nextbus_wifi_rssi_dbm -61\n"));
+    CHECK(contains(body, "nextbus_stop_data_age_seconds{stop=\"13565\"} 12.500\n"));
+    CHECK(contains(body, "nextbus_metrics_truncated 0\n"));
+    CHECK(server.scrapes() == 1);
+
+    // 300 bytes of room a call: the response goes out in several writes
+    CHECK(hostNet.writes > 1);
+    CHECK(hostNet.largestWrite <= 300);
+}
+
+static void testSlices(MetricsServer& server) {
+    // More room than WRITE_SLICE: still no more than a slice per poll()
+    hostNet.writeRoom = 4096;
+    std::string response = scrape(server, "GET /metrics\r\n");
+    CHECK(hostNet.largestWrite == MetricsServer::WRITE_SLICE);
+    bodyOf(response);
+    hostNet.writeRoom = 300;
+}
+
+static void testTruncated(MetricsServer& server) {
+    filler = 500;
+    std::string body = bodyOf(scrape(server, "GET /metrics HTTP/1.1\r\n\r\n"));
+    filler = 0;
+    CHECK(body.size() <= MetricsServer::BODY_MAX);
+    CHECK(contains(body, "nextbus_metrics_truncated 1\n"));
+
+    // Cut at a line boundary: every line is whole
+    size_t trailer = body.find("# HELP nextbus_metrics_truncated");
+    CHECK(trailer != std::string::npos && trailer > 0 && body[trailer - 1] == '\n');
+}
+
+static void testNotFound(MetricsServer& server) {
+    uint32_t scrapes = server.scrapes();
+    const char* const requests[] = {
+        "GET / HTTP/1.1\r\n\r\n",
+        "GET /metricsx HTTP/1.1\r\n\r\n",
+        "POST /metrics HTTP/1.1\r\n\r\n",
+        "GET /frame.png HTTP/1.1\r\n\r\n",  // no frame source set
+        "GET /profile HTTP/1.1\r\n\r\n",    // no profile source set
+    };
+    for (const char* request : requests) {
+        std::string response = scrape(server, request);
+        if (!CHECK(startsWith(response, "HTTP/1.1 404 Not Found"))) fprintf(stderr, "  for %s", request);
+        CHECK(bodyOf(response) == "Try /metrics\n");
+    }
+    CHECK(server.scrapes() == scrapes);
+}
+
+// A 2-bit test card, an odd width so rows end part way through a byte
+static const uint16_t CARD_WIDTH = 101, CARD_HEIGHT = 37;
+static const uint8_t CARD_PALETTE[] = {255, 255, 255, 0, 0, 0, 255, 0, 0};
+static bool cardReady = true;
+
+static uint8_t cardPixel(uint16_t x, uint16_t y) {
+    return (x * 3 + y * 7 + x * y / 5) % 3;
+}
+
+static void cardRow(void*, uint16_t y, uint8_t* row) {
+    memset(row, 0, (CARD_WIDTH + 3) / 4);
+    for (uint16_t x = 0; x < CARD_WIDTH; x++) row[x / 4] |= cardPixel(x, y) << (6 - 2 * (x % 4));
+}
+
+static bool beginCard(PngEncoder& png) {
+    return cardReady && png.begin(CARD_WIDTH, CARD_HEIGHT, 2, CARD_PALETTE, 3, cardRow, NULL);
+}
+
+static uint32_t big32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// Decodes png back to the test card: false at the first thing that's off
+static bool decodesToCard(const std::string& png) {
+    static const uint8_t SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const uint8_t* p = (const uint8_t*)png.data();
+    size_t at = sizeof(SIGNATURE);
+    if (!CHECK(png.size() > at && memcmp(p, SIGNATURE, at) == 0)) return false;
+
+    std::string idat;
+    std::string last;
+    bool header = false;
+    while (at + 12 <= png.size()) {
+        uint32_t length = big32(p + at);
+        if (!CHECK(at + 12 + length <= png.size())) return false;
+        std::string type((const char*)p + at + 4, 4);
+        const uint8_t* data = p + at + 8;
+        uint32_t crc = (uint32_t)mz_crc32(MZ_CRC32_INIT, p + at + 4, length + 4);
+        if (!CHECK(crc == big32(data + length))) return false;
+
+        if (type == "IHDR") {
+            CHECK(length == 13);
+            CHECK(big32(data) == CARD_WIDTH && big32(data + 4) == CARD_HEIGHT);
+            CHECK(data[8] == 2 && data[9] == 3);  // 2-bit, indexed
+            CHECK(data[12] == 0);                 // not interlaced
+            header = true;
+        } else if (type == "PLTE") {
+            CHECK(length == sizeof(CARD_PALETTE) && memcmp(data, CARD_PALETTE, length) == 0);
+        } else if (type == "IDAT") {
+            idat.append((const char*)data, length);
+        }
+        last = type;
+        at += 12 + length;
+    }
+    CHECK(at == png.size());
+    if (!CHECK(header && last == "IEND")) return false;
+
+    size_t rowBytes = (CARD_WIDTH + 3) / 4;
+    size_t rawLength = 0;
+    void* raw = tinfl_decompress_mem_to_heap(idat.data(), idat.size(), &rawLength, TINFL_FLAG_PARSE_ZLIB_HEADER);
+    if (!CHECK(raw != NULL && rawLength == CARD_HEIGHT * (1 + rowBytes))) {
+        free(raw);
+        return false;
+    }
+    bool same = true;
+    for (uint16_t y = 0; y < CARD_HEIGHT && same; y++) {
+        const uint8_t* row = (const uint8_t*)raw + y * (1 + rowBytes);
+        same = CHECK(row[0] == 0);  // filter: none
+        for (uint16_t x = 0; x < CARD_WIDTH && same; x++) {
+            uint8_t index = (row[1 + x / 4] >> (6 - 2 * (x % 4))) & 3;
+            if (!CHECK(index == cardPixel(x, y))) {
+                fprintf(stderr, "  pixel %u,%u\n", x, y);
+                same = false;
+            }
+        }
+    }
+    free(raw);
+    return same;
+}
+
+static void testFrame(MetricsServer& server) {
+    server.setFrameSource(beginCard);
+
+    // A slow socket: the encoder is refilled many times over
+    hostNet.writeRoom = 100;
+    std::string response = scrape(server, "GET /frame.png HTTP/1.1\r\n\r\n");
+    hostNet.writeRoom = 300;
+    size_t head = response.find("\r\n\r\n");
+    if (!CHECK(startsWith(response, "HTTP/1.1 200 OK\r\n") && head != std::string::npos)) return;
+    CHECK(contains(response.substr(0, head), "Content-Type: image/png"));
+    CHECK(response.substr(0, head).find("Content-Length") == std::string::npos);  // ends at the close
+    CHECK(decodesToCard(response.substr(head + 4)));
+    CHECK(hostNet.largestWrite <= 100);
+
+    // And again, with the compressor from the first one freed
+    response = scrape(server, "GET /frame.png\r\n");
+    CHECK(decodesToCard(response.substr(response.find("\r\n\r\n") + 4)));
+
+    cardReady = false;
+    response = scrape(server, "GET /frame.png HTTP/1.1\r\n\r\n");
+    CHECK(startsWith(response, "HTTP/1.1 503 Service Unavailable\r\n"));
+    bodyOf(response);
+    cardReady = true;
+}
+
+// Three slices, two full and a short one, then the end; each restart
+// begins again
+static int profileSlice = 0;
+static int profileStarts = 0;
+
+static size_t profileDump(uint8_t* out, size_t max, bool start) {
+    if (start) {
+        profileStarts++;
+        profileSlice = 0;
+    }
+    if (profileSlice == 3) return 0;
+    size_t n = profileSlice == 2 ? 10 : max;
+    memset(out, 'a' + profileSlice, n);
+    profileSlice++;
+    return n;
+}
+
+static void testProfile(MetricsServer& server) {
+    server.setProfileSource(profileDump);
+    std::string response = scrape(server, "GET /profile HTTP/1.1\r\n\r\n");
+    size_t head = response.find("\r\n\r\n");
+    if (!CHECK(startsWith(response, "HTTP/1.1 200 OK\r\n") && head != std::string::npos)) return;
+    CHECK(contains(response.substr(0, head), "Content-Type: application/octet-stream"));
+    CHECK(response.substr(0, head).find("Content-Length") == std::string::npos);  // ends at the close
+
+    std::string body = response.substr(head + 4);
+    size_t full = MetricsServer::BODY_MAX;
+    CHECK(profileStarts == 1);
+    CHECK(body.size() == 2 * full + 10);
+    CHECK(body.find_first_not_of('a') == full);
+    CHECK(body.find_first_not_of('b', full) == 2 * full);
+    CHECK(body.find_first_not_of('c', 2 * full) == std::string::npos);
+    CHECK(hostNet.largestWrite <= 300);
+
+    // A client that hangs up part way: the dump stops, the next one restarts
+    hostNet.connect("GET /profile HTTP/1.1\r\n\r\n");
+    for (int i = 0; i < 10; i++) server.poll();
+    CHECK(hostNet.open);
+    hostNet.open = false;
+    for (int i = 0; i < 10; i++) server.poll();
+    CHECK(profileStarts == 2 && profileSlice < 3);
+    body = scrape(server, "GET /profile\r\n");
+    CHECK(profileStarts == 3);
+    CHECK(body.size() == head + 4 + 2 * full + 10);
+
+    // /metrics is unaffected
+    CHECK(contains(bodyOf(scrape(server, "GET /metrics\r\n")), "nextbus_metrics_truncated 0\n"));
+}
+
+int main() {
+    latency.observe(180);
+    latency.observe(250);
+    latency.observe(1500);
+    latency.observe(40000);
+
+    static MetricsServer server(9100, collect);
+    testBeforeBegin(server);
+    server.begin();
+    testMetrics(server);
+    testSlices(server);
+    testTruncated(server);
+    testNotFound(server);
+    testFrame(server);
+    testProfile(server);
+    return checkFailures();
+}